@@ -8,11 +8,20 @@ in vec3 vBlockPos;
 out vec4 FragColor;
 
 uniform sampler2DArray uTexture;
-uniform float uGlobalLight;
+layout(std140) uniform FrameConstants {
+    mat4 uViewProjection;
+    mat4 uInvViewProjection;
+    mat4 uFarViewProjection;
+    vec4 uCameraPosition;
+    vec4 uSkyColor;
+    vec4 uSunDirection;
+    float uGlobalLight;
+    float uTime;
+};
 
 void main() {
     // 使用纹理数组，直接通过索引访问对应层
     vec4 texColor = texture(uTexture, vec3(vTexCoord, vTexIndex));
     vec3 finalColor = texColor.rgb * vLighting * uGlobalLight;
-    FragColor = vec4(finalColor, 1.0);
+    FragColor = vec4(finalColor, texColor.a);
 }
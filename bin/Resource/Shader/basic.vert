@@ -11,7 +11,16 @@ out float vTexIndex;
 out float vLighting;
 out vec3 vBlockPos;
 
-uniform mat4 uViewProjection;
+layout(std140) uniform FrameConstants {
+    mat4 uViewProjection;
+    mat4 uInvViewProjection;
+    mat4 uFarViewProjection;
+    vec4 uCameraPosition;
+    vec4 uSkyColor;
+    vec4 uSunDirection;
+    float uGlobalLight;
+    float uTime;
+};
 
 void main() {
     vTexCoord = aTexCoord;
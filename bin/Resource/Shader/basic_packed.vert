@@ -0,0 +1,55 @@
+#version 430 core
+
+// Vertex pulling: one packed 32-bit record per quad, expanded to six vertices from gl_VertexID.
+// Record bits: x 0-5, y 6-13, z 14-19 (relative to uRegionOrigin), face 20-22, texture layer 23-30, flip V 31
+layout(std430, binding = 0) readonly buffer FaceBuffer {
+    uint faces[];
+};
+
+layout(location = 0) uniform ivec3 uRegionOrigin;
+layout(std140) uniform FrameConstants {
+    mat4 uViewProjection;
+    mat4 uInvViewProjection;
+    mat4 uFarViewProjection;
+    vec4 uCameraPosition;
+    vec4 uSkyColor;
+    vec4 uSunDirection;
+    float uGlobalLight;
+    float uTime;
+};
+
+out vec2 vTexCoord;
+out float vTexIndex;
+out float vLighting;
+out vec3 vBlockPos;
+
+// Same corner order as ChunkMeshBuilder: +Z, -Z, +X, -X, +Y, -Y
+const vec3 FACE_VERTICES[24] = vec3[24](
+    vec3(0, 0, 1), vec3(1, 0, 1), vec3(1, 1, 1), vec3(0, 1, 1),
+    vec3(1, 0, 0), vec3(0, 0, 0), vec3(0, 1, 0), vec3(1, 1, 0),
+    vec3(1, 0, 1), vec3(1, 0, 0), vec3(1, 1, 0), vec3(1, 1, 1),
+    vec3(0, 0, 0), vec3(0, 0, 1), vec3(0, 1, 1), vec3(0, 1, 0),
+    vec3(0, 1, 1), vec3(1, 1, 1), vec3(1, 1, 0), vec3(0, 1, 0),
+    vec3(0, 0, 0), vec3(1, 0, 0), vec3(1, 0, 1), vec3(0, 0, 1)
+);
+
+const int QUAD_CORNERS[6] = int[6](0, 1, 2, 0, 2, 3);
+const float FACE_LIGHTING[6] = float[6](1.0, 1.0, 0.8, 0.8, 1.0, 0.5);
+
+void main() {
+    uint record = faces[gl_VertexID / 6];
+    int corner = QUAD_CORNERS[gl_VertexID % 6];
+    int face = int((record >> 20) & 7u);
+
+    ivec3 local = ivec3(int(record & 63u), int((record >> 6) & 255u), int((record >> 14) & 63u));
+    vec3 blockPos = vec3(uRegionOrigin + local);
+
+    vTexCoord = vec2((corner == 1 || corner == 2) ? 1.0 : 0.0, (corner > 1) ? 1.0 : 0.0);
+    if ((record >> 31) != 0u) {
+        vTexCoord.y = 1.0 - vTexCoord.y;
+    }
+    vTexIndex = float((record >> 23) & 255u);
+    vLighting = FACE_LIGHTING[face];
+    vBlockPos = blockPos;
+    gl_Position = uViewProjection * vec4(blockPos + FACE_VERTICES[face * 4 + corner], 1.0);
+}
@@ -0,0 +1,33 @@
+#version 330 core
+
+in vec3 vWorldPos;
+in vec3 vColor;
+
+out vec4 FragColor;
+
+uniform vec2 uVoxelMin;    // XZ area drawn by voxel chunks
+uniform vec2 uVoxelMax;
+uniform vec2 uFogRange;    // Start and end of the haze, in blocks
+
+layout(std140) uniform FrameConstants {
+    mat4 uViewProjection;
+    mat4 uInvViewProjection;
+    mat4 uFarViewProjection;
+    vec4 uCameraPosition;
+    vec4 uSkyColor;
+    vec4 uSunDirection;
+    float uGlobalLight;
+    float uTime;
+};
+
+void main() {
+    // Chunks cover this part; tiles do not line up with chunk borders
+    if (all(greaterThan(vWorldPos.xz, uVoxelMin)) && all(lessThan(vWorldPos.xz, uVoxelMax))) {
+        discard;
+    }
+
+    // Fade into the sky so the horizon has no hard edge
+    float distance = length(vWorldPos.xz - uCameraPosition.xz);
+    float fog = smoothstep(uFogRange.x, uFogRange.y, distance);
+    FragColor = vec4(mix(vColor * uGlobalLight, uSkyColor.rgb, fog), 1.0);
+}
@@ -0,0 +1,24 @@
+#version 330 core
+
+layout(location = 0) in vec3 aPosition;
+layout(location = 1) in vec4 aColor;
+
+out vec3 vWorldPos;
+out vec3 vColor;
+
+layout(std140) uniform FrameConstants {
+    mat4 uViewProjection;
+    mat4 uInvViewProjection;
+    mat4 uFarViewProjection;
+    vec4 uCameraPosition;
+    vec4 uSkyColor;
+    vec4 uSunDirection;
+    float uGlobalLight;
+    float uTime;
+};
+
+void main() {
+    vWorldPos = aPosition;
+    vColor = aColor.rgb;
+    gl_Position = uFarViewProjection * vec4(aPosition, 1.0);
+}
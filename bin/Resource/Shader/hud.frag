@@ -0,0 +1,13 @@
+#version 330 core
+
+in vec2 vTexCoord;
+in vec4 vColor;
+
+out vec4 FragColor;
+
+// Glyph atlas; solid quads sample its white texel
+uniform sampler2D uAtlas;
+
+void main() {
+    FragColor = vColor * texture(uAtlas, vTexCoord);
+}
@@ -0,0 +1,17 @@
+#version 330 core
+
+layout(location = 0) in vec2 aPosition;  // Pixels, origin top-left
+layout(location = 1) in vec2 aTexCoord;
+layout(location = 2) in vec4 aColor;
+
+out vec2 vTexCoord;
+out vec4 vColor;
+
+uniform vec2 uScreenSize;
+
+void main() {
+    vec2 ndc = aPosition / uScreenSize * 2.0 - 1.0;
+    gl_Position = vec4(ndc.x, -ndc.y, 0.0, 1.0);
+    vTexCoord = aTexCoord;
+    vColor = aColor;
+}
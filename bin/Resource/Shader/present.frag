@@ -0,0 +1,11 @@
+#version 330 core
+
+in vec2 vTexCoord;
+
+out vec4 FragColor;
+
+uniform sampler2D uFrame;
+
+void main() {
+    FragColor = vec4(texture(uFrame, vTexCoord).rgb, 1.0);
+}
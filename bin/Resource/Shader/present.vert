@@ -0,0 +1,10 @@
+#version 330 core
+
+// Fullscreen triangle generated from gl_VertexID, no vertex buffer needed
+out vec2 vTexCoord;
+
+void main() {
+    vec2 position = vec2((gl_VertexID == 1) ? 3.0 : -1.0, (gl_VertexID == 2) ? 3.0 : -1.0);
+    vTexCoord = position * 0.5 + 0.5;
+    gl_Position = vec4(position, 0.0, 1.0);
+}
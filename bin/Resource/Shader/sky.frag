@@ -0,0 +1,44 @@
+#version 330 core
+
+in vec3 vRay;
+
+out vec4 FragColor;
+
+layout(std140) uniform FrameConstants {
+    mat4 uViewProjection;
+    mat4 uInvViewProjection;
+    mat4 uFarViewProjection;
+    vec4 uCameraPosition;
+    vec4 uSkyColor;
+    vec4 uSunDirection;
+    float uGlobalLight;
+    float uTime;
+};
+
+uniform sampler2D uSun;
+
+// Half-width of the sun sprite on the plane one unit along the sun direction (~7 degrees across)
+const float SUN_HALF_SIZE = 0.061;
+
+void main() {
+    vec3 ray = normalize(vRay);
+
+    // Slightly brighter towards the horizon
+    float horizon = pow(1.0 - max(ray.y, 0.0), 3.0);
+    vec3 color = uSkyColor.rgb * mix(1.0, 1.2, horizon);
+
+    vec3 sunDirection = uSunDirection.xyz;
+    float facing = dot(ray, sunDirection);
+    if (facing > 0.0) {
+        vec3 right = normalize(cross(sunDirection, vec3(0.0, 1.0, 0.0)));
+        vec3 up = cross(right, sunDirection);
+        vec3 onPlane = ray / facing;
+        vec2 uv = vec2(dot(onPlane, right), dot(onPlane, up)) / (2.0 * SUN_HALF_SIZE) + 0.5;
+        if (all(greaterThanEqual(uv, vec2(0.0))) && all(lessThanEqual(uv, vec2(1.0)))) {
+            vec4 sun = texture(uSun, uv);
+            color = mix(color, sun.rgb, sun.a);
+        }
+    }
+
+    FragColor = vec4(color, 1.0);
+}
@@ -0,0 +1,23 @@
+#version 330 core
+
+// Fullscreen triangle at the far plane; the view ray is rebuilt from the inverse view-projection
+out vec3 vRay;
+
+layout(std140) uniform FrameConstants {
+    mat4 uViewProjection;
+    mat4 uInvViewProjection;
+    mat4 uFarViewProjection;
+    vec4 uCameraPosition;
+    vec4 uSkyColor;
+    vec4 uSunDirection;
+    float uGlobalLight;
+    float uTime;
+};
+
+void main() {
+    vec2 position = vec2((gl_VertexID == 1) ? 3.0 : -1.0, (gl_VertexID == 2) ? 3.0 : -1.0);
+    vec4 nearPoint = uInvViewProjection * vec4(position, -1.0, 1.0);
+    vec4 farPoint = uInvViewProjection * vec4(position, 1.0, 1.0);
+    vRay = farPoint.xyz / farPoint.w - nearPoint.xyz / nearPoint.w;
+    gl_Position = vec4(position, 1.0, 1.0);
+}
@@ -0,0 +1,111 @@
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace Minecraft {
+
+void FramePacer::Configure(bool vsync, float refreshHz, int targetFps) {
+    m_TargetFps = std::max(targetFps, 0);
+    if (m_TargetFps > 0) {
+        m_FrameInterval = 1.0f / static_cast<float>(m_TargetFps);
+        // A cap above the refresh rate is meaningless with vsync
+        if (vsync && refreshHz > 0.0f) {
+            m_FrameInterval = std::max(m_FrameInterval, 1.0f / refreshHz);
+        }
+    } else if (vsync && refreshHz > 0.0f) {
+        m_FrameInterval = 1.0f / refreshHz;
+    } else {
+        m_FrameInterval = 0.0f;
+    }
+    m_HasFrame = false;
+}
+
+void FramePacer::BeginFrame() {
+    const Clock::time_point now = Clock::now();
+    if (m_HasFrame) {
+        m_Intervals[m_IntervalHead] = std::chrono::duration<float>(now - m_FrameStart).count();
+        m_IntervalHead = (m_IntervalHead + 1) % HISTORY_SIZE;
+        m_IntervalCount = std::min(m_IntervalCount + 1, HISTORY_SIZE);
+    }
+
+    if (m_TargetFps > 0) {
+        const auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(m_FrameInterval));
+        // Keep a steady cadence, but don't try to make up for frames that ran long
+        m_NextFrameStart = m_HasFrame ? m_NextFrameStart + interval : now + interval;
+        if (m_NextFrameStart < now) {
+            m_NextFrameStart = now + interval;
+        }
+    }
+
+    m_FrameStart = now;
+    m_HasFrame = true;
+}
+
+FramePacer::Clock::time_point FramePacer::GetWorkDeadline() const {
+    const float interval = m_FrameInterval > 0.0f ? m_FrameInterval : NOMINAL_INTERVAL;
+    return m_FrameStart + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(interval * WORK_FRACTION));
+}
+
+int FramePacer::GetMillisecondsUntilNextFrame() const {
+    if (m_TargetFps <= 0) {
+        // Vsync: the swap already waited. Uncapped: go again right away.
+        return 0;
+    }
+
+    const auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(m_NextFrameStart - Clock::now());
+    return std::max(static_cast<int>(wait.count()), 0);
+}
+
+void FramePacer::WaitForFrameStart() const {
+    if (m_TargetFps <= 0 || !m_HasFrame) {
+        return;
+    }
+
+    // Further out means the timer did not come from GetMillisecondsUntilNextFrame
+    const Clock::time_point now = Clock::now();
+    if (m_NextFrameStart <= now || m_NextFrameStart - now > SPIN_LIMIT) {
+        return;
+    }
+    while (Clock::now() < m_NextFrameStart) {
+        std::this_thread::yield();
+    }
+}
+
+float FramePacer::GetLastFrameMs() const {
+    if (m_IntervalCount == 0) {
+        return 0.0f;
+    }
+    return m_Intervals[(m_IntervalHead + HISTORY_SIZE - 1) % HISTORY_SIZE] * 1000.0f;
+}
+
+FramePacer::Stats FramePacer::GetStats() const {
+    Stats stats;
+    stats.samples = m_IntervalCount;
+    if (m_IntervalCount == 0) {
+        return stats;
+    }
+
+    float sum = 0.0f;
+    float worst = 0.0f;
+    for (int i = 0; i < m_IntervalCount; ++i) {
+        sum += m_Intervals[i];
+        worst = std::max(worst, m_Intervals[i]);
+    }
+    const float mean = sum / static_cast<float>(m_IntervalCount);
+
+    float variance = 0.0f;
+    for (int i = 0; i < m_IntervalCount; ++i) {
+        const float d = m_Intervals[i] - mean;
+        variance += d * d;
+    }
+    variance /= static_cast<float>(m_IntervalCount);
+
+    stats.averageMs = mean * 1000.0f;
+    stats.jitterMs = std::sqrt(variance) * 1000.0f;
+    stats.worstMs = worst * 1000.0f;
+    return stats;
+}
+
+} // namespace Minecraft
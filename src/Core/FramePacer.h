@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+
+namespace Minecraft {
+
+// Decides when the next frame starts and how long per-frame work may run.
+// Three modes: follow vsync (the swap blocks, frames start right after it),
+// cap to a target rate (frames start on a fixed cadence), or uncapped.
+// Also keeps a short history of frame intervals to report pacing jitter.
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int HISTORY_SIZE = 120;
+    static constexpr float WORK_FRACTION = 0.5f;      // Share of the frame interval for streaming work
+    static constexpr float NOMINAL_INTERVAL = 1.0f / 60.0f;  // Budget basis when uncapped
+    static constexpr auto SPIN_LIMIT = std::chrono::milliseconds(2);  // Longest wait WaitForFrameStart yields through
+
+    struct Stats {
+        float averageMs = 0.0f;
+        float jitterMs = 0.0f;  // Standard deviation of the frame interval
+        float worstMs = 0.0f;
+        int samples = 0;
+    };
+
+    // vsync: the swap chain throttles to refreshHz; targetFps 0 means no cap
+    void Configure(bool vsync, float refreshHz, int targetFps);
+
+    // Mark the start of a frame; records the interval since the previous one
+    void BeginFrame();
+
+    // Point by which optional work of the current frame should be done
+    Clock::time_point GetWorkDeadline() const;
+
+    // Whole milliseconds to wait after a swap before starting the next frame, rounded
+    // down so a millisecond timer never fires late; WaitForFrameStart covers the rest
+    int GetMillisecondsUntilNextFrame() const;
+
+    // Yield until the exact frame start when it is less than SPIN_LIMIT away
+    void WaitForFrameStart() const;
+
+    // Scheduled start of the next frame when capped
+    Clock::time_point GetNextFrameStart() const { return m_NextFrameStart; }
+
+    // Seconds between frames, 0 when uncapped
+    float GetFrameInterval() const { return m_FrameInterval; }
+    bool IsCapped() const { return m_TargetFps > 0; }
+
+    Stats GetStats() const;
+    // Interval between the last two frame starts
+    float GetLastFrameMs() const;
+
+private:
+    float m_FrameInterval = 0.0f;
+    int m_TargetFps = 0;
+    Clock::time_point m_FrameStart;
+    Clock::time_point m_NextFrameStart;
+    bool m_HasFrame = false;
+
+    std::array<float, HISTORY_SIZE> m_Intervals{};  // Seconds, ring buffer
+    int m_IntervalCount = 0;
+    int m_IntervalHead = 0;
+};
+
+} // namespace Minecraft
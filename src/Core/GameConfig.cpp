@@ -78,4 +78,40 @@ void GameConfig::SetMobSpeedMultiplier(float value) {
     m_MobGlobal.speedMultiplier = std::clamp(value, 0.1f, 10.0f);
 }
 
+void GameConfig::SetVSync(bool enabled) {
+    m_Display.vsync = enabled;
+}
+
+void GameConfig::SetTargetFps(int fps) {
+    m_Display.targetFps = fps <= 0 ? 0 : std::clamp(fps, 10, 1000);
+}
+
+void GameConfig::SetDynamicResolution(bool enabled) {
+    m_Display.dynamicResolution = enabled;
+}
+
+void GameConfig::SetResolutionScaleBounds(float minScale, float maxScale) {
+    m_Display.minResolutionScale = std::clamp(std::min(minScale, maxScale), 0.25f, 1.0f);
+    m_Display.maxResolutionScale = std::clamp(std::max(minScale, maxScale), m_Display.minResolutionScale, 2.0f);
+}
+
+void GameConfig::SetRenderDistanceBounds(int minDistance, int maxDistance) {
+    m_Streaming.minRenderDistance = std::clamp(std::min(minDistance, maxDistance), 1, 32);
+    m_Streaming.maxRenderDistance = std::clamp(std::max(minDistance, maxDistance), m_Streaming.minRenderDistance, 32);
+    m_Streaming.initialRenderDistance = std::clamp(m_Streaming.initialRenderDistance,
+                                                   m_Streaming.minRenderDistance, m_Streaming.maxRenderDistance);
+}
+
+void GameConfig::SetChunkMemoryBudgetMB(std::size_t megabytes) {
+    m_Streaming.chunkMemoryBudgetMB = std::max<std::size_t>(megabytes, 64);
+}
+
+void GameConfig::SetGenerationWorkers(int workers) {
+    m_Streaming.generationWorkers = std::clamp(workers, 0, 64);
+}
+
+void GameConfig::SetCaves(bool enabled) {
+    m_Streaming.caves = enabled;
+}
+
 } // namespace Minecraft
@@ -48,6 +48,27 @@ struct MobGlobalConfig {
     float speedMultiplier = 1.0f;       // Runtime-adjustable
 };
 
+struct DisplayConfig {
+    bool vsync = true;                  // Swap interval 1; fixed at startup
+    int targetFps = 0;                  // Frame rate cap, 0 = none (vsync or uncapped)
+    bool dynamicResolution = true;      // Scale the world render resolution to GPU frame time
+    float minResolutionScale = 0.5f;
+    float maxResolutionScale = 1.0f;
+};
+
+struct StreamingConfig {
+    int initialRenderDistance = 4;      // Chunks; the governor moves it within the bounds below
+    int minRenderDistance = 2;
+    int maxRenderDistance = 12;
+    std::size_t chunkMemoryBudgetMB = 512;
+    int minGenerationBudget = 1;
+    int maxGenerationBudget = 16;
+    int minMeshingBudget = 1;
+    int maxMeshingBudget = 8;
+    int generationWorkers = 0;          // Chunk generation threads, 0 = one per hardware thread
+    bool caves = true;                  // Carve 3D density caves into the terrain
+};
+
 class GameConfig {
 public:
     static GameConfig& Instance();
@@ -56,6 +77,8 @@ public:
     const MobConfig& GetMobConfig(MobType type) const;
     MobConfig GetEffectiveMobConfig(MobType type) const;
     const MobGlobalConfig& GetMobGlobalConfig() const { return m_MobGlobal; }
+    const DisplayConfig& GetDisplayConfig() const { return m_Display; }
+    const StreamingConfig& GetStreamingConfig() const { return m_Streaming; }
 
     // Runtime settings hooks (UI/options can call these).
     void SetPlayerWalkSpeed(float value);
@@ -69,12 +92,24 @@ public:
     void SetMobDamageMultiplier(float value);
     void SetMobSpeedMultiplier(float value);
 
+    void SetVSync(bool enabled);
+    void SetTargetFps(int fps);
+    void SetDynamicResolution(bool enabled);
+    void SetResolutionScaleBounds(float minScale, float maxScale);
+
+    void SetRenderDistanceBounds(int minDistance, int maxDistance);
+    void SetChunkMemoryBudgetMB(std::size_t megabytes);
+    void SetGenerationWorkers(int workers);
+    void SetCaves(bool enabled);
+
 private:
     GameConfig();
     static std::size_t ToIndex(MobType type);
 
     PlayerConfig m_Player;
     MobGlobalConfig m_MobGlobal;
+    DisplayConfig m_Display;
+    StreamingConfig m_Streaming;
     std::array<MobConfig, static_cast<std::size_t>(MobType::Count)> m_Mobs;
 };
 
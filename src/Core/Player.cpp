@@ -2,13 +2,14 @@
 
 #include "GameConfig.h"
 #include "../Physics/CollisionSystem.h"
-#include "../Utils/Logger.h"
+#include "../utils/Logger.h"
 #include "../World/World.h"
 
 namespace Minecraft {
 
 Player::Player()
     : m_Position(0.0f, 80.0f, 0.0f)
+    , m_PreviousPosition(m_Position)
     , m_Velocity(0.0f)
     , m_OnGround(false)
     , m_Flying(false) {
@@ -29,6 +30,7 @@ AABB Player::GetAABB() const {
 
 void Player::Update(float deltaTime, World* world) {
     const PlayerConfig& cfg = GameConfig::Instance().GetPlayerConfig();
+    m_PreviousPosition = m_Position;
 
     if (!m_Flying) {
         m_Velocity.y += cfg.gravity * deltaTime;
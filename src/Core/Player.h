@@ -12,6 +12,7 @@ public:
     Player();
     ~Player() = default;
 
+    // Advance one simulation tick; call with a fixed deltaTime
     void Update(float deltaTime, World* world);
     void Move(const glm::vec3& direction, float deltaTime, World* world, bool sprinting = false);
     void Jump();
@@ -19,12 +20,14 @@ public:
     void ToggleFly() { m_Flying = !m_Flying; }
 
     glm::vec3 GetPosition() const { return m_Position; }
+    // Position between the previous and the current tick, alpha in [0,1]
+    glm::vec3 GetInterpolatedPosition(float alpha) const { return glm::mix(m_PreviousPosition, m_Position, alpha); }
     glm::vec3 GetVelocity() const { return m_Velocity; }
     bool IsOnGround() const { return m_OnGround; }
     bool IsFlying() const { return m_Flying; }
     AABB GetAABB() const;
 
-    void SetPosition(const glm::vec3& pos) { m_Position = pos; }
+    void SetPosition(const glm::vec3& pos) { m_Position = m_PreviousPosition = pos; }
     void SetVelocity(const glm::vec3& vel) { m_Velocity = vel; }
 
 private:
@@ -32,6 +35,7 @@ private:
     void CheckGroundCollision(World* world);
 
     glm::vec3 m_Position;
+    glm::vec3 m_PreviousPosition;  // Position at the start of the last tick
     glm::vec3 m_Velocity;
 
     bool m_OnGround;
@@ -9,10 +9,14 @@ float Time::s_TotalTime = 0.0f;
 int Time::s_FPS = 0;
 int Time::s_FrameCount = 0;
 float Time::s_FPSTimer = 0.0f;
+float Time::s_Accumulator = 0.0f;
+unsigned long long Time::s_TickCount = 0;
+unsigned long long Time::s_DroppedTicks = 0;
 
 void Time::Init() {
     s_StartTime = std::chrono::high_resolution_clock::now();
     s_LastFrame = s_StartTime;
+    s_Accumulator = 0.0f;
 }
 
 void Time::Update() {
@@ -32,6 +36,21 @@ void Time::Update() {
         s_FrameCount = 0;
         s_FPSTimer = 0.0f;
     }
+
+    s_Accumulator += s_DeltaTime;
+}
+
+int Time::ConsumeFixedTicks() {
+    int ticks = static_cast<int>(s_Accumulator / FIXED_DELTA_TIME);
+    s_Accumulator -= ticks * FIXED_DELTA_TIME;
+
+    if (ticks > MAX_TICKS_PER_UPDATE) {
+        s_DroppedTicks += ticks - MAX_TICKS_PER_UPDATE;
+        ticks = MAX_TICKS_PER_UPDATE;
+    }
+
+    s_TickCount += ticks;
+    return ticks;
 }
 
 } // namespace Minecraft
@@ -6,13 +6,25 @@ namespace Minecraft {
 
 class Time {
 public:
+    static constexpr float FIXED_DELTA_TIME = 1.0f / 60.0f;  // Simulation tick length
+    static constexpr int MAX_TICKS_PER_UPDATE = 5;          // Catch-up limit before time is dropped
+
     static void Init();
     static void Update();
-    
+
+    // Number of fixed ticks owed since the last call. Backlog beyond
+    // MAX_TICKS_PER_UPDATE is discarded so a stall slows the game instead of spiralling.
+    static int ConsumeFixedTicks();
+
     static float DeltaTime() { return s_DeltaTime; }
     static float TotalTime() { return s_TotalTime; }
     static int FPS() { return s_FPS; }
 
+    // Fraction of a tick elapsed since the last simulated one, for render interpolation
+    static float InterpolationAlpha() { return s_Accumulator / FIXED_DELTA_TIME; }
+    static unsigned long long TickCount() { return s_TickCount; }
+    static unsigned long long DroppedTicks() { return s_DroppedTicks; }
+
 private:
     static std::chrono::high_resolution_clock::time_point s_LastFrame;
     static std::chrono::high_resolution_clock::time_point s_StartTime;
@@ -21,6 +33,9 @@ private:
     static int s_FPS;
     static int s_FrameCount;
     static float s_FPSTimer;
+    static float s_Accumulator;
+    static unsigned long long s_TickCount;
+    static unsigned long long s_DroppedTicks;
 };
 
 } // namespace Minecraft
@@ -16,7 +16,7 @@ bool CollisionSystem::CheckCollision(const AABB& aabb, World* world) {
     for (int x = minX; x <= maxX; ++x) {
         for (int y = minY; y <= maxY; ++y) {
             for (int z = minZ; z <= maxZ; ++z) {
-                BlockType block = world->GetBlock(x, y, z);
+                BlockType block = world->GetCollisionBlock(x, y, z);
                 
                 // 跳过空气和非固体方块
                 if (block == BlockType::Air || !Block::IsSolid(block)) {
@@ -50,7 +50,7 @@ std::vector<AABB> CollisionSystem::GetNearbyBlockAABBs(const AABB& aabb, World*
     for (int x = minX; x <= maxX; ++x) {
         for (int y = minY; y <= maxY; ++y) {
             for (int z = minZ; z <= maxZ; ++z) {
-                BlockType block = world->GetBlock(x, y, z);
+                BlockType block = world->GetCollisionBlock(x, y, z);
                 
                 if (block != BlockType::Air && Block::IsSolid(block)) {
                     blocks.push_back(GetBlockAABB(x, y, z));
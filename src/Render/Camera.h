@@ -26,6 +26,9 @@ public:
     glm::mat4 GetProjectionMatrix() const { return m_ProjectionMatrix; }
     glm::mat4 GetViewProjectionMatrix() const { return m_ProjectionMatrix * m_ViewMatrix; }
     
+    float GetFOV() const { return m_FOV; }
+    float GetAspectRatio() const { return m_AspectRatio; }
+
     void SetAspectRatio(float aspectRatio);
     void SetFOV(float fov);
 
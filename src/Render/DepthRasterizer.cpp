@@ -0,0 +1,194 @@
+#include "DepthRasterizer.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MINECRAFT_DEPTH_SSE2 1
+#include <emmintrin.h>
+#else
+#define MINECRAFT_DEPTH_SSE2 0
+#endif
+
+namespace Minecraft {
+
+namespace {
+
+// Box faces as quads of corner indices (bit0 = x, bit1 = y, bit2 = z), counter-clockwise seen from outside.
+constexpr int BOX_FACES[6][4] = {
+    {0, 4, 6, 2},  // -X
+    {1, 3, 7, 5},  // +X
+    {0, 1, 5, 4},  // -Y
+    {2, 6, 7, 3},  // +Y
+    {0, 2, 3, 1},  // -Z
+    {4, 5, 7, 6}   // +Z
+};
+
+static_assert(DepthRasterizer::WIDTH % 4 == 0, "Depth buffer rows must be a multiple of the SIMD width");
+
+} // namespace
+
+DepthRasterizer::DepthRasterizer()
+    : m_Depth(WIDTH * HEIGHT, FLT_MAX) {
+}
+
+void DepthRasterizer::Clear() {
+    std::fill(m_Depth.begin(), m_Depth.end(), FLT_MAX);
+}
+
+bool DepthRasterizer::ProjectBox(const AABB& box, ScreenVertex out[8]) const {
+    for (int i = 0; i < 8; ++i) {
+        const glm::vec4 corner(
+            (i & 1) ? box.max.x : box.min.x,
+            (i & 2) ? box.max.y : box.min.y,
+            (i & 4) ? box.max.z : box.min.z,
+            1.0f);
+        const glm::vec4 clip = m_ViewProjection * corner;
+        if (clip.w < NEAR_W) {
+            return false;
+        }
+
+        const float invW = 1.0f / clip.w;
+        out[i].x = (clip.x * invW * 0.5f + 0.5f) * static_cast<float>(WIDTH);
+        out[i].y = (clip.y * invW * 0.5f + 0.5f) * static_cast<float>(HEIGHT);
+        out[i].w = clip.w;
+    }
+    return true;
+}
+
+bool DepthRasterizer::RasterizeBox(const AABB& box) {
+    ScreenVertex corners[8];
+    if (!ProjectBox(box, corners)) {
+        return false;
+    }
+
+    for (const auto& face : BOX_FACES) {
+        RasterizeTriangle(corners[face[0]], corners[face[1]], corners[face[2]]);
+        RasterizeTriangle(corners[face[0]], corners[face[2]], corners[face[3]]);
+    }
+    return true;
+}
+
+void DepthRasterizer::RasterizeTriangle(const ScreenVertex& v0, const ScreenVertex& v1, const ScreenVertex& v2) {
+    const float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+    if (area <= 0.0f) {
+        return;  // Back-facing or degenerate
+    }
+
+    const int minX = std::max(0, static_cast<int>(std::floor(std::min({v0.x, v1.x, v2.x}))));
+    const int maxX = std::min(WIDTH - 1, static_cast<int>(std::ceil(std::max({v0.x, v1.x, v2.x}))));
+    const int minY = std::max(0, static_cast<int>(std::floor(std::min({v0.y, v1.y, v2.y}))));
+    const int maxY = std::min(HEIGHT - 1, static_cast<int>(std::ceil(std::max({v0.y, v1.y, v2.y}))));
+    if (minX > maxX || minY > maxY) {
+        return;
+    }
+
+    const float depth = std::max({v0.w, v1.w, v2.w});
+
+    // Edge function E(p) = stepY * (p.y - a.y) + stepX * (p.x - a.x), non-negative inside.
+    const ScreenVertex* edgeStart[3] = {&v0, &v1, &v2};
+    const ScreenVertex* edgeEnd[3] = {&v1, &v2, &v0};
+    float stepX[3];
+    float stepY[3];
+    for (int i = 0; i < 3; ++i) {
+        stepX[i] = -(edgeEnd[i]->y - edgeStart[i]->y);
+        stepY[i] = edgeEnd[i]->x - edgeStart[i]->x;
+    }
+
+    const int startX = minX & ~3;
+    const float startPx = static_cast<float>(startX) + 0.5f;
+
+    for (int y = minY; y <= maxY; ++y) {
+        const float py = static_cast<float>(y) + 0.5f;
+        float rowEdge[3];
+        for (int i = 0; i < 3; ++i) {
+            rowEdge[i] = stepY[i] * (py - edgeStart[i]->y) + stepX[i] * (startPx - edgeStart[i]->x);
+        }
+
+        float* row = &m_Depth[y * WIDTH];
+
+#if MINECRAFT_DEPTH_SSE2
+        const __m128 lanes = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 depth4 = _mm_set1_ps(depth);
+        __m128 e0 = _mm_add_ps(_mm_set1_ps(rowEdge[0]), _mm_mul_ps(lanes, _mm_set1_ps(stepX[0])));
+        __m128 e1 = _mm_add_ps(_mm_set1_ps(rowEdge[1]), _mm_mul_ps(lanes, _mm_set1_ps(stepX[1])));
+        __m128 e2 = _mm_add_ps(_mm_set1_ps(rowEdge[2]), _mm_mul_ps(lanes, _mm_set1_ps(stepX[2])));
+        const __m128 step0 = _mm_set1_ps(stepX[0] * 4.0f);
+        const __m128 step1 = _mm_set1_ps(stepX[1] * 4.0f);
+        const __m128 step2 = _mm_set1_ps(stepX[2] * 4.0f);
+
+        for (int x = startX; x <= maxX; x += 4) {
+            const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)),
+                                             _mm_cmpge_ps(e2, zero));
+            if (_mm_movemask_ps(inside)) {
+                const __m128 current = _mm_loadu_ps(row + x);
+                const __m128 closer = _mm_min_ps(current, depth4);
+                _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, closer), _mm_andnot_ps(inside, current)));
+            }
+            e0 = _mm_add_ps(e0, step0);
+            e1 = _mm_add_ps(e1, step1);
+            e2 = _mm_add_ps(e2, step2);
+        }
+#else
+        for (int x = startX; x <= maxX; ++x) {
+            const float dx = static_cast<float>(x - startX);
+            if (rowEdge[0] + stepX[0] * dx >= 0.0f &&
+                rowEdge[1] + stepX[1] * dx >= 0.0f &&
+                rowEdge[2] + stepX[2] * dx >= 0.0f) {
+                row[x] = std::min(row[x], depth);
+            }
+        }
+#endif
+    }
+}
+
+bool DepthRasterizer::IsBoxVisible(const AABB& box) const {
+    ScreenVertex corners[8];
+    if (!ProjectBox(box, corners)) {
+        return true;
+    }
+
+    float minSx = FLT_MAX, maxSx = -FLT_MAX;
+    float minSy = FLT_MAX, maxSy = -FLT_MAX;
+    float nearest = FLT_MAX;
+    for (const auto& c : corners) {
+        minSx = std::min(minSx, c.x);
+        maxSx = std::max(maxSx, c.x);
+        minSy = std::min(minSy, c.y);
+        maxSy = std::max(maxSy, c.y);
+        nearest = std::min(nearest, c.w);
+    }
+
+    // One pixel of slack covers partially covered silhouette pixels.
+    const int minX = std::max(0, static_cast<int>(std::floor(minSx)) - 1);
+    const int maxX = std::min(WIDTH - 1, static_cast<int>(std::ceil(maxSx)) + 1);
+    const int minY = std::max(0, static_cast<int>(std::floor(minSy)) - 1);
+    const int maxY = std::min(HEIGHT - 1, static_cast<int>(std::ceil(maxSy)) + 1);
+    if (minX > maxX || minY > maxY) {
+        return true;  // Off screen: frustum clipping is left to the GPU
+    }
+
+    for (int y = minY; y <= maxY; ++y) {
+        const float* row = &m_Depth[y * WIDTH];
+
+#if MINECRAFT_DEPTH_SSE2
+        const __m128 nearest4 = _mm_set1_ps(nearest);
+        for (int x = minX & ~3; x <= maxX; x += 4) {
+            if (_mm_movemask_ps(_mm_cmpgt_ps(_mm_loadu_ps(row + x), nearest4))) {
+                return true;
+            }
+        }
+#else
+        for (int x = minX; x <= maxX; ++x) {
+            if (row[x] > nearest) {
+                return true;
+            }
+        }
+#endif
+    }
+
+    return false;
+}
+
+} // namespace Minecraft
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "../Physics/AABB.h"
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace Minecraft {
+
+// Low-resolution CPU depth buffer for occlusion culling.
+// Depth is stored as clip-space w (distance along the view axis), so smaller is closer.
+// No GL dependency: can be driven headless.
+class DepthRasterizer {
+public:
+    static constexpr int WIDTH = 256;
+    static constexpr int HEIGHT = 128;
+    static constexpr float NEAR_W = 0.05f;
+
+    DepthRasterizer();
+
+    void Clear();
+    void SetViewProjection(const glm::mat4& viewProjection) { m_ViewProjection = viewProjection; }
+
+    // Rasterize the front faces of a box. Each triangle writes its farthest depth, so the
+    // occluder never ends up closer than the real geometry. Boxes crossing the near plane are skipped.
+    // Returns true if the box was rasterized.
+    bool RasterizeBox(const AABB& box);
+
+    // Returns false only if every pixel under the box's screen rectangle is behind an occluder.
+    // Boxes off screen or crossing the near plane are reported visible.
+    bool IsBoxVisible(const AABB& box) const;
+
+    float GetDepth(int x, int y) const { return m_Depth[y * WIDTH + x]; }
+
+private:
+    struct ScreenVertex {
+        float x, y, w;
+    };
+
+    bool ProjectBox(const AABB& box, ScreenVertex out[8]) const;
+    void RasterizeTriangle(const ScreenVertex& v0, const ScreenVertex& v1, const ScreenVertex& v2);
+
+    glm::mat4 m_ViewProjection = glm::mat4(1.0f);
+    std::vector<float> m_Depth;
+};
+
+} // namespace Minecraft
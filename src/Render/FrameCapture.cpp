@@ -0,0 +1,203 @@
+#include "FrameCapture.h"
+#include "../utils/Logger.h"
+#include <QDateTime>
+#include <QImage>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace Minecraft {
+
+namespace {
+
+std::string Timestamp() {
+    return QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss_zzz").toStdString();
+}
+
+} // namespace
+
+FrameCapture::FrameCapture()
+    : m_Encoder(&FrameCapture::WriteFrame) {
+}
+
+void FrameCapture::RequestScreenshot() {
+    m_ScreenshotRequested = true;
+}
+
+void FrameCapture::StartRecording(Format format) {
+    if (m_Recording) {
+        return;
+    }
+
+    m_RecordingDirectory = (std::filesystem::path(OUTPUT_DIRECTORY) / ("recording_" + Timestamp())).string();
+    std::error_code error;
+    std::filesystem::create_directories(m_RecordingDirectory, error);
+    if (error) {
+        LOG_ERROR("Failed to create capture directory " + m_RecordingDirectory + ": " + error.message());
+        return;
+    }
+
+    m_Recording = true;
+    m_RecordingFormat = format;
+    m_RecordedFrames = 0;
+    LOG_INFO("Recording frames to " + m_RecordingDirectory);
+}
+
+void FrameCapture::StopRecording() {
+    if (!m_Recording) {
+        return;
+    }
+
+    m_Recording = false;
+    const Stats stats = GetStats();
+    LOG_INFO("Recording stopped after " + std::to_string(m_RecordedFrames) + " frames (" +
+             std::to_string(stats.dropped) + " dropped in total)");
+}
+
+void FrameCapture::CaptureFrame(GLuint framebuffer, int width, int height) {
+    // Hand over every read that has finished; earlier slots finish first
+    for (int i = 0; i < RING_SIZE; ++i) {
+        Slot& slot = m_Slots[(m_NextSlot + i) % RING_SIZE];
+        if (slot.fence) {
+            CollectSlot(slot, false);
+        }
+    }
+
+    if ((!m_ScreenshotRequested && !m_Recording) || width <= 0 || height <= 0) {
+        return;
+    }
+
+    Slot& slot = m_Slots[m_NextSlot];
+    if (slot.fence) {
+        // The GPU is a full ring behind; only now does capturing cost a wait
+        CollectSlot(slot, true);
+    }
+    m_NextSlot = (m_NextSlot + 1) % RING_SIZE;
+
+    if (m_ScreenshotRequested) {
+        std::error_code error;
+        std::filesystem::create_directories(OUTPUT_DIRECTORY, error);
+        slot.path = (std::filesystem::path(OUTPUT_DIRECTORY) / ("screenshot_" + Timestamp() + ".png")).string();
+        slot.format = Format::Png;
+        slot.required = true;
+        m_ScreenshotRequested = false;
+    } else {
+        char name[64];
+        std::snprintf(name, sizeof(name), "frame_%06llu", static_cast<unsigned long long>(m_RecordedFrames++));
+        std::string fileName = name;
+        if (m_RecordingFormat == Format::Raw) {
+            fileName += "_" + std::to_string(width) + "x" + std::to_string(height) + ".rgba";
+        } else {
+            fileName += ".png";
+        }
+        slot.path = (std::filesystem::path(m_RecordingDirectory) / fileName).string();
+        slot.format = m_RecordingFormat;
+        slot.required = false;
+    }
+
+    const size_t size = static_cast<size_t>(width) * height * 4;
+    if (slot.buffer == 0) {
+        glGenBuffers(1, &slot.buffer);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    if (slot.capacity != size) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_STREAM_READ);
+        slot.capacity = size;
+    }
+
+    // With a pack buffer bound the read only queues a copy on the GPU
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    slot.width = width;
+    slot.height = height;
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_Captured++;
+}
+
+void FrameCapture::CollectSlot(Slot& slot, bool wait) {
+    const GLenum status = glClientWaitSync(slot.fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0,
+                                           wait ? GL_TIMEOUT_IGNORED : 0);
+    if (status == GL_TIMEOUT_EXPIRED) {
+        return;
+    }
+    glDeleteSync(slot.fence);
+    slot.fence = nullptr;
+    if (status == GL_WAIT_FAILED) {
+        return;
+    }
+
+    FrameEncoder::Job job;
+    if (!m_Encoder.AcquirePixels(slot.required, job.pixels)) {
+        return;
+    }
+
+    const size_t size = static_cast<size_t>(slot.width) * slot.height * 4;
+    job.pixels.resize(size);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    const void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(size), GL_MAP_READ_BIT);
+    if (mapped) {
+        std::memcpy(job.pixels.data(), mapped, size);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    if (!mapped) {
+        LOG_WARNING("Failed to map capture buffer for " + slot.path);
+        return;
+    }
+
+    job.width = slot.width;
+    job.height = slot.height;
+    job.path = slot.path;
+    job.format = slot.format;
+    job.screenshot = slot.required;
+    m_Encoder.Submit(std::move(job));
+}
+
+void FrameCapture::ReleaseResources() {
+    for (int i = 0; i < RING_SIZE; ++i) {
+        Slot& slot = m_Slots[(m_NextSlot + i) % RING_SIZE];
+        if (slot.fence) {
+            CollectSlot(slot, true);
+        }
+        if (slot.buffer) {
+            glDeleteBuffers(1, &slot.buffer);
+        }
+        slot = Slot();
+    }
+}
+
+FrameCapture::Stats FrameCapture::GetStats() const {
+    Stats stats;
+    stats.captured = m_Captured;
+    stats.written = m_Encoder.GetWrittenCount();
+    stats.dropped = m_Encoder.GetDroppedCount();
+    return stats;
+}
+
+void FrameCapture::WriteFrame(const FrameEncoder::Job& job) {
+    if (job.format == Format::Raw) {
+        std::ofstream file(job.path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(job.pixels.data()), static_cast<std::streamsize>(job.pixels.size()));
+        if (!file) {
+            LOG_WARNING("Failed to write frame: " + job.path);
+        }
+        return;
+    }
+
+    // GL rows start at the bottom
+    const QImage image(job.pixels.data(), job.width, job.height, job.width * 4, QImage::Format_RGBA8888);
+    if (!image.mirrored().save(QString::fromStdString(job.path), "PNG")) {
+        LOG_WARNING("Failed to write frame: " + job.path);
+        return;
+    }
+    if (job.screenshot) {
+        LOG_INFO("Saved screenshot " + job.path);
+    }
+}
+
+} // namespace Minecraft
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "FrameEncoder.h"
+#include <GL/glew.h>
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace Minecraft {
+
+// Reads finished frames back without stalling the pipeline. glReadPixels targets a
+// ring of pixel buffer objects; each slot is mapped only once its fence has
+// signalled, RING_SIZE - 1 frames later, so frame N is read back while N+2 renders.
+// The pixels go to a FrameEncoder that writes PNG or raw RGBA files.
+// Capture methods need the GL context that owns the framebuffer to be current.
+class FrameCapture {
+public:
+    static constexpr int RING_SIZE = 3;
+    static constexpr const char* OUTPUT_DIRECTORY = "Captures";
+
+    using Format = CaptureFormat;
+
+    struct Stats {
+        uint64_t captured = 0;
+        uint64_t written = 0;
+        uint64_t dropped = 0;  // Recorded frames skipped because the encoder fell behind
+    };
+
+    FrameCapture();
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    // Capture the next frame to a PNG
+    void RequestScreenshot();
+
+    // Capture every frame into a new directory under OUTPUT_DIRECTORY
+    void StartRecording(Format format);
+    void StopRecording();
+    bool IsRecording() const { return m_Recording; }
+
+    // Queue a read of the finished frame in `framebuffer` and hand earlier reads that
+    // have completed to the encoder. Call once per frame after everything is drawn.
+    void CaptureFrame(GLuint framebuffer, int width, int height);
+
+    // Finish outstanding reads and delete the buffers; the context must be current
+    void ReleaseResources();
+
+    Stats GetStats() const;
+
+private:
+    struct Slot {
+        GLuint buffer = 0;
+        size_t capacity = 0;
+        GLsync fence = nullptr;  // Null when the slot is free
+        int width = 0;
+        int height = 0;
+        std::string path;
+        Format format = Format::Png;
+        bool required = false;   // Screenshots are never dropped
+    };
+
+    void CollectSlot(Slot& slot, bool wait);
+    static void WriteFrame(const FrameEncoder::Job& job);
+
+    std::array<Slot, RING_SIZE> m_Slots;
+    int m_NextSlot = 0;
+    bool m_ScreenshotRequested = false;
+    bool m_Recording = false;
+    Format m_RecordingFormat = Format::Raw;
+    std::string m_RecordingDirectory;
+    uint64_t m_RecordedFrames = 0;
+    uint64_t m_Captured = 0;
+
+    FrameEncoder m_Encoder;
+};
+
+} // namespace Minecraft
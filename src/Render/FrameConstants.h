@@ -0,0 +1,32 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace Minecraft {
+
+// Uniform buffer binding point of the FrameConstants block
+constexpr unsigned int FRAME_CONSTANTS_BINDING = 0;
+
+// Per-frame values every world shader reads from one std140 uniform buffer, written
+// once per frame by the render thread. Shaders declare the matching block:
+//
+//   layout(std140) uniform FrameConstants {
+//       mat4 uViewProjection; mat4 uInvViewProjection; mat4 uFarViewProjection;
+//       vec4 uCameraPosition; vec4 uSkyColor; vec4 uSunDirection;
+//       float uGlobalLight; float uTime;
+//   };
+struct FrameConstants {
+    glm::mat4 viewProjection;
+    glm::mat4 inverseViewProjection;
+    glm::mat4 farViewProjection;    // Far terrain depth range
+    glm::vec4 cameraPosition;       // xyz
+    glm::vec4 skyColor;             // rgb
+    glm::vec4 sunDirection;         // xyz, towards the sun
+    float globalLight;
+    float time;                     // Seconds since start
+    float padding[2];
+};
+
+static_assert(sizeof(FrameConstants) == 3 * 64 + 3 * 16 + 16, "FrameConstants must match the std140 block");
+
+} // namespace Minecraft
@@ -0,0 +1,81 @@
+#include "FrameEncoder.h"
+
+namespace Minecraft {
+
+FrameEncoder::FrameEncoder(Writer writer)
+    : m_Writer(std::move(writer)) {
+    m_Worker = std::thread(&FrameEncoder::WorkerMain, this);
+}
+
+FrameEncoder::~FrameEncoder() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_ShuttingDown = true;
+    }
+    m_Cv.notify_all();
+
+    if (m_Worker.joinable()) {
+        m_Worker.join();
+    }
+}
+
+bool FrameEncoder::AcquirePixels(bool required, std::vector<unsigned char>& pixels) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (!required && m_Jobs.size() >= MAX_QUEUED_FRAMES) {
+        m_Dropped++;
+        return false;
+    }
+    if (!m_FreeBuffers.empty()) {
+        pixels = std::move(m_FreeBuffers.back());
+        m_FreeBuffers.pop_back();
+    }
+    return true;
+}
+
+void FrameEncoder::Submit(Job job) {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Jobs.push_back(std::move(job));
+    }
+    m_Cv.notify_one();
+}
+
+uint64_t FrameEncoder::GetWrittenCount() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Written;
+}
+
+uint64_t FrameEncoder::GetDroppedCount() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Dropped;
+}
+
+void FrameEncoder::WorkerMain() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Cv.wait(lock, [this]() {
+                return m_ShuttingDown || !m_Jobs.empty();
+            });
+
+            // Pending frames are still written on shutdown
+            if (m_Jobs.empty()) {
+                return;
+            }
+
+            job = std::move(m_Jobs.front());
+            m_Jobs.pop_front();
+        }
+
+        m_Writer(job);
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Written++;
+        if (m_FreeBuffers.size() < MAX_QUEUED_FRAMES) {
+            m_FreeBuffers.push_back(std::move(job.pixels));
+        }
+    }
+}
+
+} // namespace Minecraft
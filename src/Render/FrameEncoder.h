@@ -0,0 +1,64 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Minecraft {
+
+enum class CaptureFormat {
+    Png,
+    Raw   // RGBA8, bottom-up rows, size in the file name; cheap enough for every frame
+};
+
+// Writes captured frames on a worker thread. Pixel storage is recycled from written
+// frames, and while the backlog is full new recorded frames are dropped instead of
+// queued; screenshots are always queued. Frames still queued are written on shutdown.
+class FrameEncoder {
+public:
+    static constexpr size_t MAX_QUEUED_FRAMES = 8;  // Backlog before recorded frames are dropped
+
+    struct Job {
+        std::vector<unsigned char> pixels;
+        int width = 0;
+        int height = 0;
+        std::string path;
+        CaptureFormat format = CaptureFormat::Png;
+        bool screenshot = false;
+    };
+
+    using Writer = std::function<void(const Job&)>;
+
+    explicit FrameEncoder(Writer writer);
+    ~FrameEncoder();
+    FrameEncoder(const FrameEncoder&) = delete;
+    FrameEncoder& operator=(const FrameEncoder&) = delete;
+
+    // Storage for a frame about to be queued, or false (and counted as dropped) when
+    // the backlog is full and the frame is not required
+    bool AcquirePixels(bool required, std::vector<unsigned char>& pixels);
+    void Submit(Job job);
+
+    uint64_t GetWrittenCount() const;
+    uint64_t GetDroppedCount() const;
+
+private:
+    void WorkerMain();
+
+    Writer m_Writer;
+    std::deque<Job> m_Jobs;
+    std::vector<std::vector<unsigned char>> m_FreeBuffers;
+    uint64_t m_Written = 0;
+    uint64_t m_Dropped = 0;
+    bool m_ShuttingDown = false;
+    mutable std::mutex m_Mutex;
+    std::condition_variable m_Cv;
+    std::thread m_Worker;
+};
+
+} // namespace Minecraft
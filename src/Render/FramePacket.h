@@ -0,0 +1,58 @@
+#pragma once
+
+#include "../World/World.h"
+#include "../World/ChunkMeshBuilder.h"
+#include "../World/FarTerrain.h"
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace Minecraft {
+
+enum class RenderCommandType {
+    UploadMesh,             // Replace the chunk's GPU mesh with `mesh`
+    ReleaseMesh,            // Chunk was unloaded
+    UpdateTransparentOrder, // Sorted transparent faces for mesh `meshVersion`
+    UploadFarTile,          // Horizon tile `farTile` with `farVertices`
+    ReleaseFarTile          // Horizon tile no longer selected
+};
+
+struct RenderCommand {
+    RenderCommandType type = RenderCommandType::UploadMesh;
+    ChunkPos pos;
+    uint32_t meshVersion = 0;
+    ChunkMeshData mesh;                     // UploadMesh
+    std::vector<unsigned int> indices;      // UpdateTransparentOrder, vertex mesh
+    std::vector<uint32_t> packedFaces;      // UpdateTransparentOrder, packed mesh
+    FarTileKey farTile;                     // UploadFarTile, ReleaseFarTile
+    std::vector<FarTerrainVertex> farVertices;  // UploadFarTile
+};
+
+// Everything the render thread needs for one frame, built by the simulation thread.
+// Once submitted the packet belongs to the render thread; commands run in order
+// before the frame is drawn.
+struct FramePacket {
+    glm::mat4 viewProjection = glm::mat4(1.0f);
+    glm::vec3 cameraPosition = glm::vec3(0.0f);
+    glm::vec3 skyColor = glm::vec3(0.0f);
+    glm::vec3 sunDirection = glm::vec3(0.0f, 1.0f, 0.0f);  // Towards the sun
+    float globalLight = 1.0f;
+    float time = 0.0f;  // Seconds since start
+    int width = 1;   // Framebuffer size in pixels
+    int height = 1;
+    float targetFrameMs = 1000.0f / 60.0f;  // Frame budget the render resolution adapts to
+    bool regionBatching = true;
+
+    std::vector<ChunkPos> opaqueChunks;       // Meshed and not occluded
+    std::vector<ChunkPos> transparentChunks;  // Back to front
+    std::vector<RenderCommand> commands;
+
+    // Heightmap horizon, drawn behind the chunks with its own far plane
+    glm::mat4 farViewProjection = glm::mat4(1.0f);
+    glm::vec2 voxelMin = glm::vec2(0.0f);  // XZ area covered by voxel chunks, masked out of the horizon
+    glm::vec2 voxelMax = glm::vec2(0.0f);
+    float horizonDistance = 0.0f;
+    std::vector<FarTileKey> farTiles;
+};
+
+} // namespace Minecraft
@@ -0,0 +1,49 @@
+#include "FramePacketMailbox.h"
+#include <iterator>
+
+namespace Minecraft {
+
+void FramePacketMailbox::Submit(FramePacket packet) {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (m_Closed) {
+            return;
+        }
+        if (m_HasPacket) {
+            std::vector<RenderCommand> commands = std::move(m_Pending.commands);
+            commands.insert(commands.end(),
+                            std::make_move_iterator(packet.commands.begin()),
+                            std::make_move_iterator(packet.commands.end()));
+            packet.commands = std::move(commands);
+        }
+        m_Pending = std::move(packet);
+        m_HasPacket = true;
+    }
+    m_Cv.notify_all();
+}
+
+bool FramePacketMailbox::Wait(FramePacket& packet) {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Cv.wait(lock, [this]() {
+        return m_Closed || m_HasPacket;
+    });
+
+    if (m_Closed) {
+        return false;
+    }
+
+    packet = std::move(m_Pending);
+    m_Pending = FramePacket();
+    m_HasPacket = false;
+    return true;
+}
+
+void FramePacketMailbox::Close() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Closed = true;
+    }
+    m_Cv.notify_all();
+}
+
+} // namespace Minecraft
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "FramePacket.h"
+#include <condition_variable>
+#include <mutex>
+
+namespace Minecraft {
+
+// Single-slot hand-off of FramePackets from the simulation to the render thread.
+// The renderer only ever draws the newest packet, but commands of a skipped packet
+// still run, in submission order, so no upload or release is lost.
+class FramePacketMailbox {
+public:
+    FramePacketMailbox() = default;
+    FramePacketMailbox(const FramePacketMailbox&) = delete;
+    FramePacketMailbox& operator=(const FramePacketMailbox&) = delete;
+
+    // Replace a packet nobody has taken yet; its commands go ahead of the new ones
+    void Submit(FramePacket packet);
+
+    // Block until a packet is available; false once closed
+    bool Wait(FramePacket& packet);
+
+    // Wake the waiting thread for good; later submissions are dropped
+    void Close();
+
+private:
+    FramePacket m_Pending;
+    bool m_HasPacket = false;
+    bool m_Closed = false;
+    std::mutex m_Mutex;
+    std::condition_variable m_Cv;
+};
+
+} // namespace Minecraft
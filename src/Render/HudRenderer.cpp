@@ -0,0 +1,197 @@
+#include "HudRenderer.h"
+#include "RenderState.h"
+#include "Shader.h"
+#include "../utils/Logger.h"
+#include <QFont>
+#include <QFontMetricsF>
+#include <QImage>
+#include <QPainter>
+#include <algorithm>
+#include <cmath>
+
+namespace Minecraft {
+
+HudRenderer::HudRenderer() = default;
+
+HudRenderer::~HudRenderer() {
+    RenderState::DeleteVertexArray(m_VAO);
+    RenderState::DeleteBuffer(m_VBO);
+    RenderState::DeleteTexture(m_Atlas);
+}
+
+bool HudRenderer::Initialize(const std::string& fontFamily, int pointSize, float pixelRatio) {
+    m_Shader = std::make_unique<Shader>();
+    if (!m_Shader->LoadFromFile("Resource/Shader/hud.vert", "Resource/Shader/hud.frag")) {
+        LOG_ERROR("Failed to load HUD shader");
+        return false;
+    }
+    m_ScreenSizeHandle = m_Shader->GetUniformLocation("uScreenSize");
+    m_Shader->Bind();
+    m_Shader->SetInt(m_Shader->GetUniformLocation("uAtlas"), 0);
+    m_Shader->Unbind();
+
+    // Rasterize printable ASCII into a 16-column grid, plus one white cell for solid quads
+    const QFont font(QString::fromStdString(fontFamily), pointSize, QFont::Bold);
+    const QFontMetricsF metrics(font);
+    m_CellWidth = static_cast<float>(std::ceil(metrics.maxWidth())) + 2.0f;
+    m_LineHeight = static_cast<float>(std::ceil(metrics.height()));
+    const float cellHeight = m_LineHeight + 2.0f;
+
+    constexpr int columns = 16;
+    constexpr int rows = (GLYPH_COUNT + 1 + columns - 1) / columns;
+    const int atlasWidth = static_cast<int>(std::ceil(columns * m_CellWidth * pixelRatio));
+    const int atlasHeight = static_cast<int>(std::ceil(rows * cellHeight * pixelRatio));
+
+    QImage image(atlasWidth, atlasHeight, QImage::Format_RGBA8888);
+    image.fill(Qt::transparent);
+    image.setDevicePixelRatio(pixelRatio);
+    {
+        QPainter painter(&image);
+        painter.setFont(font);
+        painter.setPen(Qt::white);
+        for (int i = 0; i <= GLYPH_COUNT; ++i) {
+            const float x = static_cast<float>(i % columns) * m_CellWidth;
+            const float y = static_cast<float>(i / columns) * cellHeight;
+            if (i == GLYPH_COUNT) {
+                painter.fillRect(QRectF(x, y, m_CellWidth, cellHeight), Qt::white);
+                m_WhiteUV = glm::vec2((x + m_CellWidth * 0.5f) / (columns * m_CellWidth),
+                                      (y + cellHeight * 0.5f) / (rows * cellHeight));
+                continue;
+            }
+
+            const QChar ch(static_cast<char16_t>(FIRST_GLYPH + i));
+            painter.drawText(QPointF(x + 1.0f, y + 1.0f + metrics.ascent()), QString(ch));
+
+            Glyph& glyph = m_Glyphs[i];
+            glyph.advance = static_cast<float>(metrics.horizontalAdvance(ch));
+            glyph.uvMin = glm::vec2(x / (columns * m_CellWidth), y / (rows * cellHeight));
+            glyph.uvMax = glm::vec2((x + m_CellWidth) / (columns * m_CellWidth), (y + cellHeight) / (rows * cellHeight));
+        }
+    }
+
+    glGenTextures(1, &m_Atlas);
+    RenderState::BindTexture(0, GL_TEXTURE_2D, m_Atlas);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, atlasWidth, atlasHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, image.constBits());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    RenderState::BindTexture(0, GL_TEXTURE_2D, 0);
+
+    glGenVertexArrays(1, &m_VAO);
+    glGenBuffers(1, &m_VBO);
+    RenderState::BindVertexArray(m_VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoord));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), (void*)offsetof(Vertex, color));
+    RenderState::BindVertexArray(0);
+
+    LOG_INFO("HUD glyph atlas: " + std::to_string(atlasWidth) + "x" + std::to_string(atlasHeight));
+    return true;
+}
+
+void HudRenderer::Begin(int width, int height) {
+    m_Width = std::max(width, 1);
+    m_Height = std::max(height, 1);
+    m_Vertices.clear();
+}
+
+void HudRenderer::DrawRect(float x, float y, float w, float h, const glm::vec4& color) {
+    PushQuad(x, y, x + w, y + h, m_WhiteUV, m_WhiteUV, PackColor(color));
+}
+
+void HudRenderer::DrawRectOutline(float x, float y, float w, float h, float thickness, const glm::vec4& color) {
+    // Centred on the edge, like a QPainter pen
+    const float half = thickness * 0.5f;
+    DrawRect(x - half, y - half, w + thickness, thickness, color);
+    DrawRect(x - half, y + h - half, w + thickness, thickness, color);
+    DrawRect(x - half, y + half, thickness, h - thickness, color);
+    DrawRect(x + w - half, y + half, thickness, h - thickness, color);
+}
+
+void HudRenderer::DrawText(float x, float y, const std::string& text, const glm::vec4& color, Align align) {
+    if (align == Align::Center) {
+        x -= MeasureText(text) * 0.5f;
+    } else if (align == Align::Right) {
+        x -= MeasureText(text);
+    }
+
+    const uint32_t packed = PackColor(color);
+    const float cellHeight = m_LineHeight + 2.0f;
+    for (char c : text) {
+        const int index = static_cast<unsigned char>(c) - FIRST_GLYPH;
+        if (index < 0 || index >= GLYPH_COUNT) {
+            continue;
+        }
+        const Glyph& glyph = m_Glyphs[index];
+        if (c != ' ') {
+            PushQuad(x - 1.0f, y - 1.0f, x - 1.0f + m_CellWidth, y - 1.0f + cellHeight, glyph.uvMin, glyph.uvMax, packed);
+        }
+        x += glyph.advance;
+    }
+}
+
+float HudRenderer::MeasureText(const std::string& text) const {
+    float width = 0.0f;
+    for (char c : text) {
+        const int index = static_cast<unsigned char>(c) - FIRST_GLYPH;
+        if (index >= 0 && index < GLYPH_COUNT) {
+            width += m_Glyphs[index].advance;
+        }
+    }
+    return width;
+}
+
+void HudRenderer::End() {
+    if (m_Vertices.empty() || !m_Shader) {
+        return;
+    }
+
+    RenderState::BindVertexArray(m_VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    if (m_Vertices.size() > m_BufferCapacity) {
+        m_BufferCapacity = m_Vertices.size() * 2;
+    }
+    // Orphan the storage so the driver doesn't stall on last frame's draw
+    glBufferData(GL_ARRAY_BUFFER, m_BufferCapacity * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, m_Vertices.size() * sizeof(Vertex), m_Vertices.data());
+
+    RenderState::SetEnabled(GL_DEPTH_TEST, false);
+    RenderState::SetEnabled(GL_CULL_FACE, false);
+    RenderState::SetEnabled(GL_BLEND, true);
+    RenderState::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    m_Shader->Bind();
+    m_Shader->SetVec2(m_ScreenSizeHandle, glm::vec2(static_cast<float>(m_Width), static_cast<float>(m_Height)));
+    RenderState::BindTexture(0, GL_TEXTURE_2D, m_Atlas);
+    RenderState::DrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_Vertices.size()));
+    RenderState::BindVertexArray(0);
+    RenderState::SetEnabled(GL_BLEND, false);
+}
+
+void HudRenderer::PushQuad(float x0, float y0, float x1, float y1, const glm::vec2& uv0, const glm::vec2& uv1, uint32_t color) {
+    const Vertex topLeft{{x0, y0}, {uv0.x, uv0.y}, color};
+    const Vertex topRight{{x1, y0}, {uv1.x, uv0.y}, color};
+    const Vertex bottomRight{{x1, y1}, {uv1.x, uv1.y}, color};
+    const Vertex bottomLeft{{x0, y1}, {uv0.x, uv1.y}, color};
+    m_Vertices.push_back(topLeft);
+    m_Vertices.push_back(bottomLeft);
+    m_Vertices.push_back(bottomRight);
+    m_Vertices.push_back(topLeft);
+    m_Vertices.push_back(bottomRight);
+    m_Vertices.push_back(topRight);
+}
+
+uint32_t HudRenderer::PackColor(const glm::vec4& color) {
+    const glm::vec4 c = glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f;
+    // Byte order matches the GL_UNSIGNED_BYTE attribute on little-endian hosts
+    return static_cast<uint32_t>(c.r) | (static_cast<uint32_t>(c.g) << 8) |
+           (static_cast<uint32_t>(c.b) << 16) | (static_cast<uint32_t>(c.a) << 24);
+}
+
+} // namespace Minecraft
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Minecraft {
+
+class Shader;
+
+// Batches the 2D overlay into one vertex buffer and one draw call. Text comes
+// from a glyph atlas rasterized once at startup; solid quads sample the atlas's
+// white texel, so rectangles and text share the texture and the draw.
+// Coordinates are logical pixels with the origin at the top-left.
+class HudRenderer {
+public:
+    enum class Align { Left, Center, Right };
+
+    HudRenderer();
+    ~HudRenderer();
+    HudRenderer(const HudRenderer&) = delete;
+    HudRenderer& operator=(const HudRenderer&) = delete;
+
+    // Needs a current GL context; `pixelRatio` sharpens glyphs on high-DPI screens
+    bool Initialize(const std::string& fontFamily, int pointSize, float pixelRatio);
+
+    void Begin(int width, int height);
+    void DrawRect(float x, float y, float w, float h, const glm::vec4& color);
+    void DrawRectOutline(float x, float y, float w, float h, float thickness, const glm::vec4& color);
+    // `x` is the left edge, centre or right edge depending on `align`; `y` is the top
+    void DrawText(float x, float y, const std::string& text, const glm::vec4& color, Align align = Align::Left);
+    float MeasureText(const std::string& text) const;
+    float GetLineHeight() const { return m_LineHeight; }
+    // Upload the batch and draw it
+    void End();
+
+private:
+    static constexpr int FIRST_GLYPH = 32;
+    static constexpr int GLYPH_COUNT = 95;  // Printable ASCII
+
+    struct Vertex {
+        glm::vec2 position;
+        glm::vec2 texCoord;
+        uint32_t color;  // RGBA8
+    };
+
+    struct Glyph {
+        glm::vec2 uvMin;
+        glm::vec2 uvMax;
+        float advance = 0.0f;
+    };
+
+    void PushQuad(float x0, float y0, float x1, float y1, const glm::vec2& uv0, const glm::vec2& uv1, uint32_t color);
+    static uint32_t PackColor(const glm::vec4& color);
+
+    std::unique_ptr<Shader> m_Shader;
+    GLint m_ScreenSizeHandle = -1;
+    GLuint m_Atlas = 0;
+    GLuint m_VAO = 0;
+    GLuint m_VBO = 0;
+    size_t m_BufferCapacity = 0;  // Vertices
+
+    std::array<Glyph, GLYPH_COUNT> m_Glyphs{};
+    glm::vec2 m_WhiteUV = glm::vec2(0.0f);
+    float m_CellWidth = 0.0f;   // Logical pixels
+    float m_LineHeight = 0.0f;
+
+    std::vector<Vertex> m_Vertices;
+    int m_Width = 1;
+    int m_Height = 1;
+};
+
+} // namespace Minecraft
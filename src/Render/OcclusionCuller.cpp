@@ -0,0 +1,110 @@
+#include "OcclusionCuller.h"
+#include <algorithm>
+#include <chrono>
+
+namespace Minecraft {
+
+OcclusionCuller::OcclusionCuller() {
+    m_Worker = std::thread(&OcclusionCuller::WorkerMain, this);
+}
+
+OcclusionCuller::~OcclusionCuller() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_ShuttingDown = true;
+    }
+    m_Cv.notify_all();
+
+    if (m_Worker.joinable()) {
+        m_Worker.join();
+    }
+}
+
+void OcclusionCuller::Submit(Frame frame) {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_PendingFrame = std::move(frame);
+        m_HasPendingFrame = true;
+    }
+    m_Cv.notify_one();
+}
+
+bool OcclusionCuller::TryTakeResult(Result& result) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (!m_HasResult) {
+        return false;
+    }
+
+    result = std::move(m_LatestResult);
+    m_HasResult = false;
+    return true;
+}
+
+OcclusionCuller::Result OcclusionCuller::Process(DepthRasterizer& rasterizer, Frame& frame) {
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    const auto elapsedMs = [&start]() {
+        return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+    };
+
+    Result result;
+    rasterizer.Clear();
+    rasterizer.SetViewProjection(frame.viewProjection);
+
+    // Nearest occluders cover the most screen, so draw them first and stop at the budget.
+    const glm::vec3 eye = frame.cameraPosition;
+    std::sort(frame.occluders.begin(), frame.occluders.end(),
+              [&eye](const AABB& lhs, const AABB& rhs) {
+                  const glm::vec3 dl = lhs.GetCenter() - eye;
+                  const glm::vec3 dr = rhs.GetCenter() - eye;
+                  return glm::dot(dl, dl) < glm::dot(dr, dr);
+              });
+
+    const int occluderCount = std::min(static_cast<int>(frame.occluders.size()), MAX_OCCLUDERS);
+    for (int i = 0; i < occluderCount; ++i) {
+        if (rasterizer.RasterizeBox(frame.occluders[i])) {
+            result.occludersDrawn++;
+        }
+        if ((i & 15) == 15 && elapsedMs() > RASTER_BUDGET_MS) {
+            break;
+        }
+    }
+
+    for (const Candidate& candidate : frame.candidates) {
+        if (!rasterizer.IsBoxVisible(candidate.bounds)) {
+            result.occludedKeys.push_back(candidate.key);
+        }
+    }
+    result.candidatesTested = static_cast<int>(frame.candidates.size());
+    result.cullTimeMs = elapsedMs();
+    return result;
+}
+
+void OcclusionCuller::WorkerMain() {
+    while (true) {
+        Frame frame;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Cv.wait(lock, [this]() {
+                return m_ShuttingDown || m_HasPendingFrame;
+            });
+
+            if (m_ShuttingDown) {
+                return;
+            }
+
+            frame = std::move(m_PendingFrame);
+            m_HasPendingFrame = false;
+        }
+
+        Result result = Process(m_Rasterizer, frame);
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_LatestResult = std::move(result);
+            m_HasResult = true;
+        }
+    }
+}
+
+} // namespace Minecraft
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "DepthRasterizer.h"
+#include "../Physics/AABB.h"
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace Minecraft {
+
+// Runs the software occlusion pass on a worker thread.
+// The caller submits one frame of occluders and candidate bounds and picks up the
+// newest finished result later, so culling decisions lag the camera by one frame.
+class OcclusionCuller {
+public:
+    static constexpr int MAX_OCCLUDERS = 384;
+    static constexpr float RASTER_BUDGET_MS = 0.75f;
+
+    struct Candidate {
+        uint64_t key;
+        AABB bounds;
+    };
+
+    struct Frame {
+        glm::mat4 viewProjection = glm::mat4(1.0f);
+        glm::vec3 cameraPosition = glm::vec3(0.0f);
+        std::vector<AABB> occluders;
+        std::vector<Candidate> candidates;
+    };
+
+    struct Result {
+        std::vector<uint64_t> occludedKeys;
+        int occludersDrawn = 0;
+        int candidatesTested = 0;
+        float cullTimeMs = 0.0f;
+    };
+
+    OcclusionCuller();
+    ~OcclusionCuller();
+
+    // Replace any frame still waiting for the worker
+    void Submit(Frame frame);
+
+    // Take the newest completed result (returns false if none arrived since the last call)
+    bool TryTakeResult(Result& result);
+
+    // Synchronous pass used by the worker
+    static Result Process(DepthRasterizer& rasterizer, Frame& frame);
+
+private:
+    void WorkerMain();
+
+    DepthRasterizer m_Rasterizer;
+    Frame m_PendingFrame;
+    Result m_LatestResult;
+    bool m_HasPendingFrame = false;
+    bool m_HasResult = false;
+    bool m_ShuttingDown = false;
+    std::mutex m_Mutex;
+    std::condition_variable m_Cv;
+    std::thread m_Worker;
+};
+
+} // namespace Minecraft
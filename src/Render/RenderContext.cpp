@@ -0,0 +1,49 @@
+#include "RenderContext.h"
+#include "../utils/Logger.h"
+#include <QCoreApplication>
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QThread>
+
+namespace Minecraft {
+
+RenderContext::RenderContext() = default;
+
+RenderContext::~RenderContext() = default;
+
+bool RenderContext::Create(QOpenGLContext* shareContext, QThread* thread) {
+    m_Context = std::make_unique<QOpenGLContext>();
+    m_Context->setFormat(shareContext->format());
+    m_Context->setShareContext(shareContext);
+    if (!m_Context->create()) {
+        LOG_ERROR("Failed to create render thread GL context");
+        m_Context.reset();
+        return false;
+    }
+
+    // Offscreen surfaces must be created on the GUI thread
+    m_Surface = std::make_unique<QOffscreenSurface>();
+    m_Surface->setFormat(m_Context->format());
+    m_Surface->create();
+
+    m_Context->moveToThread(thread);
+    return true;
+}
+
+bool RenderContext::MakeCurrent() {
+    return m_Context && m_Context->makeCurrent(m_Surface.get());
+}
+
+void RenderContext::DoneCurrent() {
+    if (m_Context) {
+        m_Context->doneCurrent();
+    }
+}
+
+void RenderContext::ReturnToMainThread() {
+    if (m_Context) {
+        m_Context->moveToThread(QCoreApplication::instance()->thread());
+    }
+}
+
+} // namespace Minecraft
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <memory>
+
+class QOffscreenSurface;
+class QOpenGLContext;
+class QThread;
+
+namespace Minecraft {
+
+// Offscreen GL context in the widget's share group, driven from a worker thread.
+// Kept apart from RenderThread because Qt's GL headers conflict with GLEW.
+class RenderContext {
+public:
+    RenderContext();
+    ~RenderContext();
+    RenderContext(const RenderContext&) = delete;
+    RenderContext& operator=(const RenderContext&) = delete;
+
+    // GUI thread: create the context and its surface, then hand the context to `thread`
+    bool Create(QOpenGLContext* shareContext, QThread* thread);
+
+    // Worker thread
+    bool MakeCurrent();
+    void DoneCurrent();
+
+    // Worker thread, last call: give the context back so the GUI thread can destroy it
+    void ReturnToMainThread();
+
+private:
+    std::unique_ptr<QOpenGLContext> m_Context;
+    std::unique_ptr<QOffscreenSurface> m_Surface;
+};
+
+} // namespace Minecraft
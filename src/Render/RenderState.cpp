@@ -0,0 +1,241 @@
+#include "RenderState.h"
+
+namespace Minecraft {
+
+thread_local RenderStats RenderState::s_Current;
+thread_local RenderStats RenderState::s_LastFrame;
+
+thread_local int RenderState::s_Capabilities[CAPABILITY_COUNT] = {-1, -1, -1};
+thread_local GLenum RenderState::s_DepthFunc = UNKNOWN;
+thread_local int RenderState::s_DepthMask = -1;
+thread_local GLenum RenderState::s_CullFace = UNKNOWN;
+thread_local GLenum RenderState::s_BlendSource = UNKNOWN;
+thread_local GLenum RenderState::s_BlendDestination = UNKNOWN;
+thread_local GLuint RenderState::s_Program = UNKNOWN;
+thread_local GLuint RenderState::s_VertexArray = UNKNOWN;
+thread_local unsigned int RenderState::s_ActiveTextureSlot = UNKNOWN;
+thread_local GLenum RenderState::s_TextureTargets[TEXTURE_SLOTS];
+thread_local GLuint RenderState::s_Textures[TEXTURE_SLOTS];
+thread_local GLuint RenderState::s_StorageBuffers[BUFFER_BASE_SLOTS];
+
+void RenderState::BeginFrame() {
+    s_LastFrame = s_Current;
+    s_Current = RenderStats();
+}
+
+void RenderState::Invalidate() {
+    for (int& capability : s_Capabilities) {
+        capability = -1;
+    }
+    s_DepthFunc = UNKNOWN;
+    s_DepthMask = -1;
+    s_CullFace = UNKNOWN;
+    s_BlendSource = UNKNOWN;
+    s_BlendDestination = UNKNOWN;
+    s_Program = UNKNOWN;
+    s_VertexArray = UNKNOWN;
+    s_ActiveTextureSlot = UNKNOWN;
+    for (int i = 0; i < TEXTURE_SLOTS; ++i) {
+        s_TextureTargets[i] = UNKNOWN;
+        s_Textures[i] = UNKNOWN;
+    }
+    for (GLuint& buffer : s_StorageBuffers) {
+        buffer = UNKNOWN;
+    }
+}
+
+int RenderState::CapabilityIndex(GLenum capability) {
+    switch (capability) {
+        case GL_DEPTH_TEST: return 0;
+        case GL_CULL_FACE: return 1;
+        case GL_BLEND: return 2;
+        default: return -1;
+    }
+}
+
+void RenderState::SetEnabled(GLenum capability, bool enabled) {
+    const int index = CapabilityIndex(capability);
+    const int value = enabled ? 1 : 0;
+    if (index >= 0 && s_Capabilities[index] == value) {
+        s_Current.filteredCalls++;
+        return;
+    }
+
+    if (enabled) {
+        glEnable(capability);
+    } else {
+        glDisable(capability);
+    }
+    if (index >= 0) {
+        s_Capabilities[index] = value;
+    }
+    s_Current.glCalls++;
+    s_Current.stateChanges++;
+}
+
+void RenderState::SetDepthFunc(GLenum func) {
+    if (s_DepthFunc == func) {
+        s_Current.filteredCalls++;
+        return;
+    }
+    glDepthFunc(func);
+    s_DepthFunc = func;
+    s_Current.glCalls++;
+    s_Current.stateChanges++;
+}
+
+void RenderState::SetDepthMask(bool enabled) {
+    const int value = enabled ? 1 : 0;
+    if (s_DepthMask == value) {
+        s_Current.filteredCalls++;
+        return;
+    }
+    glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+    s_DepthMask = value;
+    s_Current.glCalls++;
+    s_Current.stateChanges++;
+}
+
+void RenderState::SetCullFace(GLenum face) {
+    if (s_CullFace == face) {
+        s_Current.filteredCalls++;
+        return;
+    }
+    glCullFace(face);
+    s_CullFace = face;
+    s_Current.glCalls++;
+    s_Current.stateChanges++;
+}
+
+void RenderState::SetBlendFunc(GLenum source, GLenum destination) {
+    if (s_BlendSource == source && s_BlendDestination == destination) {
+        s_Current.filteredCalls++;
+        return;
+    }
+    glBlendFunc(source, destination);
+    s_BlendSource = source;
+    s_BlendDestination = destination;
+    s_Current.glCalls++;
+    s_Current.stateChanges++;
+}
+
+void RenderState::UseProgram(GLuint program) {
+    if (s_Program == program) {
+        s_Current.filteredCalls++;
+        return;
+    }
+    glUseProgram(program);
+    s_Program = program;
+    s_Current.glCalls++;
+    s_Current.binds++;
+}
+
+void RenderState::BindVertexArray(GLuint vao) {
+    if (s_VertexArray == vao) {
+        s_Current.filteredCalls++;
+        return;
+    }
+    glBindVertexArray(vao);
+    s_VertexArray = vao;
+    s_Current.glCalls++;
+    s_Current.binds++;
+}
+
+void RenderState::BindTexture(unsigned int slot, GLenum target, GLuint texture) {
+    if (slot < TEXTURE_SLOTS && s_TextureTargets[slot] == target && s_Textures[slot] == texture) {
+        s_Current.filteredCalls++;
+        return;
+    }
+
+    if (s_ActiveTextureSlot != slot) {
+        glActiveTexture(GL_TEXTURE0 + slot);
+        s_ActiveTextureSlot = slot;
+        s_Current.glCalls++;
+    }
+    glBindTexture(target, texture);
+    if (slot < TEXTURE_SLOTS) {
+        s_TextureTargets[slot] = target;
+        s_Textures[slot] = texture;
+    }
+    s_Current.glCalls++;
+    s_Current.binds++;
+}
+
+void RenderState::BindBufferBase(GLenum target, GLuint index, GLuint buffer) {
+    const bool cached = target == GL_SHADER_STORAGE_BUFFER && index < BUFFER_BASE_SLOTS;
+    if (cached && s_StorageBuffers[index] == buffer) {
+        s_Current.filteredCalls++;
+        return;
+    }
+    glBindBufferBase(target, index, buffer);
+    if (cached) {
+        s_StorageBuffers[index] = buffer;
+    }
+    s_Current.glCalls++;
+    s_Current.binds++;
+}
+
+void RenderState::DeleteVertexArray(GLuint vao) {
+    if (vao == 0) {
+        return;
+    }
+    // GL may hand the name out again, so a stale cache entry would filter the next real bind
+    if (s_VertexArray == vao) {
+        s_VertexArray = 0;
+    }
+    glDeleteVertexArrays(1, &vao);
+    s_Current.glCalls++;
+}
+
+void RenderState::DeleteBuffer(GLuint buffer) {
+    if (buffer == 0) {
+        return;
+    }
+    for (GLuint& bound : s_StorageBuffers) {
+        if (bound == buffer) {
+            bound = 0;
+        }
+    }
+    glDeleteBuffers(1, &buffer);
+    s_Current.glCalls++;
+}
+
+void RenderState::DeleteTexture(GLuint texture) {
+    if (texture == 0) {
+        return;
+    }
+    // GL unbinds a deleted texture from every unit, which leaves 0 bound there
+    for (GLuint& bound : s_Textures) {
+        if (bound == texture) {
+            bound = 0;
+        }
+    }
+    glDeleteTextures(1, &texture);
+    s_Current.glCalls++;
+}
+
+void RenderState::DeleteProgram(GLuint program) {
+    if (program == 0) {
+        return;
+    }
+    // A current program is only flagged for deletion; release it so the name is freed now
+    if (s_Program == program) {
+        UseProgram(0);
+    }
+    glDeleteProgram(program);
+    s_Current.glCalls++;
+}
+
+void RenderState::DrawElements(GLenum mode, GLsizei count) {
+    glDrawElements(mode, count, GL_UNSIGNED_INT, nullptr);
+    s_Current.glCalls++;
+    s_Current.draws++;
+}
+
+void RenderState::DrawArrays(GLenum mode, GLint first, GLsizei count) {
+    glDrawArrays(mode, first, count);
+    s_Current.glCalls++;
+    s_Current.draws++;
+}
+
+} // namespace Minecraft
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <GL/glew.h>
+
+namespace Minecraft {
+
+struct RenderStats {
+    int glCalls = 0;        // Calls that reached the driver through RenderState or Shader
+    int filteredCalls = 0;  // Redundant calls dropped by the cache
+    int stateChanges = 0;   // Enable/disable, depth, blend and cull state
+    int binds = 0;          // Program, VAO, texture and buffer binds
+    int draws = 0;
+};
+
+// Thin cache in front of the GL state machine. Redundant binds and state changes are
+// filtered, and every call is counted so per-frame overhead can be observed.
+// The cache is per thread, one per GL context: the render thread and the GUI
+// thread's compositing each see their own state.
+class RenderState {
+public:
+    // Start a new frame's counters; the finished frame is available from GetFrameStats()
+    static void BeginFrame();
+
+    // Forget cached state after code outside RenderState (QPainter, Qt) touched GL
+    static void Invalidate();
+
+    static void SetEnabled(GLenum capability, bool enabled);
+    static void SetDepthFunc(GLenum func);
+    static void SetDepthMask(bool enabled);
+    static void SetCullFace(GLenum face);
+    static void SetBlendFunc(GLenum source, GLenum destination);
+
+    static void UseProgram(GLuint program);
+    static void BindVertexArray(GLuint vao);
+    static void BindTexture(unsigned int slot, GLenum target, GLuint texture);
+    static void BindBufferBase(GLenum target, GLuint index, GLuint buffer);
+
+    // Delete GL objects and drop any cached binding of their names
+    static void DeleteVertexArray(GLuint vao);
+    static void DeleteBuffer(GLuint buffer);
+    static void DeleteTexture(GLuint texture);
+    static void DeleteProgram(GLuint program);
+
+    static void DrawElements(GLenum mode, GLsizei count);
+    static void DrawArrays(GLenum mode, GLint first, GLsizei count);
+
+    // Count a GL call made directly (uniform uploads)
+    static void CountCall() { s_Current.glCalls++; }
+
+    static const RenderStats& GetFrameStats() { return s_LastFrame; }
+
+private:
+    static constexpr int CAPABILITY_COUNT = 3;
+    static constexpr int TEXTURE_SLOTS = 8;
+    static constexpr int BUFFER_BASE_SLOTS = 4;
+    static constexpr GLuint UNKNOWN = 0xffffffffu;
+
+    static int CapabilityIndex(GLenum capability);
+
+    static thread_local RenderStats s_Current;
+    static thread_local RenderStats s_LastFrame;
+
+    static thread_local int s_Capabilities[CAPABILITY_COUNT];  // -1 unknown, 0 disabled, 1 enabled
+    static thread_local GLenum s_DepthFunc;
+    static thread_local int s_DepthMask;
+    static thread_local GLenum s_CullFace;
+    static thread_local GLenum s_BlendSource;
+    static thread_local GLenum s_BlendDestination;
+    static thread_local GLuint s_Program;
+    static thread_local GLuint s_VertexArray;
+    static thread_local unsigned int s_ActiveTextureSlot;
+    static thread_local GLenum s_TextureTargets[TEXTURE_SLOTS];
+    static thread_local GLuint s_Textures[TEXTURE_SLOTS];
+    static thread_local GLuint s_StorageBuffers[BUFFER_BASE_SLOTS];
+};
+
+} // namespace Minecraft
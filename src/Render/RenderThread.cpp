@@ -0,0 +1,424 @@
+#include "RenderThread.h"
+#include "FrameConstants.h"
+#include "Shader.h"
+#include "Texture.h"
+#include "TexturePack.h"
+#include "../World/ChunkRenderer.h"
+#include "../World/FarTerrainRenderer.h"
+#include "../utils/Logger.h"
+#include <QThread>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace Minecraft {
+
+RenderThread::RenderThread() = default;
+
+RenderThread::~RenderThread() {
+    Stop();
+}
+
+bool RenderThread::Start(QOpenGLContext* shareContext) {
+    m_Thread.reset(QThread::create([this]() { ThreadMain(); }));
+    if (!m_Context.Create(shareContext, m_Thread.get())) {
+        m_Thread.reset();
+        return false;
+    }
+    m_Thread->start();
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Cv.wait(lock, [this]() { return m_InitFinished; });
+    return m_Initialized;
+}
+
+void RenderThread::Stop() {
+    if (!m_Thread) {
+        return;
+    }
+
+    m_Mailbox.Close();
+    m_Thread->wait();
+    m_Thread.reset();
+}
+
+void RenderThread::ConfigureResolutionScaling(bool enabled, float minScale, float maxScale) {
+    m_ResolutionScaler.Configure(enabled, minScale, maxScale);
+}
+
+void RenderThread::Submit(FramePacket packet) {
+    m_Mailbox.Submit(std::move(packet));
+}
+
+bool RenderThread::AcquireFrame(PresentFrame& frame) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    frame.ready = nullptr;
+    if (m_PublishedTarget >= 0) {
+        m_DisplayedTarget = m_PublishedTarget;
+        m_PublishedTarget = -1;
+        frame.ready = m_Targets[m_DisplayedTarget].renderFence;
+        m_Targets[m_DisplayedTarget].renderFence = nullptr;
+    }
+
+    if (m_DisplayedTarget < 0) {
+        return false;
+    }
+
+    const FrameTarget& target = m_Targets[m_DisplayedTarget];
+    frame.texture = target.colorTexture;
+    frame.width = target.width;
+    frame.height = target.height;
+    return true;
+}
+
+void RenderThread::ReleaseFrame(GLsync readFence) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_DisplayedTarget < 0) {
+        glDeleteSync(readFence);
+        return;
+    }
+
+    // Fences of one context signal in order, so only the newest read matters
+    FrameTarget& target = m_Targets[m_DisplayedTarget];
+    if (target.readFence) {
+        glDeleteSync(target.readFence);
+    }
+    target.readFence = readFence;
+}
+
+RenderThread::FrameInfo RenderThread::GetLastFrameInfo() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_LastFrameInfo;
+}
+
+void RenderThread::ThreadMain() {
+    const bool initialized = m_Context.MakeCurrent() && InitializeResources();
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Initialized = initialized;
+        m_InitFinished = true;
+    }
+    m_Cv.notify_all();
+
+    FramePacket packet;
+    while (initialized && m_Mailbox.Wait(packet)) {
+        RenderPacket(packet);
+    }
+
+    ReleaseResources();
+    m_Context.DoneCurrent();
+    m_Context.ReturnToMainThread();
+}
+
+bool RenderThread::InitializeResources() {
+    // Entry points are per context on some platforms, so resolve them again here
+    glewExperimental = GL_TRUE;
+    if (glewInit() != GLEW_OK) {
+        LOG_ERROR("Failed to initialize GLEW on the render thread");
+        return false;
+    }
+
+    m_Shader = std::make_unique<Shader>();
+    if (!m_Shader->LoadFromFile("Resource/Shader/basic.vert",
+                                "Resource/Shader/basic.frag")) {
+        LOG_ERROR("Failed to load shaders");
+    }
+
+    // Packed faces in shader storage buffers, expanded by the vertex shader (GL 4.3+)
+    if (GLEW_VERSION_4_3) {
+        auto packedShader = std::make_unique<Shader>();
+        if (packedShader->LoadFromFile("Resource/Shader/basic_packed.vert",
+                                       "Resource/Shader/basic.frag")) {
+            m_PackedShader = std::move(packedShader);
+            m_MeshFormat = MeshFormat::PackedFaces;
+            LOG_INFO("Chunk renderer: packed faces (vertex pulling)");
+        } else {
+            LOG_WARNING("Packed face shader unavailable, using vertex buffers");
+        }
+    }
+
+    // Per-frame values come from the FrameConstants buffer; the sampler unit never changes
+    m_ChunkShader = m_PackedShader ? m_PackedShader.get() : m_Shader.get();
+    m_ChunkShader->BindUniformBlock("FrameConstants", FRAME_CONSTANTS_BINDING);
+    m_ChunkShader->Bind();
+    m_ChunkShader->SetInt(m_ChunkShader->GetUniformLocation("uTexture"), 0);
+    m_ChunkShader->Unbind();
+
+    // Load block texture atlas as texture array
+    m_BlockTexture = std::make_unique<Texture>();
+    if (!m_BlockTexture->LoadAsTextureArray(TexturePack::BLOCK_ATLAS_PATH, TexturePack::BLOCK_TILE_SIZE, TexturePack::BLOCK_TILE_SIZE)) {
+        LOG_ERROR("Failed to load block texture atlas");
+    } else {
+        LOG_INFO("Block texture atlas loaded: " +
+                 std::to_string(m_BlockTexture->GetWidth()) + "x" +
+                 std::to_string(m_BlockTexture->GetHeight()));
+    }
+
+    // Sky gradient and sun, drawn behind the terrain so it occludes the sun
+    m_SkyShader = std::make_unique<Shader>();
+    if (m_SkyShader->LoadFromFile("Resource/Shader/sky.vert", "Resource/Shader/sky.frag")) {
+        m_SkyShader->BindUniformBlock("FrameConstants", FRAME_CONSTANTS_BINDING);
+        m_SkyShader->Bind();
+        m_SkyShader->SetInt(m_SkyShader->GetUniformLocation("uSun"), 0);
+        m_SkyShader->Unbind();
+    } else {
+        LOG_ERROR("Failed to load sky shader");
+        m_SkyShader.reset();
+    }
+
+    m_SunTexture = std::make_unique<Texture>();
+    if (!m_SunTexture->LoadFromFile("Resource/Texture/sun.png")) {
+        LOG_WARNING("Failed to load sun texture: Resource/Texture/sun.png");
+    }
+    glGenVertexArrays(1, &m_SkyVAO);
+
+    // Bound once; RenderPacket rewrites the contents every frame
+    glGenBuffers(1, &m_FrameConstantsBuffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, m_FrameConstantsBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameConstants), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_CONSTANTS_BINDING, m_FrameConstantsBuffer);
+
+    glGenQueries(TIMER_QUERY_COUNT, m_TimerQueries.data());
+
+    m_ChunkRenderer = std::make_unique<ChunkRenderer>();
+    m_FarTerrainRenderer = std::make_unique<FarTerrainRenderer>();
+    m_FarTerrainRenderer->Initialize();
+
+    // Texture loading bound objects directly
+    RenderState::Invalidate();
+    LOG_INFO("Render thread started");
+    return true;
+}
+
+void RenderThread::UpdateFrameConstants(const FramePacket& packet) {
+    FrameConstants constants{};
+    constants.viewProjection = packet.viewProjection;
+    constants.inverseViewProjection = glm::inverse(packet.viewProjection);
+    constants.farViewProjection = packet.farViewProjection;
+    constants.cameraPosition = glm::vec4(packet.cameraPosition, 1.0f);
+    constants.skyColor = glm::vec4(packet.skyColor, 1.0f);
+    constants.sunDirection = glm::vec4(packet.sunDirection, 0.0f);
+    constants.globalLight = packet.globalLight;
+    constants.time = packet.time;
+
+    // Orphan the previous contents so the driver never waits on last frame's draws
+    glBindBuffer(GL_UNIFORM_BUFFER, m_FrameConstantsBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameConstants), nullptr, GL_DYNAMIC_DRAW);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameConstants), &constants);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void RenderThread::RenderSky() {
+    if (!m_SkyShader) {
+        return;
+    }
+
+    RenderState::SetEnabled(GL_DEPTH_TEST, false);
+    RenderState::SetDepthMask(false);
+    RenderState::SetEnabled(GL_CULL_FACE, false);
+
+    m_SkyShader->Bind();
+    m_SunTexture->Bind(0);
+    RenderState::BindVertexArray(m_SkyVAO);
+    RenderState::DrawArrays(GL_TRIANGLES, 0, 3);
+
+    RenderState::SetEnabled(GL_CULL_FACE, true);
+    RenderState::SetDepthMask(true);
+    RenderState::SetEnabled(GL_DEPTH_TEST, true);
+}
+
+void RenderThread::ReleaseResources() {
+    m_FarTerrainRenderer.reset();
+    m_ChunkRenderer.reset();
+    glDeleteQueries(TIMER_QUERY_COUNT, m_TimerQueries.data());
+    m_TimerQueries.fill(0);
+    m_TimerQueriesPending = 0;
+    RenderState::DeleteVertexArray(m_SkyVAO);
+    RenderState::DeleteBuffer(m_FrameConstantsBuffer);
+    m_FrameConstantsBuffer = 0;
+    m_SunTexture.reset();
+    m_SkyShader.reset();
+    m_BlockTexture.reset();
+    m_ChunkShader = nullptr;
+    m_PackedShader.reset();
+    m_Shader.reset();
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (FrameTarget& target : m_Targets) {
+        if (target.framebuffer) glDeleteFramebuffers(1, &target.framebuffer);
+        RenderState::DeleteTexture(target.colorTexture);
+        if (target.depthBuffer) glDeleteRenderbuffers(1, &target.depthBuffer);
+        if (target.renderFence) glDeleteSync(target.renderFence);
+        if (target.readFence) glDeleteSync(target.readFence);
+        target = FrameTarget();
+    }
+    m_PublishedTarget = -1;
+    m_DisplayedTarget = -1;
+}
+
+void RenderThread::RenderPacket(FramePacket& packet) {
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    RenderState::BeginFrame();
+
+    for (RenderCommand& command : packet.commands) {
+        if (command.type == RenderCommandType::UploadFarTile || command.type == RenderCommandType::ReleaseFarTile) {
+            m_FarTerrainRenderer->Execute(command);
+        } else {
+            m_ChunkRenderer->Execute(command);
+        }
+    }
+
+    GLsync readFence = nullptr;
+    const int targetIndex = AcquireTarget(readFence);
+    FrameTarget& target = m_Targets[targetIndex];
+    if (readFence) {
+        glWaitSync(readFence, 0, GL_TIMEOUT_IGNORED);
+        glDeleteSync(readFence);
+    }
+    // Only the world is scaled; the GUI thread stretches it to the window under a native-size HUD
+    CollectGpuTime(packet.targetFrameMs);
+    const float scale = m_ResolutionScaler.GetScale();
+    EnsureTarget(target,
+                 static_cast<int>(std::lround(packet.width * scale)),
+                 static_cast<int>(std::lround(packet.height * scale)));
+
+    glBeginQuery(GL_TIME_ELAPSED, m_TimerQueries[m_TimerQueryHead]);
+    glBindFramebuffer(GL_FRAMEBUFFER, target.framebuffer);
+    glViewport(0, 0, target.width, target.height);
+
+    RenderState::SetEnabled(GL_DEPTH_TEST, true);
+    RenderState::SetDepthFunc(GL_LEQUAL);
+    RenderState::SetEnabled(GL_CULL_FACE, true);
+    RenderState::SetCullFace(GL_BACK);
+    RenderState::SetEnabled(GL_BLEND, false);
+    RenderState::SetDepthMask(true);
+
+    glClearColor(packet.skyColor.r, packet.skyColor.g, packet.skyColor.b, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    UpdateFrameConstants(packet);
+    RenderSky();
+
+    // The horizon has its own depth range. The camera is inside the voxel area, so chunks
+    // are always nearer than any far tile and can simply be drawn over it
+    if (!packet.farTiles.empty()) {
+        m_FarTerrainRenderer->Render(packet);
+        glClear(GL_DEPTH_BUFFER_BIT);
+    }
+
+    m_ChunkShader->Bind();
+    m_BlockTexture->Bind(0);
+
+    m_ChunkRenderer->RenderOpaque(packet.opaqueChunks, packet.regionBatching);
+
+    // Translucent blocks: blended, no depth writes, both sides visible (water seen from below)
+    RenderState::SetEnabled(GL_BLEND, true);
+    RenderState::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    RenderState::SetDepthMask(false);
+    RenderState::SetEnabled(GL_CULL_FACE, false);
+    m_ChunkRenderer->RenderTransparent(packet.transparentChunks);
+    RenderState::SetEnabled(GL_CULL_FACE, true);
+    RenderState::SetDepthMask(true);
+    RenderState::SetEnabled(GL_BLEND, false);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glEndQuery(GL_TIME_ELAPSED);
+    m_TimerQueryHead = (m_TimerQueryHead + 1) % TIMER_QUERY_COUNT;
+    m_TimerQueriesPending = std::min(m_TimerQueriesPending + 1, TIMER_QUERY_COUNT);
+
+    // Flush so the fence reaches the GPU before the GUI context waits on it
+    GLsync renderFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();
+
+    FrameInfo info;
+    info.stats = RenderState::GetFrameStats();
+    info.regionBatches = m_ChunkRenderer->GetRegionBatchCount();
+    info.batchedChunks = m_ChunkRenderer->GetBatchedChunkCount();
+    info.chunkMeshes = m_ChunkRenderer->GetMeshCount();
+    info.farTiles = m_FarTerrainRenderer->GetTileCount();
+    info.cpuMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+    info.gpuMs = m_ResolutionScaler.GetSmoothedMs();
+    info.resolutionScale = scale;
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_PublishedTarget >= 0) {
+        // The GUI never picked the previous frame up; it is superseded
+        FrameTarget& stale = m_Targets[m_PublishedTarget];
+        if (stale.renderFence) {
+            glDeleteSync(stale.renderFence);
+            stale.renderFence = nullptr;
+        }
+    }
+    target.renderFence = renderFence;
+    m_PublishedTarget = targetIndex;
+    m_LastFrameInfo = info;
+}
+
+void RenderThread::CollectGpuTime(float targetMs) {
+    // Read finished queries oldest first without stalling on ones still in flight
+    while (m_TimerQueriesPending > 0) {
+        const int oldest = (m_TimerQueryHead - m_TimerQueriesPending + TIMER_QUERY_COUNT) % TIMER_QUERY_COUNT;
+        GLint available = 0;
+        glGetQueryObjectiv(m_TimerQueries[oldest], GL_QUERY_RESULT_AVAILABLE, &available);
+        // All slots in use: the next begin would reuse this query, so wait for it
+        if (!available && m_TimerQueriesPending < TIMER_QUERY_COUNT) {
+            break;
+        }
+
+        GLuint64 elapsedNs = 0;
+        glGetQueryObjectui64v(m_TimerQueries[oldest], GL_QUERY_RESULT, &elapsedNs);
+        --m_TimerQueriesPending;
+        m_ResolutionScaler.AddSample(static_cast<float>(elapsedNs) / 1.0e6f, targetMs);
+    }
+}
+
+int RenderThread::AcquireTarget(GLsync& readFence) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (int i = 0; i < TARGET_COUNT; ++i) {
+        if (i != m_PublishedTarget && i != m_DisplayedTarget) {
+            readFence = m_Targets[i].readFence;
+            m_Targets[i].readFence = nullptr;
+            return i;
+        }
+    }
+    return 0;  // Unreachable: at most two targets are held by the GUI side
+}
+
+void RenderThread::EnsureTarget(FrameTarget& target, int width, int height) {
+    width = std::max(width, 1);
+    height = std::max(height, 1);
+
+    if (target.framebuffer == 0) {
+        glGenFramebuffers(1, &target.framebuffer);
+        glGenTextures(1, &target.colorTexture);
+        glGenRenderbuffers(1, &target.depthBuffer);
+    }
+
+    if (target.width == width && target.height == height) {
+        return;
+    }
+    target.width = width;
+    target.height = height;
+
+    RenderState::BindTexture(0, GL_TEXTURE_2D, target.colorTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glBindRenderbuffer(GL_RENDERBUFFER, target.depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, target.framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target.colorTexture, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, target.depthBuffer);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        LOG_ERROR("Render target framebuffer incomplete (" + std::to_string(width) + "x" + std::to_string(height) + ")");
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+} // namespace Minecraft
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "FramePacket.h"
+#include "FramePacketMailbox.h"
+#include "RenderContext.h"
+#include "RenderState.h"
+#include "ResolutionScaler.h"
+#include <GL/glew.h>
+#include <array>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+class QOpenGLContext;
+class QThread;
+
+namespace Minecraft {
+
+class ChunkRenderer;
+class FarTerrainRenderer;
+class Shader;
+class Texture;
+
+// Renders the world on its own thread with a GL context shared with the widget.
+// The simulation submits FramePackets; each packet's commands are applied and the
+// frame is drawn into an offscreen colour texture, which the GUI thread composites.
+// Three targets rotate so the render thread never waits for the GUI to finish
+// sampling; sync objects order the hand-offs between the two contexts.
+class RenderThread {
+public:
+    struct FrameInfo {
+        RenderStats stats;
+        int regionBatches = 0;
+        int batchedChunks = 0;
+        size_t chunkMeshes = 0;
+        size_t farTiles = 0;
+        float cpuMs = 0.0f;  // Command execution and draw submission
+        float gpuMs = 0.0f;  // Smoothed, from timer queries a few frames old
+        float resolutionScale = 1.0f;
+    };
+
+    // A finished frame handed to the GUI thread
+    struct PresentFrame {
+        GLuint texture = 0;
+        int width = 0;
+        int height = 0;
+        GLsync ready = nullptr;  // Caller waits on (glWaitSync) and deletes it; null if already waited
+    };
+
+    RenderThread();
+    ~RenderThread();
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    // Create a context sharing with `shareContext` and start the thread. Call on the GUI
+    // thread; blocks until the thread has loaded its resources and returns false on failure.
+    bool Start(QOpenGLContext* shareContext);
+    void Stop();
+
+    // Bounds for the dynamic render resolution; call before Start
+    void ConfigureResolutionScaling(bool enabled, float minScale, float maxScale);
+
+    // Mesh layout the render thread can draw, valid after Start
+    MeshFormat GetMeshFormat() const { return m_MeshFormat; }
+
+    // Queue a packet; a packet the thread has not picked up yet is replaced,
+    // but its commands run first so no upload or release is lost
+    void Submit(FramePacket packet);
+
+    // GUI thread: the newest finished frame, or the one already on screen if none is newer
+    bool AcquireFrame(PresentFrame& frame);
+
+    // GUI thread: fence placed after sampling the acquired frame
+    void ReleaseFrame(GLsync readFence);
+
+    FrameInfo GetLastFrameInfo() const;
+
+private:
+    static constexpr int TARGET_COUNT = 3;
+    static constexpr int TIMER_QUERY_COUNT = 4;  // Results are read this many frames late
+
+    struct FrameTarget {
+        GLuint framebuffer = 0;   // Render context only, FBOs are not shared
+        GLuint colorTexture = 0;
+        GLuint depthBuffer = 0;
+        int width = 0;
+        int height = 0;
+        GLsync renderFence = nullptr;  // Frame finished on the GPU
+        GLsync readFence = nullptr;    // GUI finished sampling it
+    };
+
+    void ThreadMain();
+    bool InitializeResources();
+    void ReleaseResources();
+    void RenderPacket(FramePacket& packet);
+    void UpdateFrameConstants(const FramePacket& packet);
+    void RenderSky();
+    void CollectGpuTime(float targetMs);
+    int AcquireTarget(GLsync& readFence);
+    void EnsureTarget(FrameTarget& target, int width, int height);
+
+    RenderContext m_Context;
+    std::unique_ptr<QThread> m_Thread;
+
+    // Render thread resources
+    std::unique_ptr<Shader> m_Shader;
+    std::unique_ptr<Shader> m_PackedShader;
+    Shader* m_ChunkShader = nullptr;
+    GLuint m_FrameConstantsBuffer = 0;  // FrameConstants UBO shared by the world shaders
+    std::unique_ptr<Texture> m_BlockTexture;
+    std::unique_ptr<Shader> m_SkyShader;
+    std::unique_ptr<Texture> m_SunTexture;
+    GLuint m_SkyVAO = 0;
+
+    // GPU time of the world passes drives the render resolution
+    ResolutionScaler m_ResolutionScaler;
+    std::array<GLuint, TIMER_QUERY_COUNT> m_TimerQueries{};
+    int m_TimerQueryHead = 0;     // Next query to issue
+    int m_TimerQueriesPending = 0;
+    std::unique_ptr<ChunkRenderer> m_ChunkRenderer;
+    std::unique_ptr<FarTerrainRenderer> m_FarTerrainRenderer;
+    MeshFormat m_MeshFormat = MeshFormat::Vertices;
+
+    // Shared with the GUI thread, guarded by m_Mutex
+    std::array<FrameTarget, TARGET_COUNT> m_Targets;
+    int m_PublishedTarget = -1;  // Newest finished frame not yet acquired
+    int m_DisplayedTarget = -1;  // Frame the GUI is compositing
+    FrameInfo m_LastFrameInfo;
+    bool m_InitFinished = false;
+    bool m_Initialized = false;
+    mutable std::mutex m_Mutex;
+    std::condition_variable m_Cv;
+
+    FramePacketMailbox m_Mailbox;
+};
+
+} // namespace Minecraft
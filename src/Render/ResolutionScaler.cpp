@@ -0,0 +1,53 @@
+#include "ResolutionScaler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Minecraft {
+
+void ResolutionScaler::Configure(bool enabled, float minScale, float maxScale) {
+    m_Enabled = enabled;
+    m_MinScale = std::clamp(std::min(minScale, maxScale), 0.25f, 1.0f);
+    m_MaxScale = std::clamp(std::max(minScale, maxScale), m_MinScale, 2.0f);
+    m_Scale = m_Enabled ? m_MaxScale : 1.0f;
+    m_SamplesSinceChange = 0;
+    m_HasSample = false;
+}
+
+void ResolutionScaler::AddSample(float gpuMs, float targetMs) {
+    if (!m_Enabled || gpuMs <= 0.0f || targetMs <= 0.0f) {
+        return;
+    }
+
+    m_SmoothedMs = m_HasSample ? m_SmoothedMs + (gpuMs - m_SmoothedMs) * SMOOTHING : gpuMs;
+    m_HasSample = true;
+
+    if (++m_SamplesSinceChange < SETTLE_FRAMES) {
+        return;
+    }
+
+    float desired = m_Scale;
+    if (m_SmoothedMs > targetMs * HIGH_WATER) {
+        // Aim for the middle of the band
+        const float goal = targetMs * (HIGH_WATER + LOW_WATER) * 0.5f;
+        desired = std::min(m_Scale * std::sqrt(goal / m_SmoothedMs), m_Scale - STEP);
+    } else if (m_SmoothedMs < targetMs * LOW_WATER) {
+        // Grow one step at a time; overshooting costs a visible hitch
+        desired = m_Scale + STEP;
+    }
+
+    const float next = Quantize(std::clamp(desired, m_MinScale, m_MaxScale));
+    if (next != m_Scale) {
+        // Expect the new cost to follow the pixel count until real samples arrive
+        m_SmoothedMs *= (next * next) / (m_Scale * m_Scale);
+        m_Scale = next;
+        m_SamplesSinceChange = 0;
+    }
+}
+
+float ResolutionScaler::Quantize(float scale) const {
+    const float quantized = std::round(scale / STEP) * STEP;
+    return std::clamp(quantized, m_MinScale, m_MaxScale);
+}
+
+} // namespace Minecraft
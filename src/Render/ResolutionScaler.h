@@ -0,0 +1,37 @@
+#pragma once
+
+namespace Minecraft {
+
+// Picks the render resolution scale from measured GPU frame times. Cost scales
+// with pixel count, so the scale moves by the square root of the time ratio.
+// Changes are quantized and spaced out so render targets are not reallocated
+// every frame and the smoothed time can settle after each step.
+class ResolutionScaler {
+public:
+    static constexpr float STEP = 0.05f;          // Scale granularity
+    static constexpr int SETTLE_FRAMES = 20;      // Samples between adjustments
+    static constexpr float SMOOTHING = 0.1f;      // Weight of a new sample
+    static constexpr float HIGH_WATER = 0.9f;     // Scale down above this share of the budget
+    static constexpr float LOW_WATER = 0.7f;      // Scale up below it
+
+    void Configure(bool enabled, float minScale, float maxScale);
+
+    // Feed one frame's GPU time against the frame budget, both in milliseconds
+    void AddSample(float gpuMs, float targetMs);
+
+    float GetScale() const { return m_Scale; }
+    float GetSmoothedMs() const { return m_SmoothedMs; }
+
+private:
+    float Quantize(float scale) const;
+
+    bool m_Enabled = true;
+    float m_MinScale = 0.5f;
+    float m_MaxScale = 1.0f;
+    float m_Scale = 1.0f;
+    float m_SmoothedMs = 0.0f;
+    int m_SamplesSinceChange = 0;
+    bool m_HasSample = false;
+};
+
+} // namespace Minecraft
@@ -1,15 +1,70 @@
 #include "Shader.h"
-#include "../Utils/Logger.h"
+#include "RenderState.h"
+#include "../utils/Logger.h"
+#include <cstring>
+#include <filesystem>
 #include <fstream>
 #include <sstream>
+#include <vector>
 #include <glm/gtc/type_ptr.hpp>
 
 namespace Minecraft {
 
-Shader::~Shader() {
-    if (m_ProgramID) {
-        glDeleteProgram(m_ProgramID);
+namespace {
+
+constexpr char CACHE_MAGIC[4] = {'M', 'C', 'S', 'B'};
+constexpr uint32_t CACHE_VERSION = 1;
+
+struct ProgramCacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t key;       // Sources and driver the binary was built from
+    uint32_t format;    // Driver-specific binary format
+    uint32_t length;
+};
+
+// Program binaries are core in GL 4.1 and common as an extension on 3.3 drivers
+bool IsProgramBinarySupported() {
+    if (!GLEW_ARB_get_program_binary && !GLEW_VERSION_4_1) {
+        return false;
+    }
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+}
+
+void HashBytes(uint64_t& hash, const char* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ull;  // FNV-1a
     }
+    hash ^= 0xff;  // Separator, so "ab"+"c" and "a"+"bc" differ
+    hash *= 1099511628211ull;
+}
+
+// A driver update can change the binary format without changing the format enum
+uint64_t HashProgram(const std::string& vertexSource, const std::string& fragmentSource) {
+    uint64_t hash = 14695981039346656037ull;
+    HashBytes(hash, vertexSource.data(), vertexSource.size());
+    HashBytes(hash, fragmentSource.data(), fragmentSource.size());
+    for (GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+        const char* value = reinterpret_cast<const char*>(glGetString(name));
+        const std::string text = value ? value : "";
+        HashBytes(hash, text.data(), text.size());
+    }
+    return hash;
+}
+
+std::string GetCachePath(const std::string& vertexPath, const std::string& fragmentPath) {
+    const std::string name = std::filesystem::path(vertexPath).filename().string() + "+" +
+                             std::filesystem::path(fragmentPath).filename().string() + ".bin";
+    return (std::filesystem::path(Shader::BINARY_CACHE_DIRECTORY) / name).string();
+}
+
+} // namespace
+
+Shader::~Shader() {
+    RenderState::DeleteProgram(m_ProgramID);
 }
 
 bool Shader::LoadFromFile(const std::string& vertexPath, const std::string& fragmentPath) {
@@ -25,8 +80,25 @@ bool Shader::LoadFromFile(const std::string& vertexPath, const std::string& frag
     vStream << vFile.rdbuf();
     fStream << fFile.rdbuf();
     
+    const std::string vertexSource = vStream.str();
+    const std::string fragmentSource = fStream.str();
+    const bool binaryCache = IsProgramBinarySupported();
+    const uint64_t key = binaryCache ? HashProgram(vertexSource, fragmentSource) : 0;
+    const std::string cachePath = GetCachePath(vertexPath, fragmentPath);
+
+    if (binaryCache && LoadCachedBinary(cachePath, key)) {
+        LOG_INFO("Loaded shaders from binary cache: " + vertexPath + ", " + fragmentPath);
+        return true;
+    }
+
     LOG_INFO("Loading shaders: " + vertexPath + ", " + fragmentPath);
-    return LoadFromSource(vStream.str(), fStream.str());
+    if (!LoadFromSource(vertexSource, fragmentSource)) {
+        return false;
+    }
+    if (binaryCache) {
+        SaveCachedBinary(cachePath, key);
+    }
+    return true;
 }
 
 bool Shader::LoadFromSource(const std::string& vertexSource, const std::string& fragmentSource) {
@@ -38,6 +110,9 @@ bool Shader::LoadFromSource(const std::string& vertexSource, const std::string&
     }
     
     m_ProgramID = glCreateProgram();
+    if (IsProgramBinarySupported()) {
+        glProgramParameteri(m_ProgramID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
     glAttachShader(m_ProgramID, vertexShader);
     glAttachShader(m_ProgramID, fragmentShader);
     glLinkProgram(m_ProgramID);
@@ -58,6 +133,73 @@ bool Shader::LoadFromSource(const std::string& vertexSource, const std::string&
     return true;
 }
 
+bool Shader::LoadCachedBinary(const std::string& cachePath, uint64_t key) {
+    std::ifstream file(cachePath, std::ios::binary);
+    ProgramCacheHeader header{};
+    if (!file || !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+        header.version != CACHE_VERSION || header.key != key || header.length == 0) {
+        return false;
+    }
+
+    std::vector<char> binary(header.length);
+    if (!file.read(binary.data(), static_cast<std::streamsize>(binary.size()))) {
+        return false;
+    }
+
+    // The driver may still reject a binary it considers stale; fall back to source then
+    const GLuint program = glCreateProgram();
+    glProgramBinary(program, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+    GLint success = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        glDeleteProgram(program);
+        LOG_WARNING("Driver rejected cached shader binary: " + cachePath);
+        return false;
+    }
+
+    m_ProgramID = program;
+    m_UniformLocationCache.clear();
+    return true;
+}
+
+void Shader::SaveCachedBinary(const std::string& cachePath, uint64_t key) const {
+    GLint length = 0;
+    glGetProgramiv(m_ProgramID, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+
+    std::vector<char> binary(static_cast<size_t>(length));
+    GLenum format = 0;
+    glGetProgramBinary(m_ProgramID, length, nullptr, &format, binary.data());
+
+    ProgramCacheHeader header{};
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.key = key;
+    header.format = format;
+    header.length = static_cast<uint32_t>(length);
+
+    // Write to a temporary name; the GUI and render threads load shaders concurrently
+    std::error_code error;
+    std::filesystem::create_directories(BINARY_CACHE_DIRECTORY, error);
+    const std::string tempPath = cachePath + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(binary.data(), static_cast<std::streamsize>(binary.size()));
+        if (!file) {
+            LOG_WARNING("Failed to write shader cache: " + tempPath);
+            return;
+        }
+    }
+    std::filesystem::rename(tempPath, cachePath, error);
+    if (error) {
+        LOG_WARNING("Failed to store shader cache " + cachePath + ": " + error.message());
+    }
+}
+
 GLuint Shader::CompileShader(GLenum type, const std::string& source) {
     GLuint shader = glCreateShader(type);
     const char* src = source.c_str();
@@ -78,16 +220,17 @@ GLuint Shader::CompileShader(GLenum type, const std::string& source) {
 }
 
 void Shader::Bind() const {
-    glUseProgram(m_ProgramID);
+    RenderState::UseProgram(m_ProgramID);
 }
 
 void Shader::Unbind() const {
-    glUseProgram(0);
+    RenderState::UseProgram(0);
 }
 
 GLint Shader::GetUniformLocation(const std::string& name) {
-    if (m_UniformLocationCache.find(name) != m_UniformLocationCache.end()) {
-        return m_UniformLocationCache[name];
+    auto it = m_UniformLocationCache.find(name);
+    if (it != m_UniformLocationCache.end()) {
+        return it->second;
     }
     
     GLint location = glGetUniformLocation(m_ProgramID, name.c_str());
@@ -95,28 +238,65 @@ GLint Shader::GetUniformLocation(const std::string& name) {
     return location;
 }
 
+void Shader::BindUniformBlock(const std::string& name, GLuint bindingPoint) {
+    const GLuint index = glGetUniformBlockIndex(m_ProgramID, name.c_str());
+    if (index != GL_INVALID_INDEX) {
+        glUniformBlockBinding(m_ProgramID, index, bindingPoint);
+    }
+}
+
 void Shader::SetInt(const std::string& name, int value) {
-    glUniform1i(GetUniformLocation(name), value);
+    SetInt(GetUniformLocation(name), value);
+}
+
+void Shader::SetInt(GLint location, int value) {
+    glUniform1i(location, value);
+    RenderState::CountCall();
 }
 
 void Shader::SetFloat(const std::string& name, float value) {
-    glUniform1f(GetUniformLocation(name), value);
+    SetFloat(GetUniformLocation(name), value);
+}
+
+void Shader::SetFloat(GLint location, float value) {
+    glUniform1f(location, value);
+    RenderState::CountCall();
 }
 
 void Shader::SetVec2(const std::string& name, const glm::vec2& value) {
-    glUniform2fv(GetUniformLocation(name), 1, glm::value_ptr(value));
+    SetVec2(GetUniformLocation(name), value);
+}
+
+void Shader::SetVec2(GLint location, const glm::vec2& value) {
+    glUniform2fv(location, 1, glm::value_ptr(value));
+    RenderState::CountCall();
 }
 
 void Shader::SetVec3(const std::string& name, const glm::vec3& value) {
-    glUniform3fv(GetUniformLocation(name), 1, glm::value_ptr(value));
+    SetVec3(GetUniformLocation(name), value);
+}
+
+void Shader::SetVec3(GLint location, const glm::vec3& value) {
+    glUniform3fv(location, 1, glm::value_ptr(value));
+    RenderState::CountCall();
 }
 
 void Shader::SetVec4(const std::string& name, const glm::vec4& value) {
-    glUniform4fv(GetUniformLocation(name), 1, glm::value_ptr(value));
+    SetVec4(GetUniformLocation(name), value);
+}
+
+void Shader::SetVec4(GLint location, const glm::vec4& value) {
+    glUniform4fv(location, 1, glm::value_ptr(value));
+    RenderState::CountCall();
 }
 
 void Shader::SetMat4(const std::string& name, const glm::mat4& value) {
-    glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, glm::value_ptr(value));
+    SetMat4(GetUniformLocation(name), value);
+}
+
+void Shader::SetMat4(GLint location, const glm::mat4& value) {
+    glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+    RenderState::CountCall();
 }
 
 } // namespace Minecraft
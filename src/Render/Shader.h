@@ -2,13 +2,19 @@
 
 #include <GL/glew.h>
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 
 namespace Minecraft {
 
+// GLSL program. Programs loaded from files are cached on disk as driver binaries
+// (when the driver supports program binaries) and relinked from source only when a
+// source file or the driver changes.
 class Shader {
 public:
+    static constexpr const char* BINARY_CACHE_DIRECTORY = "ShaderCache";
+
     Shader() = default;
     ~Shader();
     
@@ -18,6 +24,12 @@ public:
     void Bind() const;
     void Unbind() const;
     
+    // Resolve a uniform once; the handle overloads below skip the name lookup on hot paths
+    GLint GetUniformLocation(const std::string& name);
+
+    // Attach the named uniform block to a buffer binding point; no-op if the program lacks it
+    void BindUniformBlock(const std::string& name, GLuint bindingPoint);
+
     // Uniform setters
     void SetInt(const std::string& name, int value);
     void SetFloat(const std::string& name, float value);
@@ -25,12 +37,20 @@ public:
     void SetVec3(const std::string& name, const glm::vec3& value);
     void SetVec4(const std::string& name, const glm::vec4& value);
     void SetMat4(const std::string& name, const glm::mat4& value);
+
+    void SetInt(GLint location, int value);
+    void SetFloat(GLint location, float value);
+    void SetVec2(GLint location, const glm::vec2& value);
+    void SetVec3(GLint location, const glm::vec3& value);
+    void SetVec4(GLint location, const glm::vec4& value);
+    void SetMat4(GLint location, const glm::mat4& value);
     
     GLuint GetProgramID() const { return m_ProgramID; }
 
 private:
     GLuint CompileShader(GLenum type, const std::string& source);
-    GLint GetUniformLocation(const std::string& name);
+    bool LoadCachedBinary(const std::string& cachePath, uint64_t key);
+    void SaveCachedBinary(const std::string& cachePath, uint64_t key) const;
     
     GLuint m_ProgramID = 0;
     std::unordered_map<std::string, GLint> m_UniformLocationCache;
@@ -1,17 +1,29 @@
 #include "Texture.h"
-#include "../Utils/Logger.h"
+#include "RenderState.h"
+#include "TexturePack.h"
+#include "../utils/Logger.h"
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
+#include <algorithm>
+#include <chrono>
 
 namespace Minecraft {
 
 Texture::~Texture() {
-    if (m_TextureID) {
-        glDeleteTextures(1, &m_TextureID);
-    }
+    RenderState::DeleteTexture(m_TextureID);
 }
 
 bool Texture::LoadAsTextureArray(const std::string& path, int tileWidth, int tileHeight) {
+    TexturePack pack;
+    if (pack.Open(TexturePack::GetPackPath(path), path)) {
+        if (pack.GetTileWidth() == tileWidth && pack.GetTileHeight() == tileHeight) {
+            return LoadFromPack(pack);
+        }
+        LOG_WARNING("Texture pack for " + path + " has a different tile size, cook it again");
+    } else {
+        LOG_INFO("No usable texture pack for " + path + ", run with --cook-textures to create one");
+    }
+
     stbi_set_flip_vertically_on_load(false);
     
     unsigned char* data = stbi_load(path.c_str(), &m_Width, &m_Height, &m_Channels, 4);  // 强制RGBA
@@ -84,6 +96,42 @@ bool Texture::LoadAsTextureArray(const std::string& path, int tileWidth, int til
     return true;
 }
 
+bool Texture::LoadFromPack(const TexturePack& pack) {
+    const auto start = std::chrono::steady_clock::now();
+    const int layers = pack.GetLayerCount();
+    const int levels = pack.GetLevelCount();
+
+    m_Target = GL_TEXTURE_2D_ARRAY;
+    m_Width = pack.GetAtlasWidth();
+    m_Height = pack.GetAtlasHeight();
+    m_Channels = 4;
+    glGenTextures(1, &m_TextureID);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_TextureID);
+
+    // Every layer of a level is contiguous in the mapped file, so one call per level
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for (int level = 0; level < levels; ++level) {
+        const int width = std::max(pack.GetTileWidth() >> level, 1);
+        const int height = std::max(pack.GetTileHeight() >> level, 1);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, level, GL_RGBA, width, height, layers, 0,
+                     GL_RGBA, GL_UNSIGNED_BYTE, pack.GetLevelData(level));
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, levels - 1);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LOD, 4);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    const float ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    LOG_INFO("Texture array loaded from pack: " + std::to_string(layers) + " layers, " +
+             std::to_string(levels) + " mip levels in " + std::to_string(ms) + " ms");
+    return true;
+}
+
 bool Texture::LoadFromFile(const std::string& path, bool generateMipmaps) {
     stbi_set_flip_vertically_on_load(true);
     
@@ -124,8 +172,7 @@ bool Texture::LoadFromFile(const std::string& path, bool generateMipmaps) {
 }
 
 void Texture::Bind(unsigned int slot) const {
-    glActiveTexture(GL_TEXTURE0 + slot);
-    glBindTexture(m_Target, m_TextureID);
+    RenderState::BindTexture(slot, m_Target, m_TextureID);
 }
 
 void Texture::Unbind() const {
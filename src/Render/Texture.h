@@ -5,13 +5,17 @@
 
 namespace Minecraft {
 
+class TexturePack;
+
 class Texture {
 public:
     Texture() = default;
     ~Texture();
     
     bool LoadFromFile(const std::string& path, bool generateMipmaps = true);
+    // Uses the cooked pack next to `path` when it is current, else decodes the image
     bool LoadAsTextureArray(const std::string& path, int tileWidth = 16, int tileHeight = 16);
+    bool LoadFromPack(const TexturePack& pack);
     
     void Bind(unsigned int slot = 0) const;
     void Unbind() const;
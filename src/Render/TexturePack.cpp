@@ -0,0 +1,283 @@
+#include "TexturePack.h"
+#include "../utils/Logger.h"
+#include "stb_image.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Minecraft {
+
+struct TexturePack::Header {
+    char magic[4];
+    uint32_t version;
+    uint32_t tileWidth;
+    uint32_t tileHeight;
+    uint32_t layers;
+    uint32_t levels;
+    uint32_t atlasWidth;
+    uint32_t atlasHeight;
+    uint64_t sourceSize;   // Image the pack was cooked from, to spot stale packs
+    int64_t sourceTime;
+    uint64_t levelOffsets[MAX_LEVELS];  // From the start of the file
+};
+
+namespace {
+
+constexpr char PACK_MAGIC[4] = {'M', 'C', 'T', 'P'};
+
+uint64_t GetLevelSize(uint32_t tileWidth, uint32_t tileHeight, uint32_t layers, int level) {
+    const uint64_t width = std::max(tileWidth >> level, 1u);
+    const uint64_t height = std::max(tileHeight >> level, 1u);
+    return width * height * layers * 4;
+}
+
+bool GetSourceStamp(const std::string& path, uint64_t& size, int64_t& time) {
+    std::error_code error;
+    size = static_cast<uint64_t>(std::filesystem::file_size(path, error));
+    if (error) {
+        return false;
+    }
+    time = static_cast<int64_t>(std::filesystem::last_write_time(path, error).time_since_epoch().count());
+    return !error;
+}
+
+// 2x2 box filter of every layer, as glGenerateMipmap does
+std::vector<unsigned char> Downsample(const std::vector<unsigned char>& source, int width, int height, int layers) {
+    const int dstWidth = std::max(width / 2, 1);
+    const int dstHeight = std::max(height / 2, 1);
+    std::vector<unsigned char> result(static_cast<size_t>(dstWidth) * dstHeight * layers * 4);
+
+    for (int layer = 0; layer < layers; ++layer) {
+        const unsigned char* src = source.data() + static_cast<size_t>(layer) * width * height * 4;
+        unsigned char* dst = result.data() + static_cast<size_t>(layer) * dstWidth * dstHeight * 4;
+        for (int y = 0; y < dstHeight; ++y) {
+            for (int x = 0; x < dstWidth; ++x) {
+                const int x0 = std::min(x * 2, width - 1), x1 = std::min(x * 2 + 1, width - 1);
+                const int y0 = std::min(y * 2, height - 1), y1 = std::min(y * 2 + 1, height - 1);
+                for (int c = 0; c < 4; ++c) {
+                    const int sum = src[(y0 * width + x0) * 4 + c] + src[(y0 * width + x1) * 4 + c] +
+                                    src[(y1 * width + x0) * 4 + c] + src[(y1 * width + x1) * 4 + c];
+                    dst[(y * dstWidth + x) * 4 + c] = static_cast<unsigned char>((sum + 2) / 4);
+                }
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+TexturePack::~TexturePack() {
+    Close();
+}
+
+std::string TexturePack::GetPackPath(const std::string& imagePath) {
+    return std::filesystem::path(imagePath).replace_extension(".pack").string();
+}
+
+bool TexturePack::Cook(const std::string& imagePath, const std::string& packPath, int tileWidth, int tileHeight) {
+    int width = 0, height = 0, channels = 0;
+    stbi_set_flip_vertically_on_load(false);
+    unsigned char* image = stbi_load(imagePath.c_str(), &width, &height, &channels, 4);
+    if (!image) {
+        LOG_ERROR("Failed to load texture: " + imagePath);
+        return false;
+    }
+
+    const int tilesX = width / tileWidth;
+    const int tilesY = height / tileHeight;
+    const int layers = tilesX * tilesY;
+
+    // Level 0: tiles in row-major atlas order, each one contiguous
+    std::vector<unsigned char> level(static_cast<size_t>(tileWidth) * tileHeight * layers * 4);
+    for (int layer = 0; layer < layers; ++layer) {
+        const int tileX = layer % tilesX;
+        const int tileY = layer / tilesX;
+        for (int y = 0; y < tileHeight; ++y) {
+            const unsigned char* src = image + ((tileY * tileHeight + y) * width + tileX * tileWidth) * 4;
+            unsigned char* dst = level.data() + (static_cast<size_t>(layer) * tileHeight + y) * tileWidth * 4;
+            std::memcpy(dst, src, static_cast<size_t>(tileWidth) * 4);
+        }
+    }
+    stbi_image_free(image);
+
+    Header header{};
+    std::memcpy(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC));
+    header.version = VERSION;
+    header.tileWidth = static_cast<uint32_t>(tileWidth);
+    header.tileHeight = static_cast<uint32_t>(tileHeight);
+    header.layers = static_cast<uint32_t>(layers);
+    header.atlasWidth = static_cast<uint32_t>(width);
+    header.atlasHeight = static_cast<uint32_t>(height);
+    if (!GetSourceStamp(imagePath, header.sourceSize, header.sourceTime)) {
+        LOG_ERROR("Failed to stat texture: " + imagePath);
+        return false;
+    }
+
+    // Write to a temporary name so a running game never maps a half-written pack
+    const std::string tempPath = packPath + ".tmp";
+    std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        LOG_ERROR("Failed to create texture pack: " + tempPath);
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    uint64_t offset = sizeof(header);
+    int levelWidth = tileWidth;
+    int levelHeight = tileHeight;
+    while (true) {
+        header.levelOffsets[header.levels++] = offset;
+        file.write(reinterpret_cast<const char*>(level.data()), static_cast<std::streamsize>(level.size()));
+        offset += level.size();
+
+        if ((levelWidth == 1 && levelHeight == 1) || header.levels == MAX_LEVELS) {
+            break;
+        }
+        level = Downsample(level, levelWidth, levelHeight, layers);
+        levelWidth = std::max(levelWidth / 2, 1);
+        levelHeight = std::max(levelHeight / 2, 1);
+    }
+
+    // Header again, now with the level table filled in
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.close();
+    if (!file) {
+        LOG_ERROR("Failed to write texture pack: " + tempPath);
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, packPath, error);
+    if (error) {
+        LOG_ERROR("Failed to replace texture pack " + packPath + ": " + error.message());
+        return false;
+    }
+
+    LOG_INFO("Cooked " + packPath + ": " + std::to_string(layers) + " layers, " +
+             std::to_string(header.levels) + " mip levels, " + std::to_string(offset) + " bytes");
+    return true;
+}
+
+bool TexturePack::Open(const std::string& packPath, const std::string& imagePath) {
+    Close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(packPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    m_FileHandle = file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        Close();
+        return false;
+    }
+    m_MappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_MappingHandle) {
+        Close();
+        return false;
+    }
+    m_Data = static_cast<const unsigned char*>(MapViewOfFile(m_MappingHandle, FILE_MAP_READ, 0, 0, 0));
+    m_Size = static_cast<size_t>(size.QuadPart);
+#else
+    const int fd = open(packPath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0 || status.st_size == 0) {
+        close(fd);
+        return false;
+    }
+    void* mapping = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // The mapping keeps the file alive
+    m_Data = mapping == MAP_FAILED ? nullptr : static_cast<const unsigned char*>(mapping);
+    m_Size = static_cast<size_t>(status.st_size);
+#endif
+    if (!m_Data) {
+        Close();
+        return false;
+    }
+
+    const Header* header = reinterpret_cast<const Header*>(m_Data);
+    bool valid = m_Size >= sizeof(Header) && std::memcmp(header->magic, PACK_MAGIC, sizeof(PACK_MAGIC)) == 0 &&
+                 header->version == VERSION && header->levels > 0 && header->levels <= MAX_LEVELS;
+    for (uint32_t level = 0; valid && level < header->levels; ++level) {
+        const uint64_t end = header->levelOffsets[level] +
+                             GetLevelSize(header->tileWidth, header->tileHeight, header->layers, static_cast<int>(level));
+        valid = end <= m_Size;
+    }
+    if (!valid) {
+        LOG_WARNING("Ignoring malformed texture pack: " + packPath);
+        Close();
+        return false;
+    }
+
+    uint64_t sourceSize = 0;
+    int64_t sourceTime = 0;
+    if (GetSourceStamp(imagePath, sourceSize, sourceTime) &&
+        (sourceSize != header->sourceSize || sourceTime != header->sourceTime)) {
+        LOG_WARNING("Texture pack " + packPath + " is older than " + imagePath + ", cook it again");
+        Close();
+        return false;
+    }
+
+    m_Header = header;
+    return true;
+}
+
+void TexturePack::Close() {
+#ifdef _WIN32
+    if (m_Data) {
+        UnmapViewOfFile(m_Data);
+    }
+    if (m_MappingHandle) {
+        CloseHandle(m_MappingHandle);
+    }
+    if (m_FileHandle) {
+        CloseHandle(m_FileHandle);
+    }
+#else
+    if (m_Data) {
+        munmap(const_cast<unsigned char*>(m_Data), m_Size);
+    }
+#endif
+    m_Header = nullptr;
+    m_Data = nullptr;
+    m_Size = 0;
+    m_FileHandle = nullptr;
+    m_MappingHandle = nullptr;
+}
+
+int TexturePack::GetTileWidth() const { return m_Header ? static_cast<int>(m_Header->tileWidth) : 0; }
+int TexturePack::GetTileHeight() const { return m_Header ? static_cast<int>(m_Header->tileHeight) : 0; }
+int TexturePack::GetLayerCount() const { return m_Header ? static_cast<int>(m_Header->layers) : 0; }
+int TexturePack::GetLevelCount() const { return m_Header ? static_cast<int>(m_Header->levels) : 0; }
+int TexturePack::GetAtlasWidth() const { return m_Header ? static_cast<int>(m_Header->atlasWidth) : 0; }
+int TexturePack::GetAtlasHeight() const { return m_Header ? static_cast<int>(m_Header->atlasHeight) : 0; }
+
+const unsigned char* TexturePack::GetLevelData(int level) const {
+    if (!m_Header || level < 0 || level >= GetLevelCount()) {
+        return nullptr;
+    }
+    return m_Data + m_Header->levelOffsets[level];
+}
+
+} // namespace Minecraft
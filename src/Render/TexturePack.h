@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Minecraft {
+
+// A texture array cooked offline into its final GPU layout: RGBA8, every mip level
+// of every layer, level after level. Loading maps the file and hands each level to
+// GL in one call, with no image decoding or repacking at startup.
+class TexturePack {
+public:
+    static constexpr uint32_t VERSION = 1;
+    static constexpr int MAX_LEVELS = 16;
+
+    // The block atlas the chunk shader samples, and its tile size
+    static constexpr const char* BLOCK_ATLAS_PATH = "Resource/Texture/default_texture.png";
+    static constexpr int BLOCK_TILE_SIZE = 16;
+
+    TexturePack() = default;
+    ~TexturePack();
+    TexturePack(const TexturePack&) = delete;
+    TexturePack& operator=(const TexturePack&) = delete;
+
+    // "atlas.png" -> "atlas.pack"
+    static std::string GetPackPath(const std::string& imagePath);
+
+    // Split the image into tiles, build the full mip chain and write the pack
+    static bool Cook(const std::string& imagePath, const std::string& packPath, int tileWidth, int tileHeight);
+
+    // Map a cooked pack. Fails if it is malformed, or if `imagePath` exists and
+    // differs from the image it was cooked from.
+    bool Open(const std::string& packPath, const std::string& imagePath);
+    void Close();
+
+    int GetTileWidth() const;
+    int GetTileHeight() const;
+    int GetLayerCount() const;
+    int GetLevelCount() const;
+    int GetAtlasWidth() const;
+    int GetAtlasHeight() const;
+
+    // Layers of one mip level, back to back
+    const unsigned char* GetLevelData(int level) const;
+
+private:
+    struct Header;
+
+    const Header* m_Header = nullptr;
+    const unsigned char* m_Data = nullptr;
+    size_t m_Size = 0;
+    void* m_FileHandle = nullptr;     // Windows only
+    void* m_MappingHandle = nullptr;  // Windows only
+};
+
+} // namespace Minecraft
@@ -1,51 +1,84 @@
 #include "GameWidget.h"
 #include <QKeyEvent>
 #include <QMouseEvent>
-#include <QPainter>
+#include <QScreen>
 #include <QWheelEvent>
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <glm/gtc/constants.hpp>
 
+#include "../Core/GameConfig.h"
 #include "../Core/Time.h"
 #include "../Core/Inventory.h"
 #include "../Core/Input.h"
 #include "../Core/Player.h"
 #include "../Render/Shader.h"
 #include "../Render/Camera.h"
-#include "../Render/Texture.h"
+#include "../Render/FrameCapture.h"
+#include "../Render/FramePacket.h"
+#include "../Render/HudRenderer.h"
+#include "../Render/RenderState.h"
+#include "../Render/RenderThread.h"
 #include "../World/Block.h"
 #include "../World/World.h"
 #include "../World/Raycast.h"
-#include "../Utils/Logger.h"
+#include "../World/RenderDistanceGovernor.h"
+#include "../World/TerrainFieldCache.h"
+#include "../World/WorldGeneration.h"
+#include "../utils/Logger.h"
 
 GameWidget::GameWidget(QWidget* parent)
     : QOpenGLWidget(parent)
 {
     setFocusPolicy(Qt::StrongFocus);
     setMouseTracking(true);
-    SetupTimer();
+    SetupFramePacing();
 }
 
 GameWidget::~GameWidget() {
     makeCurrent();
+    if (m_Capture) {
+        m_Capture->ReleaseResources();
+        m_Capture.reset();
+    }
+    m_RenderThread.reset();
     m_Inventory.reset();
     m_Player.reset();
+    m_Governor.reset();
     m_World.reset();
-    m_BlockTexture.reset();
-    m_Shader.reset();
+    m_Hud.reset();
+    m_PresentShader.reset();
+    Minecraft::RenderState::DeleteVertexArray(m_PresentVAO);
     m_Camera.reset();
     doneCurrent();
 }
 
-void GameWidget::SetupTimer() {
-    auto* timer = new QTimer(this);
-    connect(timer, &QTimer::timeout, this, [this]() {
-        Minecraft::Time::Update();
-        UpdateGame();
-        Minecraft::Input::Update();
-        update();
+void GameWidget::SetupFramePacing() {
+    m_FrameTimer = new QTimer(this);
+    m_FrameTimer->setSingleShot(true);
+    m_FrameTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_FrameTimer, &QTimer::timeout, this, [this]() { RunFrame(); });
+
+    // Each presented frame schedules the next one; with vsync the swap itself is the pacing
+    connect(this, &QOpenGLWidget::frameSwapped, this, [this]() {
+        m_FrameTimer->start(m_FramePacer.GetMillisecondsUntilNextFrame());
     });
-    timer->start(16); // ~60 FPS
+}
+
+void GameWidget::RunFrame() {
+    m_FramePacer.WaitForFrameStart();
+    m_FramePacer.BeginFrame();
+    Minecraft::Time::Update();
+    const auto tickStart = std::chrono::steady_clock::now();
+    UpdateGame();
+    m_LastSimulationMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - tickStart).count();
+    UpdateGovernor();
+    update();
+
+    // Keeps the simulation running while Qt skips painting (minimized or hidden window);
+    // frameSwapped restarts the timer with the real delay
+    m_FrameTimer->start(100);
 }
 
 void GameWidget::initializeGL() {
@@ -63,6 +96,13 @@ void GameWidget::initializeGL() {
     // Initialize systems
     Minecraft::Time::Init();
     Minecraft::Input::Init();
+
+    const Minecraft::DisplayConfig& display = Minecraft::GameConfig::Instance().GetDisplayConfig();
+    const float refreshHz = screen() ? static_cast<float>(screen()->refreshRate()) : 60.0f;
+    m_FramePacer.Configure(display.vsync, refreshHz, display.targetFps);
+    LOG_INFO("Frame pacing: " + std::string(display.vsync ? "vsync" : "no vsync") +
+             (display.targetFps > 0 ? ", capped at " + std::to_string(display.targetFps) + " FPS" : ", no cap") +
+             ", refresh " + std::to_string(refreshHz) + " Hz");
     Minecraft::Block::InitializeBlockRegistry();
     
     LOG_INFO("Game systems initialized");
@@ -73,29 +113,32 @@ void GameWidget::initializeGL() {
     glEnable(GL_CULL_FACE);
     glCullFace(GL_BACK);
     
-    // Load shader
-    m_Shader = std::make_unique<Minecraft::Shader>();
-    if (!m_Shader->LoadFromFile("Resource/Shader/basic.vert", 
-                                 "Resource/Shader/basic.frag")) {
-        LOG_ERROR("Failed to load shaders");
-        qWarning("Failed to load shaders");
+    // World rendering runs on its own thread and context; this context only composites
+    m_RenderThread = std::make_unique<Minecraft::RenderThread>();
+    m_RenderThread->ConfigureResolutionScaling(display.dynamicResolution,
+                                               display.minResolutionScale,
+                                               display.maxResolutionScale);
+    if (!m_RenderThread->Start(context())) {
+        LOG_FATAL("Failed to start render thread");
+        qFatal("Failed to start render thread");
     }
-    
-    // Load block texture atlas as texture array
-    m_BlockTexture = std::make_unique<Minecraft::Texture>();
-    if (!m_BlockTexture->LoadAsTextureArray("Resource/Texture/default_texture.png", 16, 16)) {
-        LOG_ERROR("Failed to load block texture atlas");
-    } else {
-        LOG_INFO("Block texture atlas loaded: " + 
-                 std::to_string(m_BlockTexture->GetWidth()) + "x" + 
-                 std::to_string(m_BlockTexture->GetHeight()));
+    Minecraft::Chunk::SetMeshFormat(m_RenderThread->GetMeshFormat());
+
+    m_PresentShader = std::make_unique<Minecraft::Shader>();
+    if (!m_PresentShader->LoadFromFile("Resource/Shader/present.vert",
+                                       "Resource/Shader/present.frag")) {
+        LOG_ERROR("Failed to load present shader");
     }
+    m_PresentShader->Bind();
+    m_PresentShader->SetInt(m_PresentShader->GetUniformLocation("uFrame"), 0);
+    m_PresentShader->Unbind();
+    glGenVertexArrays(1, &m_PresentVAO);
 
-    m_SunImage = QImage("Resource/Texture/sun.png");
-    if (m_SunImage.isNull()) {
-        LOG_WARNING("Failed to load sun texture: Resource/Texture/sun.png");
-    } else {
-        LOG_INFO("Sun texture loaded");
+    m_Capture = std::make_unique<Minecraft::FrameCapture>();
+
+    m_Hud = std::make_unique<Minecraft::HudRenderer>();
+    if (!m_Hud->Initialize("Consolas", 10, static_cast<float>(devicePixelRatioF()))) {
+        m_Hud.reset();
     }
     
     // Create camera (near=0.3, far=500 for better depth precision)
@@ -113,13 +156,18 @@ void GameWidget::initializeGL() {
     LOG_INFO("Inventory initialized");
     
     // Create world and initialize around player
-    m_World = std::make_unique<Minecraft::World>();
-    m_World->SetRenderDistance(4);  // 4 chunks = 64 blocks radius
+    const Minecraft::StreamingConfig& streaming = Minecraft::GameConfig::Instance().GetStreamingConfig();
+    Minecraft::WorldGeneration::SetCavesEnabled(streaming.caves);
+    m_World = std::make_unique<Minecraft::World>(streaming.generationWorkers);
+    m_World->SetRenderDistance(streaming.initialRenderDistance);
     m_World->Initialize(m_Player->GetPosition());
+    m_Governor = std::make_unique<Minecraft::RenderDistanceGovernor>(streaming);
     LOG_INFO("World initialized with render distance: " + std::to_string(m_World->GetRenderDistance()));
     
     setCursor(Qt::BlankCursor);
     m_FirstMouse = true;
+
+    m_FrameTimer->start(0);
 }
 
 void GameWidget::resizeGL(int w, int h) {
@@ -130,46 +178,120 @@ void GameWidget::resizeGL(int w, int h) {
 }
 
 void GameWidget::paintGL() {
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LEQUAL);
-    glEnable(GL_CULL_FACE);
-    glCullFace(GL_BACK);
-    glDisable(GL_BLEND);
-    glDepthMask(GL_TRUE);
+    // Qt binds its own framebuffer and may touch state between frames, so start from a clean cache
+    Minecraft::RenderState::BeginFrame();
+    Minecraft::RenderState::Invalidate();
+
+    Minecraft::RenderThread::PresentFrame frame;
+    if (!m_RenderThread || !m_RenderThread->AcquireFrame(frame)) {
+        glClearColor(m_SkyColor.r, m_SkyColor.g, m_SkyColor.b, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    } else {
+        if (frame.ready) {
+            glWaitSync(frame.ready, 0, GL_TIMEOUT_IGNORED);
+            glDeleteSync(frame.ready);
+        }
 
-    glClearColor(m_SkyColor.r, m_SkyColor.g, m_SkyColor.b, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    
-    if (!m_Shader || !m_Camera || !m_World) return;
-    
-    m_Shader->Bind();
-    m_Shader->SetMat4("uViewProjection", m_Camera->GetViewProjectionMatrix());
-    m_Shader->SetFloat("uGlobalLight", m_GlobalLight);
-    
-    // Bind block texture
-    if (m_BlockTexture) {
-        m_BlockTexture->Bind(0);
-        m_Shader->SetInt("uTexture", 0);
+        Minecraft::RenderState::SetEnabled(GL_DEPTH_TEST, false);
+        Minecraft::RenderState::SetEnabled(GL_CULL_FACE, false);
+        Minecraft::RenderState::SetEnabled(GL_BLEND, false);
+        m_PresentShader->Bind();
+        Minecraft::RenderState::BindTexture(0, GL_TEXTURE_2D, frame.texture);
+        Minecraft::RenderState::BindVertexArray(m_PresentVAO);
+        Minecraft::RenderState::DrawArrays(GL_TRIANGLES, 0, 3);
+        Minecraft::RenderState::BindVertexArray(0);
+        Minecraft::RenderState::BindTexture(0, GL_TEXTURE_2D, 0);
+        m_PresentShader->Unbind();
+
+        // The render thread waits on this before drawing into the texture again
+        GLsync readFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glFlush();
+        m_RenderThread->ReleaseFrame(readFence);
+    }
+
+    if (m_RenderThread && Minecraft::Time::TotalTime() - m_LastStatsLogTime >= 5.0f) {
+        m_LastStatsLogTime = Minecraft::Time::TotalTime();
+        const Minecraft::RenderThread::FrameInfo info = m_RenderThread->GetLastFrameInfo();
+        LOG_DEBUG("Render: " + std::to_string(info.stats.glCalls) + " GL calls, " +
+                  std::to_string(info.stats.filteredCalls) + " filtered, " +
+                  std::to_string(info.stats.binds) + " binds, " +
+                  std::to_string(info.stats.stateChanges) + " state changes, " +
+                  std::to_string(info.stats.draws) + " draws, " +
+                  std::to_string(info.regionBatches) + " region batches (" +
+                  std::to_string(info.batchedChunks) + " chunks), " +
+                  std::to_string(info.farTiles) + " far tiles, " +
+                  std::to_string(info.cpuMs) + " ms render thread, " +
+                  std::to_string(info.gpuMs) + " ms GPU at " +
+                  std::to_string(static_cast<int>(info.resolutionScale * 100.0f + 0.5f)) + "% resolution, " +
+                  std::to_string(m_LastSimulationMs) + " ms simulation, " +
+                  std::to_string(Minecraft::Time::DroppedTicks()) + " ticks dropped");
+        const Minecraft::FramePacer::Stats pacing = m_FramePacer.GetStats();
+        LOG_DEBUG("Frame pacing: " + std::to_string(pacing.averageMs) + " ms avg, " +
+                  std::to_string(pacing.jitterMs) + " ms jitter, " +
+                  std::to_string(pacing.worstMs) + " ms worst over " +
+                  std::to_string(pacing.samples) + " frames");
+        LOG_DEBUG("HUD: " + std::to_string(m_LastHudMs) + " ms CPU, " +
+                  std::to_string(m_LastHudDraws) + " draws");
+        const Minecraft::ChunkGenerationStats generation = m_World->GetGenerationStats();
+        LOG_DEBUG("Generation: " + std::to_string(generation.generated) + " chunks, " +
+                  std::to_string(generation.cancelled) + " cancelled, " +
+                  std::to_string(generation.wasted) + " wasted, " +
+                  std::to_string(m_World->GetGenerationBacklog()) + " in backlog");
+        LOG_DEBUG("Chunks: " + std::to_string(m_World->GetLoadedChunkCount()) + " loaded, " +
+                  std::to_string(m_World->GetKnownChunkCount()) + " known, " +
+                  std::to_string(m_World->EstimateChunkMemoryBytes() / (1024 * 1024)) + " MB");
+        const Minecraft::TerrainFieldCache::Stats fields = Minecraft::WorldGeneration::GetFieldCache().GetStats();
+        LOG_DEBUG("Terrain fields: " + std::to_string(fields.tiles) + " tiles cached, " +
+                  std::to_string(fields.hits) + " hits, " + std::to_string(fields.misses) + " misses, " +
+                  std::to_string(fields.evictions) + " evicted");
+        if (m_Capture && m_Capture->IsRecording()) {
+            const Minecraft::FrameCapture::Stats capture = m_Capture->GetStats();
+            LOG_DEBUG("Capture: " + std::to_string(capture.captured) + " read back, " +
+                      std::to_string(capture.written) + " written, " +
+                      std::to_string(capture.dropped) + " dropped");
+        }
+    }
+
+    // 2D overlay in one batch; the sun is part of the sky pass on the render thread
+    if (m_Hud) {
+        const auto hudStart = std::chrono::steady_clock::now();
+        const int drawsBefore = Minecraft::RenderState::GetFrameStats().draws;
+        m_Hud->Begin(width(), height());
+        RenderCrosshair();
+        RenderHotbar();
+        m_Hud->End();
+        m_LastHudDraws = Minecraft::RenderState::GetFrameStats().draws - drawsBefore;
+        m_LastHudMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - hudStart).count();
+    }
+
+    // Reads the finished frame asynchronously, HUD included
+    if (m_Capture) {
+        m_Capture->CaptureFrame(defaultFramebufferObject(),
+                                static_cast<int>(width() * devicePixelRatioF()),
+                                static_cast<int>(height() * devicePixelRatioF()));
     }
-    
-    glDisable(GL_BLEND);
-    glDepthMask(GL_TRUE);
-    m_World->RenderOpaque();
-    
-    m_Shader->Unbind();
-    
-    // Render 2D HUD overlay
-    QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing, false);
-    RenderSun(painter);
-    RenderCrosshair(painter);
-    RenderHotbar(painter);
 }
 
 void GameWidget::UpdateGame() {
     if (!m_Camera || !m_World || !m_Player) return;
-    
-    float deltaTime = Minecraft::Time::DeltaTime();
+
+    // Simulation runs at a fixed rate regardless of how often the timer fires
+    const int ticks = Minecraft::Time::ConsumeFixedTicks();
+    for (int i = 0; i < ticks; ++i) {
+        TickSimulation(Minecraft::Time::FIXED_DELTA_TIME);
+        // Only after a tick, so a key pressed between ticks is still "just pressed" for the next one
+        Minecraft::Input::Update();
+    }
+
+    // The camera trails the simulation by up to one tick; orientation comes straight from the mouse
+    const glm::vec3 playerPos = m_Player->GetInterpolatedPosition(Minecraft::Time::InterpolationAlpha());
+    m_Camera->SetPosition(playerPos + glm::vec3(0, 1.6f, 0));
+
+    UpdateBlockSelection();
+    SubmitFrame();
+}
+
+void GameWidget::TickSimulation(float deltaTime) {
     UpdateDayNight(deltaTime);
     
     glm::vec3 moveDir(0);
@@ -211,14 +333,16 @@ void GameWidget::UpdateGame() {
         m_Player->ToggleFly();
         LOG_INFO(m_Player->IsFlying() ? "Flying mode enabled" : "Flying mode disabled");
     }
+
+    if (Minecraft::Input::IsKeyJustPressed(Qt::Key_F3)) {
+        m_World->SetRegionBatchingEnabled(!m_World->IsRegionBatchingEnabled());
+        LOG_INFO(m_World->IsRegionBatchingEnabled() ? "Region batching enabled" : "Region batching disabled");
+    }
     
     m_Player->Update(deltaTime, m_World.get());
-    
-    glm::vec3 eyePos = m_Player->GetPosition() + glm::vec3(0, 1.6f, 0);
-    m_Camera->SetPosition(eyePos);
-
-    m_World->Update(m_Player->GetPosition());
-    UpdateBlockSelection();
+    // Catch-up ticks share the frame's deadline, so they skip optional meshing work
+    m_World->SetViewDirection(m_Camera->GetFront());
+    m_World->Update(m_Player->GetPosition(), m_FramePacer.GetWorkDeadline());
 
     // ESC to exit
     if (Minecraft::Input::IsKeyJustPressed(Qt::Key_Escape)) {
@@ -227,9 +351,59 @@ void GameWidget::UpdateGame() {
     }
 }
 
+void GameWidget::UpdateGovernor() {
+    if (!m_Governor || !m_World || !m_RenderThread) return;
+
+    // Work is summed although the threads overlap, so the distance only grows with room to spare
+    const Minecraft::RenderThread::FrameInfo info = m_RenderThread->GetLastFrameInfo();
+    const float frameInterval = m_FramePacer.GetFrameInterval();
+
+    Minecraft::RenderDistanceGovernor::Sample sample;
+    sample.frameMs = m_FramePacer.GetLastFrameMs();
+    sample.workMs = m_LastSimulationMs + info.cpuMs + info.gpuMs;
+    sample.targetMs = (frameInterval > 0.0f ? frameInterval : Minecraft::FramePacer::NOMINAL_INTERVAL) * 1000.0f;
+    sample.generationBacklog = m_World->GetGenerationBacklog();
+    sample.meshBacklog = m_World->GetMeshBacklog();
+    sample.chunkMemoryBytes = m_World->EstimateChunkMemoryBytes();
+    sample.loadedChunks = m_World->GetLoadedChunkCount();
+    m_Governor->Update(*m_World, sample, Minecraft::Time::DeltaTime());
+}
+
+void GameWidget::SubmitFrame() {
+    if (!m_RenderThread) return;
+
+    const glm::mat4 viewProjection = m_Camera->GetViewProjectionMatrix();
+    const glm::vec3 cameraPos = m_Camera->GetPosition();
+    m_World->UpdateOcclusion(viewProjection, cameraPos);
+    m_World->UpdateTransparentSorting(cameraPos);
+
+    Minecraft::FramePacket packet;
+    packet.viewProjection = viewProjection;
+    packet.cameraPosition = cameraPos;
+    packet.skyColor = m_SkyColor;
+    packet.globalLight = m_GlobalLight;
+    packet.time = Minecraft::Time::TotalTime();
+    packet.sunDirection = GetSunDirection();
+    packet.width = static_cast<int>(width() * devicePixelRatioF());
+    packet.height = static_cast<int>(height() * devicePixelRatioF());
+    const float frameInterval = m_FramePacer.GetFrameInterval();
+    packet.targetFrameMs = (frameInterval > 0.0f ? frameInterval : Minecraft::FramePacer::NOMINAL_INTERVAL) * 1000.0f;
+    m_World->BuildFramePacket(packet, cameraPos);
+
+    // Same view, but a depth range that reaches the horizon
+    if (packet.horizonDistance > 0.0f) {
+        const float nearPlane = packet.horizonDistance / Minecraft::FarTerrain::HORIZON_FACTOR * 0.5f;
+        const glm::mat4 projection = glm::perspective(glm::radians(m_Camera->GetFOV()), m_Camera->GetAspectRatio(),
+                                                      nearPlane, packet.horizonDistance * 1.2f);
+        packet.farViewProjection = projection * m_Camera->GetViewMatrix();
+    }
+    m_RenderThread->Submit(std::move(packet));
+}
+
 void GameWidget::keyPressEvent(QKeyEvent* event) {
     if (!event->isAutoRepeat()) {
         HandleHotbarKeyInput(event->key());
+        HandleCaptureKeyInput(event->key());
     }
     Minecraft::Input::OnKeyPress(static_cast<Qt::Key>(event->key()));
 }
@@ -319,41 +493,16 @@ void GameWidget::UpdateBlockSelection() {
     }
 }
 
-void GameWidget::RenderCrosshair(QPainter& painter) {
-    painter.setPen(QPen(QColor(255, 40, 40), 2));
-
-    const int centerX = width() / 2;
-    const int centerY = height() / 2;
-    const int crosshairSize = 8;
-
-    painter.drawLine(centerX - crosshairSize, centerY, centerX + crosshairSize, centerY);
-    painter.drawLine(centerX, centerY - crosshairSize, centerX, centerY + crosshairSize);
-}
-
-void GameWidget::RenderSun(QPainter& painter) {
-    if (m_SunImage.isNull() || !m_Camera) {
-        return;
-    }
-
-    const glm::vec3 sunDir = GetSunDirection();
-    const glm::vec3 sunWorldPos = m_Camera->GetPosition() + sunDir * 220.0f;
-    const glm::vec4 clip = m_Camera->GetViewProjectionMatrix() * glm::vec4(sunWorldPos, 1.0f);
-    if (clip.w <= 0.001f) {
-        return;
-    }
+void GameWidget::RenderCrosshair() {
+    const glm::vec4 color(1.0f, 40.0f / 255.0f, 40.0f / 255.0f, 1.0f);
 
-    const glm::vec3 ndc = glm::vec3(clip) / clip.w;
-    if (ndc.z < -1.0f || ndc.z > 1.0f) {
-        return;
-    }
-    if (ndc.x < -1.2f || ndc.x > 1.2f || ndc.y < -1.2f || ndc.y > 1.2f) {
-        return;
-    }
+    const float centerX = static_cast<float>(width() / 2);
+    const float centerY = static_cast<float>(height() / 2);
+    const float crosshairSize = 8.0f;
+    const float thickness = 2.0f;
 
-    const int centerX = static_cast<int>((ndc.x * 0.5f + 0.5f) * static_cast<float>(width()));
-    const int centerY = static_cast<int>((1.0f - (ndc.y * 0.5f + 0.5f)) * static_cast<float>(height()));
-    const int sunSize = 72;
-    painter.drawImage(QRect(centerX - sunSize / 2, centerY - sunSize / 2, sunSize, sunSize), m_SunImage);
+    m_Hud->DrawRect(centerX - crosshairSize, centerY - thickness * 0.5f, crosshairSize * 2.0f, thickness, color);
+    m_Hud->DrawRect(centerX - thickness * 0.5f, centerY - crosshairSize, thickness, crosshairSize * 2.0f, color);
 }
 
 glm::vec3 GameWidget::GetSunDirection() const {
@@ -384,43 +533,46 @@ void GameWidget::UpdateDayNight(float deltaTime) {
     m_SkyColor = glm::mix(m_SkyColor, sunsetSky, twilight * 0.45f);
 }
 
-void GameWidget::RenderHotbar(QPainter& painter) {
+void GameWidget::RenderHotbar() {
     if (!m_Inventory) {
         return;
     }
 
+    using Align = Minecraft::HudRenderer::Align;
     constexpr int slotCount = Minecraft::Inventory::HOTBAR_SIZE;
-    constexpr int slotSize = 52;
-    constexpr int slotGap = 8;
-    const int totalWidth = slotCount * slotSize + (slotCount - 1) * slotGap;
-    const int startX = (width() - totalWidth) / 2;
-    const int startY = height() - slotSize - 28;
-
-    painter.setFont(QFont("Consolas", 10, QFont::Bold));
+    constexpr float slotSize = 52.0f;
+    constexpr float slotGap = 8.0f;
+    const float totalWidth = slotCount * slotSize + (slotCount - 1) * slotGap;
+    const float startX = std::floor((static_cast<float>(width()) - totalWidth) * 0.5f);
+    const float startY = static_cast<float>(height()) - slotSize - 28.0f;
+    const float lineHeight = m_Hud->GetLineHeight();
+
+    const glm::vec4 background(26.0f / 255.0f, 26.0f / 255.0f, 26.0f / 255.0f, 180.0f / 255.0f);
+    const glm::vec4 selectedBorder(1.0f, 230.0f / 255.0f, 120.0f / 255.0f, 1.0f);
+    const glm::vec4 border(205.0f / 255.0f, 205.0f / 255.0f, 205.0f / 255.0f, 1.0f);
+    const glm::vec4 white(1.0f);
+    const glm::vec4 label(245.0f / 255.0f, 245.0f / 255.0f, 245.0f / 255.0f, 220.0f / 255.0f);
 
     for (int i = 0; i < slotCount; ++i) {
-        const int x = startX + i * (slotSize + slotGap);
-        const QRect slotRect(x, startY, slotSize, slotSize);
+        const float x = startX + i * (slotSize + slotGap);
         const bool selected = (i == m_Inventory->GetSelectedSlot());
 
-        painter.fillRect(slotRect, QColor(26, 26, 26, 180));
-        painter.setPen(selected ? QPen(QColor(255, 230, 120), 3) : QPen(QColor(205, 205, 205), 2));
-        painter.drawRect(slotRect);
+        m_Hud->DrawRect(x, startY, slotSize, slotSize, background);
+        m_Hud->DrawRectOutline(x, startY, slotSize, slotSize, selected ? 3.0f : 2.0f, selected ? selectedBorder : border);
 
         const Minecraft::ItemStack& stack = m_Inventory->GetSlot(i);
         if (!stack.IsEmpty()) {
             const Minecraft::BlockData& block = Minecraft::Block::GetBlockData(stack.type);
-            painter.setPen(QColor(255, 255, 255));
-            painter.drawText(slotRect.adjusted(6, 6, -6, -22), Qt::AlignLeft | Qt::AlignTop, QString::fromStdString(block.name));
+            m_Hud->DrawText(x + 6.0f, startY + 6.0f, block.name, white);
 
             if (stack.count > 1) {
-                painter.setPen(QColor(255, 255, 255));
-                painter.drawText(slotRect.adjusted(0, 0, -4, -4), Qt::AlignRight | Qt::AlignBottom, QString::number(stack.count));
+                m_Hud->DrawText(x + slotSize - 4.0f, startY + slotSize - 4.0f - lineHeight,
+                                std::to_string(stack.count), white, Align::Right);
             }
         }
 
-        painter.setPen(QColor(245, 245, 245, 220));
-        painter.drawText(QRect(x, startY + slotSize + 3, slotSize, 16), Qt::AlignCenter, QString::number((i + 1) % 10));
+        m_Hud->DrawText(x + slotSize * 0.5f, startY + slotSize + 3.0f + (16.0f - lineHeight) * 0.5f,
+                        std::to_string((i + 1) % 10), label, Align::Center);
     }
 }
 
@@ -434,4 +586,20 @@ void GameWidget::HandleHotbarKeyInput(int key) {
     }
 }
 
+void GameWidget::HandleCaptureKeyInput(int key) {
+    if (!m_Capture) {
+        return;
+    }
+
+    if (key == Qt::Key_F2) {
+        m_Capture->RequestScreenshot();
+    } else if (key == Qt::Key_F9) {
+        if (m_Capture->IsRecording()) {
+            m_Capture->StopRecording();
+        } else {
+            m_Capture->StartRecording(Minecraft::FrameCapture::Format::Raw);
+        }
+    }
+}
+
 
@@ -2,9 +2,8 @@
 
 #include <GL/glew.h>
 #include <glm/glm.hpp>
+#include "../Core/FramePacer.h"
 #include <QOpenGLWidget>
-#include <QImage>
-#include <QPainter>
 #include <QTimer>
 #include <memory>
 
@@ -12,7 +11,10 @@ namespace Minecraft {
 class Shader;
 class Camera;
 class World;
-class Texture;
+class RenderThread;
+class FrameCapture;
+class HudRenderer;
+class RenderDistanceGovernor;
 class Player;
 class Inventory;
 }
@@ -37,22 +39,38 @@ protected:
 
 private:
     void UpdateGame();
-    void SetupTimer();
-    void RenderCrosshair(QPainter& painter);
-    void RenderSun(QPainter& painter);
-    void RenderHotbar(QPainter& painter);
+    void UpdateGovernor();
+    void TickSimulation(float deltaTime);
+    void SubmitFrame();
+    void SetupFramePacing();
+    void RunFrame();
+    void RenderCrosshair();
+    void RenderHotbar();
     void HandleHotbarKeyInput(int key);
+    void HandleCaptureKeyInput(int key);
     void UpdateDayNight(float deltaTime);
     glm::vec3 GetSunDirection() const;
     void UpdateBlockSelection();
 
-    std::unique_ptr<Minecraft::Shader> m_Shader;
+    std::unique_ptr<Minecraft::RenderThread> m_RenderThread;
+    std::unique_ptr<Minecraft::Shader> m_PresentShader;  // Composites the render thread's frame
+    GLuint m_PresentVAO = 0;
+    std::unique_ptr<Minecraft::HudRenderer> m_Hud;
+    std::unique_ptr<Minecraft::FrameCapture> m_Capture;  // F2 screenshot, F9 toggles recording
     std::unique_ptr<Minecraft::Camera> m_Camera;
-    std::unique_ptr<Minecraft::Texture> m_BlockTexture;
     std::unique_ptr<Minecraft::World> m_World;
+    std::unique_ptr<Minecraft::RenderDistanceGovernor> m_Governor;
     std::unique_ptr<Minecraft::Player> m_Player;
     std::unique_ptr<Minecraft::Inventory> m_Inventory;
 
+    Minecraft::FramePacer m_FramePacer;
+    QTimer* m_FrameTimer = nullptr;  // Single shot, restarted after every swap
+
+    float m_LastStatsLogTime = 0.0f;
+    float m_LastSimulationMs = 0.0f;  // UpdateGame: all ticks of the frame plus frame packet assembly
+    float m_LastHudMs = 0.0f;         // Building and submitting the HUD batch
+    int m_LastHudDraws = 0;
+
     bool m_FirstMouse = true;
     float m_LastX = 0.0f;
     float m_LastY = 0.0f;
@@ -62,7 +80,6 @@ private:
     float m_DayLengthSeconds = 300.0f;      // Full cycle length in real-time seconds
     float m_GlobalLight = 1.0f;             // Global world light multiplier
     glm::vec3 m_SkyColor = glm::vec3(0.2f, 0.65f, 1.0f);
-    QImage m_SunImage;
 
     bool m_BlockSelected = false;
     int m_SelectedBlockX = 0;
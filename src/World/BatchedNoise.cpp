@@ -0,0 +1,352 @@
+#include "BatchedNoise.h"
+
+#include <cstdint>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define MINECRAFT_NOISE_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+#define MINECRAFT_NOISE_SSE2
+#endif
+
+namespace Minecraft {
+
+namespace {
+
+// Constants of FastNoiseLite's Perlin implementation
+constexpr uint32_t PRIME_X = 501125321U;
+constexpr uint32_t PRIME_Y = 1136930381U;
+constexpr uint32_t HASH_MULTIPLIER = 0x27d4eb2dU;
+constexpr float PERLIN_SCALE = 1.4247691104677813f;
+
+// FastNoiseLite's Gradients2D: 24 directions repeated five times, then 8 diagonals
+struct GradientTable {
+    alignas(32) float values[256];
+
+    GradientTable() {
+        static const float directions[48] = {
+            0.130526192220052f, 0.99144486137381f, 0.38268343236509f, 0.923879532511287f,
+            0.608761429008721f, 0.793353340291235f, 0.793353340291235f, 0.608761429008721f,
+            0.923879532511287f, 0.38268343236509f, 0.99144486137381f, 0.130526192220051f,
+            0.99144486137381f, -0.130526192220051f, 0.923879532511287f, -0.38268343236509f,
+            0.793353340291235f, -0.60876142900872f, 0.608761429008721f, -0.793353340291235f,
+            0.38268343236509f, -0.923879532511287f, 0.130526192220052f, -0.99144486137381f,
+            -0.130526192220052f, -0.99144486137381f, -0.38268343236509f, -0.923879532511287f,
+            -0.608761429008721f, -0.793353340291235f, -0.793353340291235f, -0.608761429008721f,
+            -0.923879532511287f, -0.38268343236509f, -0.99144486137381f, -0.130526192220052f,
+            -0.99144486137381f, 0.130526192220051f, -0.923879532511287f, 0.38268343236509f,
+            -0.793353340291235f, 0.608761429008721f, -0.608761429008721f, 0.793353340291235f,
+            -0.38268343236509f, 0.923879532511287f, -0.130526192220052f, 0.99144486137381f};
+        static const float diagonals[16] = {
+            0.38268343236509f, 0.923879532511287f, 0.923879532511287f, 0.38268343236509f,
+            0.923879532511287f, -0.38268343236509f, 0.38268343236509f, -0.923879532511287f,
+            -0.38268343236509f, -0.923879532511287f, -0.923879532511287f, -0.38268343236509f,
+            -0.923879532511287f, 0.38268343236509f, -0.38268343236509f, 0.923879532511287f};
+
+        for (int i = 0; i < 240; ++i) {
+            values[i] = directions[i % 48];
+        }
+        for (int i = 0; i < 16; ++i) {
+            values[240 + i] = diagonals[i];
+        }
+    }
+};
+
+const float* GetGradients() {
+    static const GradientTable table;
+    return table.values;
+}
+
+// Lattice cell, offsets and fade weight of one coordinate, as SinglePerlin computes them
+struct AxisTerm {
+    int primed0 = 0;
+    int primed1 = 0;
+    float d0 = 0.0f;
+    float d1 = 0.0f;
+    float fade = 0.0f;
+};
+
+AxisTerm MakeAxisTerm(float coord, uint32_t prime) {
+    // FastNoiseLite::FastFloor, which also steps negative integers down by one
+    const int cell = coord >= 0 ? static_cast<int>(coord) : static_cast<int>(coord) - 1;
+
+    AxisTerm term;
+    term.d0 = static_cast<float>(coord - cell);
+    term.d1 = term.d0 - 1;
+    term.fade = term.d0 * term.d0 * term.d0 * (term.d0 * (term.d0 * 6 - 15) + 10);
+    const uint32_t primed = static_cast<uint32_t>(cell) * prime;
+    term.primed0 = static_cast<int>(primed);
+    term.primed1 = static_cast<int>(primed + prime);
+    return term;
+}
+
+float GradCoord(int seedY, int xPrimed, float xd, float yd, const float* gradients) {
+    int hash = static_cast<int>(static_cast<uint32_t>(seedY ^ xPrimed) * HASH_MULTIPLIER);
+    hash ^= hash >> 15;
+    hash &= 127 << 1;
+    return xd * gradients[hash] + yd * gradients[hash | 1];
+}
+
+float Lerp(float a, float b, float t) {
+    return a + t * (b - a);
+}
+
+// seedY0/seedY1 are the seed already combined with the row's primed cells
+float EvaluateScalar(const AxisTerm& x, const AxisTerm& y, int seedY0, int seedY1, const float* gradients) {
+    const float xf0 = Lerp(GradCoord(seedY0, x.primed0, x.d0, y.d0, gradients),
+                           GradCoord(seedY0, x.primed1, x.d1, y.d0, gradients), x.fade);
+    const float xf1 = Lerp(GradCoord(seedY1, x.primed0, x.d0, y.d1, gradients),
+                           GradCoord(seedY1, x.primed1, x.d1, y.d1, gradients), x.fade);
+    return Lerp(xf0, xf1, y.fade) * PERLIN_SCALE;
+}
+
+// Column terms split into arrays so the vector loop can load them directly
+struct ColumnTerms {
+    std::vector<int> primed0;
+    std::vector<int> primed1;
+    std::vector<float> d0;
+    std::vector<float> d1;
+    std::vector<float> fade;
+
+    void Build(const NoiseGrid& grid, float frequency) {
+        primed0.resize(grid.width);
+        primed1.resize(grid.width);
+        d0.resize(grid.width);
+        d1.resize(grid.width);
+        fade.resize(grid.width);
+        for (int i = 0; i < grid.width; ++i) {
+            const float coord = (static_cast<float>(grid.originX + i * grid.step) * grid.scale + grid.offsetX) * frequency;
+            const AxisTerm term = MakeAxisTerm(coord, PRIME_X);
+            primed0[i] = term.primed0;
+            primed1[i] = term.primed1;
+            d0[i] = term.d0;
+            d1[i] = term.d1;
+            fade[i] = term.fade;
+        }
+    }
+
+    AxisTerm Get(int i) const {
+        AxisTerm term;
+        term.primed0 = primed0[i];
+        term.primed1 = primed1[i];
+        term.d0 = d0[i];
+        term.d1 = d1[i];
+        term.fade = fade[i];
+        return term;
+    }
+};
+
+#if defined(MINECRAFT_NOISE_AVX2)
+
+constexpr int LANES = 8;
+
+__m256 GradCoord8(__m256i seedY, __m256i xPrimed, __m256 xd, __m256 yd, const float* gradients) {
+    __m256i hash = _mm256_mullo_epi32(_mm256_xor_si256(seedY, xPrimed), _mm256_set1_epi32(static_cast<int>(HASH_MULTIPLIER)));
+    hash = _mm256_xor_si256(hash, _mm256_srai_epi32(hash, 15));
+    hash = _mm256_and_si256(hash, _mm256_set1_epi32(127 << 1));
+    // hash is even, so hash | 1 == hash + 1
+    const __m256 xg = _mm256_i32gather_ps(gradients, hash, 4);
+    const __m256 yg = _mm256_i32gather_ps(gradients + 1, hash, 4);
+    return _mm256_add_ps(_mm256_mul_ps(xd, xg), _mm256_mul_ps(yd, yg));
+}
+
+__m256 Lerp8(__m256 a, __m256 b, __m256 t) {
+    return _mm256_add_ps(a, _mm256_mul_ps(t, _mm256_sub_ps(b, a)));
+}
+
+// Evaluates columns [0, count) rounded down to whole vectors, returns the columns done
+int EvaluateRow(const ColumnTerms& columns, int count, const AxisTerm& y, int seedY0, int seedY1,
+                float amplitude, bool accumulate, float* out, const float* gradients) {
+    const __m256i seed0 = _mm256_set1_epi32(seedY0);
+    const __m256i seed1 = _mm256_set1_epi32(seedY1);
+    const __m256 yd0 = _mm256_set1_ps(y.d0);
+    const __m256 yd1 = _mm256_set1_ps(y.d1);
+    const __m256 yFade = _mm256_set1_ps(y.fade);
+    const __m256 scale = _mm256_set1_ps(PERLIN_SCALE);
+    const __m256 amp = _mm256_set1_ps(amplitude);
+
+    int i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        const __m256i xp0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(columns.primed0.data() + i));
+        const __m256i xp1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(columns.primed1.data() + i));
+        const __m256 xd0 = _mm256_loadu_ps(columns.d0.data() + i);
+        const __m256 xd1 = _mm256_loadu_ps(columns.d1.data() + i);
+        const __m256 xFade = _mm256_loadu_ps(columns.fade.data() + i);
+
+        const __m256 xf0 = Lerp8(GradCoord8(seed0, xp0, xd0, yd0, gradients), GradCoord8(seed0, xp1, xd1, yd0, gradients), xFade);
+        const __m256 xf1 = Lerp8(GradCoord8(seed1, xp0, xd0, yd1, gradients), GradCoord8(seed1, xp1, xd1, yd1, gradients), xFade);
+        const __m256 value = _mm256_mul_ps(Lerp8(xf0, xf1, yFade), scale);
+
+        if (accumulate) {
+            _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(out + i), _mm256_mul_ps(value, amp)));
+        } else {
+            _mm256_storeu_ps(out + i, value);
+        }
+    }
+    return i;
+}
+
+#elif defined(MINECRAFT_NOISE_SSE2)
+
+constexpr int LANES = 4;
+
+__m128i MulLo(__m128i a, __m128i b) {
+#if defined(__SSE4_1__)
+    return _mm_mullo_epi32(a, b);
+#else
+    const __m128i even = _mm_mul_epu32(a, b);
+    const __m128i odd = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+#endif
+}
+
+__m128 GradCoord4(__m128i seedY, __m128i xPrimed, __m128 xd, __m128 yd, const float* gradients) {
+    __m128i hash = MulLo(_mm_xor_si128(seedY, xPrimed), _mm_set1_epi32(static_cast<int>(HASH_MULTIPLIER)));
+    hash = _mm_xor_si128(hash, _mm_srai_epi32(hash, 15));
+    hash = _mm_and_si128(hash, _mm_set1_epi32(127 << 1));
+
+    // No gather before AVX2; the table is 1 KB and stays in L1
+    alignas(16) int index[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(index), hash);
+    const __m128 xg = _mm_setr_ps(gradients[index[0]], gradients[index[1]], gradients[index[2]], gradients[index[3]]);
+    const __m128 yg = _mm_setr_ps(gradients[index[0] | 1], gradients[index[1] | 1], gradients[index[2] | 1], gradients[index[3] | 1]);
+    return _mm_add_ps(_mm_mul_ps(xd, xg), _mm_mul_ps(yd, yg));
+}
+
+__m128 Lerp4(__m128 a, __m128 b, __m128 t) {
+    return _mm_add_ps(a, _mm_mul_ps(t, _mm_sub_ps(b, a)));
+}
+
+int EvaluateRow(const ColumnTerms& columns, int count, const AxisTerm& y, int seedY0, int seedY1,
+                float amplitude, bool accumulate, float* out, const float* gradients) {
+    const __m128i seed0 = _mm_set1_epi32(seedY0);
+    const __m128i seed1 = _mm_set1_epi32(seedY1);
+    const __m128 yd0 = _mm_set1_ps(y.d0);
+    const __m128 yd1 = _mm_set1_ps(y.d1);
+    const __m128 yFade = _mm_set1_ps(y.fade);
+    const __m128 scale = _mm_set1_ps(PERLIN_SCALE);
+    const __m128 amp = _mm_set1_ps(amplitude);
+
+    int i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        const __m128i xp0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(columns.primed0.data() + i));
+        const __m128i xp1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(columns.primed1.data() + i));
+        const __m128 xd0 = _mm_loadu_ps(columns.d0.data() + i);
+        const __m128 xd1 = _mm_loadu_ps(columns.d1.data() + i);
+        const __m128 xFade = _mm_loadu_ps(columns.fade.data() + i);
+
+        const __m128 xf0 = Lerp4(GradCoord4(seed0, xp0, xd0, yd0, gradients), GradCoord4(seed0, xp1, xd1, yd0, gradients), xFade);
+        const __m128 xf1 = Lerp4(GradCoord4(seed1, xp0, xd0, yd1, gradients), GradCoord4(seed1, xp1, xd1, yd1, gradients), xFade);
+        const __m128 value = _mm_mul_ps(Lerp4(xf0, xf1, yFade), scale);
+
+        if (accumulate) {
+            _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), _mm_mul_ps(value, amp)));
+        } else {
+            _mm_storeu_ps(out + i, value);
+        }
+    }
+    return i;
+}
+
+#else
+
+int EvaluateRow(const ColumnTerms&, int, const AxisTerm&, int, int, float, bool, float*, const float*) {
+    return 0;
+}
+
+#endif
+
+} // namespace
+
+void UpsampleLattice4(const float* lattice, int cells, float* out) {
+#if defined(MINECRAFT_NOISE_AVX2)
+    // Two cells per vector
+    const __m256 weights = _mm256_setr_ps(0.0f, 0.25f, 0.5f, 0.75f, 0.0f, 0.25f, 0.5f, 0.75f);
+    int i = 0;
+    for (; i + 2 <= cells; i += 2) {
+        const __m256 a = _mm256_setr_m128(_mm_set1_ps(lattice[i]), _mm_set1_ps(lattice[i + 1]));
+        const __m256 b = _mm256_setr_m128(_mm_set1_ps(lattice[i + 1]), _mm_set1_ps(lattice[i + 2]));
+        _mm256_storeu_ps(out + 4 * i, _mm256_add_ps(a, _mm256_mul_ps(weights, _mm256_sub_ps(b, a))));
+    }
+    for (; i < cells; ++i) {
+        const __m128 a = _mm_set1_ps(lattice[i]);
+        const __m128 b = _mm_set1_ps(lattice[i + 1]);
+        _mm_storeu_ps(out + 4 * i, _mm_add_ps(a, _mm_mul_ps(_mm_setr_ps(0.0f, 0.25f, 0.5f, 0.75f), _mm_sub_ps(b, a))));
+    }
+#elif defined(MINECRAFT_NOISE_SSE2)
+    const __m128 weights = _mm_setr_ps(0.0f, 0.25f, 0.5f, 0.75f);
+    for (int i = 0; i < cells; ++i) {
+        const __m128 a = _mm_set1_ps(lattice[i]);
+        const __m128 b = _mm_set1_ps(lattice[i + 1]);
+        _mm_storeu_ps(out + 4 * i, _mm_add_ps(a, _mm_mul_ps(weights, _mm_sub_ps(b, a))));
+    }
+#else
+    for (int i = 0; i < cells; ++i) {
+        for (int k = 0; k < 4; ++k) {
+            out[4 * i + k] = lattice[i] + 0.25f * static_cast<float>(k) * (lattice[i + 1] - lattice[i]);
+        }
+    }
+#endif
+}
+
+BatchedPerlin::BatchedPerlin(int seed, float frequency)
+    : m_Seed(seed)
+    , m_Frequency(frequency) {
+}
+
+float BatchedPerlin::Sample(float x, float y) const {
+    const AxisTerm xTerm = MakeAxisTerm(x * m_Frequency, PRIME_X);
+    const AxisTerm yTerm = MakeAxisTerm(y * m_Frequency, PRIME_Y);
+    return EvaluateScalar(xTerm, yTerm, m_Seed ^ yTerm.primed0, m_Seed ^ yTerm.primed1, GetGradients());
+}
+
+void BatchedPerlin::SampleGrid(const NoiseGrid& grid, float* out) const {
+    Evaluate(grid, 1.0f, false, out);
+}
+
+void BatchedPerlin::AccumulateGrid(const NoiseGrid& grid, float amplitude, float* out) const {
+    Evaluate(grid, amplitude, true, out);
+}
+
+const char* BatchedPerlin::GetInstructionSet() {
+#if defined(MINECRAFT_NOISE_AVX2)
+    return "AVX2";
+#elif defined(MINECRAFT_NOISE_SSE2)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+void BatchedPerlin::Evaluate(const NoiseGrid& grid, float amplitude, bool accumulate, float* out) const {
+    if (grid.width <= 0 || grid.depth <= 0) {
+        return;
+    }
+
+    // Scratch reused by every grid this thread evaluates
+    thread_local ColumnTerms columns;
+    columns.Build(grid, m_Frequency);
+    const float* gradients = GetGradients();
+
+    for (int j = 0; j < grid.depth; ++j) {
+        const float coord = (static_cast<float>(grid.originZ + j * grid.step) * grid.scale + grid.offsetZ) * m_Frequency;
+        const AxisTerm y = MakeAxisTerm(coord, PRIME_Y);
+        const int seedY0 = m_Seed ^ y.primed0;
+        const int seedY1 = m_Seed ^ y.primed1;
+        float* row = out + j * grid.width;
+
+        for (int i = EvaluateRow(columns, grid.width, y, seedY0, seedY1, amplitude, accumulate, row, gradients);
+             i < grid.width; ++i) {
+            const float value = EvaluateScalar(columns.Get(i), y, seedY0, seedY1, gradients);
+            row[i] = accumulate ? row[i] + value * amplitude : value;
+        }
+    }
+}
+
+} // namespace Minecraft
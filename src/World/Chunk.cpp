@@ -1,73 +1,157 @@
-#include "World.h"
 #include "Chunk.h"
 #include "ChunkMeshBuilder.h"
-#include "../Utils/Logger.h"
-#include <GL/glew.h>
+#include "../utils/Logger.h"
+#include <algorithm>
 
 namespace Minecraft {
 
-namespace {
-
-void SetupMeshBuffers(unsigned int& vao,
-                      unsigned int& vbo,
-                      unsigned int& ebo,
-                      const std::vector<Vertex>& vertices,
-                      const std::vector<unsigned int>& indices) {
-    if (vao == 0) {
-        glGenVertexArrays(1, &vao);
-        glGenBuffers(1, &vbo);
-        glGenBuffers(1, &ebo);
-    }
+MeshFormat Chunk::s_MeshFormat = MeshFormat::Vertices;
 
-    glBindVertexArray(vao);
+Chunk::Chunk(int chunkX, int chunkZ)
+    : m_ChunkX(chunkX), m_ChunkZ(chunkZ) {
+    m_Blocks.fill(BlockType::Air);
+}
 
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+glm::ivec3 Chunk::GetRegionOrigin() const {
+    return glm::ivec3(FloorDiv(m_ChunkX, REGION_SIZE) * REGION_SIZE * CHUNK_SIZE, 0,
+                      FloorDiv(m_ChunkZ, REGION_SIZE) * REGION_SIZE * CHUNK_SIZE);
+}
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+int Chunk::GetBlockIndex(int x, int y, int z) const {
+    return y * CHUNK_SIZE * CHUNK_SIZE + z * CHUNK_SIZE + x;
+}
 
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+void Chunk::SetBlock(int x, int y, int z, BlockType type) {
+    if (x < 0 || x >= CHUNK_SIZE || y < 0 || y >= CHUNK_HEIGHT || z < 0 || z >= CHUNK_SIZE) {
+        return;
+    }
 
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoord));
+    BlockType& block = m_Blocks[GetBlockIndex(x, y, z)];
+    m_BlockCount += (type != BlockType::Air) - (block != BlockType::Air);
+    block = type;
+    UpdateColumnHeight(x, z, y, y + 1, type);
+    m_MeshBuilt = false;
+}
+
+void Chunk::FillColumn(int x, int z, int y0, int y1, BlockType type) {
+    y0 = std::max(y0, 0);
+    y1 = std::min(y1, CHUNK_HEIGHT);
+    if (x < 0 || x >= CHUNK_SIZE || z < 0 || z >= CHUNK_SIZE || y0 >= y1) {
+        return;
+    }
 
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texIndex));
+    int replaced = 0;
+    BlockType* block = &m_Blocks[GetBlockIndex(x, y0, z)];
+    for (int y = y0; y < y1; ++y, block += CHUNK_SIZE * CHUNK_SIZE) {
+        replaced += *block != BlockType::Air;
+        *block = type;
+    }
+    m_BlockCount += (type != BlockType::Air ? y1 - y0 : 0) - replaced;
+    UpdateColumnHeight(x, z, y0, y1, type);
+    m_MeshBuilt = false;
+}
 
-    glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, lighting));
+void Chunk::FillBox(const glm::ivec3& min, const glm::ivec3& max, BlockType type) {
+    const glm::ivec3 lo = glm::max(min, glm::ivec3(0));
+    const glm::ivec3 hi = glm::min(max, glm::ivec3(CHUNK_SIZE, CHUNK_HEIGHT, CHUNK_SIZE));
+    if (lo.x >= hi.x || lo.y >= hi.y || lo.z >= hi.z) {
+        return;
+    }
 
-    glEnableVertexAttribArray(4);
-    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, blockPos));
+    // Rows along x are contiguous
+    int replaced = 0;
+    for (int y = lo.y; y < hi.y; ++y) {
+        for (int z = lo.z; z < hi.z; ++z) {
+            BlockType* row = &m_Blocks[GetBlockIndex(lo.x, y, z)];
+            replaced += static_cast<int>(hi.x - lo.x - std::count(row, row + (hi.x - lo.x), BlockType::Air));
+            std::fill(row, row + (hi.x - lo.x), type);
+        }
+    }
+    const int volume = (hi.x - lo.x) * (hi.y - lo.y) * (hi.z - lo.z);
+    m_BlockCount += (type != BlockType::Air ? volume : 0) - replaced;
 
-    glBindVertexArray(0);
+    for (int z = lo.z; z < hi.z; ++z) {
+        for (int x = lo.x; x < hi.x; ++x) {
+            UpdateColumnHeight(x, z, lo.y, hi.y, type);
+        }
+    }
+    m_MeshBuilt = false;
 }
 
-} // namespace
-
-Chunk::Chunk(int chunkX, int chunkZ)
-    : m_ChunkX(chunkX), m_ChunkZ(chunkZ) {
-    m_Blocks.fill(BlockType::Air);
+void Chunk::FillLayers(int y0, int y1, BlockType type) {
+    FillBox(glm::ivec3(0, y0, 0), glm::ivec3(CHUNK_SIZE, y1, CHUNK_SIZE), type);
 }
 
-int Chunk::GetBlockIndex(int x, int y, int z) const {
-    return y * CHUNK_SIZE * CHUNK_SIZE + z * CHUNK_SIZE + x;
+int Chunk::WriteColumn(int x, int z, int y0, const ColumnLayer* layers, int layerCount) {
+    int y = y0;
+    if (x < 0 || x >= CHUNK_SIZE || z < 0 || z >= CHUNK_SIZE) {
+        for (int i = 0; i < layerCount; ++i) {
+            y += layers[i].thickness;
+        }
+        return y;
+    }
+
+    const int oldHeight = GetColumnHeight(x, z);
+    int delta = 0;
+    for (int i = 0; i < layerCount; ++i) {
+        const int start = std::max(y, 0);
+        const int end = std::min(y + layers[i].thickness, CHUNK_HEIGHT);
+        y += layers[i].thickness;
+        if (start >= end) {
+            continue;
+        }
+
+        const BlockType type = layers[i].type;
+        BlockType* block = &m_Blocks[GetBlockIndex(x, start, z)];
+        for (int by = start; by < end; ++by, block += CHUNK_SIZE * CHUNK_SIZE) {
+            delta += (type != BlockType::Air) - (*block != BlockType::Air);
+            *block = type;
+        }
+    }
+
+    m_BlockCount += delta;
+    RecomputeColumnHeight(x, z, std::max(oldHeight, std::min(y, CHUNK_HEIGHT)));
+    m_MeshBuilt = false;
+    return y;
 }
 
-void Chunk::SetBlock(int x, int y, int z, BlockType type) {
-    if (x < 0 || x >= CHUNK_SIZE || y < 0 || y >= CHUNK_HEIGHT || z < 0 || z >= CHUNK_SIZE) {
+void Chunk::WriteRow(int x, int y, int z, int length, BlockType type, bool onlyIntoAir) {
+    const int x0 = std::max(x, 0);
+    const int x1 = std::min(x + length, CHUNK_SIZE);
+    if (y < 0 || y >= CHUNK_HEIGHT || z < 0 || z >= CHUNK_SIZE || x0 >= x1) {
         return;
     }
 
-    m_Blocks[GetBlockIndex(x, y, z)] = type;
-    if (type != BlockType::Air) {
-        m_IsEmpty = false;
+    BlockType* row = &m_Blocks[GetBlockIndex(0, y, z)];
+    for (int bx = x0; bx < x1; ++bx) {
+        if (onlyIntoAir && row[bx] != BlockType::Air) {
+            continue;
+        }
+        m_BlockCount += (type != BlockType::Air) - (row[bx] != BlockType::Air);
+        row[bx] = type;
+        UpdateColumnHeight(bx, z, y, y + 1, type);
     }
     m_MeshBuilt = false;
 }
 
+void Chunk::UpdateColumnHeight(int x, int z, int y0, int y1, BlockType type) {
+    const uint16_t height = m_Heightmap[z * CHUNK_SIZE + x];
+    if (type != BlockType::Air) {
+        m_Heightmap[z * CHUNK_SIZE + x] = static_cast<uint16_t>(std::max<int>(height, y1));
+    } else if (height > y0 && height <= y1) {
+        // The top block was cleared; everything from y0 up is air now
+        RecomputeColumnHeight(x, z, y0);
+    }
+}
+
+void Chunk::RecomputeColumnHeight(int x, int z, int fromY) {
+    int top = fromY;
+    while (top > 0 && m_Blocks[GetBlockIndex(x, top - 1, z)] == BlockType::Air) {
+        top--;
+    }
+    m_Heightmap[z * CHUNK_SIZE + x] = static_cast<uint16_t>(top);
+}
+
 BlockType Chunk::GetBlock(int x, int y, int z) const {
     if (x < 0 || x >= CHUNK_SIZE || y < 0 || y >= CHUNK_HEIGHT || z < 0 || z >= CHUNK_SIZE) {
         return BlockType::Air;
@@ -76,11 +160,11 @@ BlockType Chunk::GetBlock(int x, int y, int z) const {
     return m_Blocks[GetBlockIndex(x, y, z)];
 }
 
-void Chunk::BuildMesh(World* world) {
+ChunkMeshData Chunk::BuildMesh(const std::function<BlockType(int, int, int)>& worldQuery) {
     const glm::ivec2 chunkPos = GetPosition();
-    const ChunkMeshBuilder::BlockQuery blockQuery = [this, world, chunkPos](int wx, int wy, int wz) {
-        if (world) {
-            return world->GetBlock(wx, wy, wz);
+    const ChunkMeshBuilder::BlockQuery blockQuery = [this, &worldQuery, chunkPos](int wx, int wy, int wz) {
+        if (worldQuery) {
+            return worldQuery(wx, wy, wz);
         }
 
         const int localX = wx - chunkPos.x * CHUNK_SIZE;
@@ -88,44 +172,25 @@ void Chunk::BuildMesh(World* world) {
         return GetBlock(localX, wy, localZ);
     };
 
-    ApplyMeshData(ChunkMeshBuilder::Build(*this, blockQuery));
-}
-
-void Chunk::ApplyMeshData(ChunkMeshData&& meshData) {
-    m_OpaqueIndexCount = static_cast<unsigned int>(meshData.opaqueIndices.size());
-    m_TransparentIndexCount = static_cast<unsigned int>(meshData.transparentIndices.size());
-
-    if (meshData.opaqueVertices.empty() && meshData.transparentVertices.empty()) {
-        m_MeshBuilt = true;
-        LOG_DEBUG("Chunk (" + std::to_string(m_ChunkX) + ", " + std::to_string(m_ChunkZ) + ") is empty");
-        return;
-    }
+    ChunkMeshData meshData = ChunkMeshBuilder::Build(*this, blockQuery, s_MeshFormat);
 
-    if (!meshData.opaqueVertices.empty()) {
-        SetupMeshBuffers(m_OpaqueVAO, m_OpaqueVBO, m_OpaqueEBO, meshData.opaqueVertices, meshData.opaqueIndices);
+    m_MeshVersion++;
+    m_TransparentFaceCount = meshData.transparentFaceCenters.size();
+    m_TransparentFaceCenters = std::make_shared<const std::vector<glm::vec3>>(std::move(meshData.transparentFaceCenters));
+    if (meshData.format == MeshFormat::PackedFaces) {
+        // The sorter reorders these records; the upload keeps its own copy
+        m_TransparentFaces = std::make_shared<const std::vector<uint32_t>>(meshData.transparentFaces);
+    } else {
+        m_TransparentFaces.reset();
     }
 
-    if (!meshData.transparentVertices.empty()) {
-        SetupMeshBuffers(m_TransparentVAO, m_TransparentVBO, m_TransparentEBO, meshData.transparentVertices, meshData.transparentIndices);
+    if (meshData.opaqueIndices.empty() && meshData.transparentIndices.empty() &&
+        meshData.opaqueFaces.empty() && meshData.transparentFaces.empty()) {
+        LOG_DEBUG("Chunk (" + std::to_string(m_ChunkX) + ", " + std::to_string(m_ChunkZ) + ") is empty");
     }
 
     m_MeshBuilt = true;
-}
-
-void Chunk::RenderOpaque() {
-    if (!m_MeshBuilt || m_OpaqueIndexCount == 0) return;
-
-    glBindVertexArray(m_OpaqueVAO);
-    glDrawElements(GL_TRIANGLES, m_OpaqueIndexCount, GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
-}
-
-void Chunk::RenderTransparent() {
-    if (!m_MeshBuilt || m_TransparentIndexCount == 0) return;
-
-    glBindVertexArray(m_TransparentVAO);
-    glDrawElements(GL_TRIANGLES, m_TransparentIndexCount, GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
+    return meshData;
 }
 
 } // namespace Minecraft
@@ -3,15 +3,43 @@
 #include "Block.h"
 #include <glm/glm.hpp>
 #include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
 
 namespace Minecraft {
 
-class World;  // Forward declaration
 struct ChunkMeshData;
 
 constexpr int CHUNK_SIZE = 16;
 constexpr int CHUNK_HEIGHT = 256;
 constexpr int CHUNK_VOLUME = CHUNK_SIZE * CHUNK_HEIGHT * CHUNK_SIZE;
+constexpr int REGION_SIZE = 4;  // Chunks per side of a render region
+
+// Integer division rounding toward negative infinity, for block -> chunk -> region coordinates
+inline int FloorDiv(int value, int divisor) {
+    return (value >= 0) ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+// Uniform location of uRegionOrigin in basic_packed.vert
+constexpr int PACKED_REGION_ORIGIN_LOCATION = 0;
+
+enum class MeshFormat {
+    Vertices,     // Four Vertex structs per face, indexed draw from a VAO
+    PackedFaces   // One 32-bit record per face in an SSBO, expanded in the vertex shader
+};
+
+// Packed face record, coordinates relative to the enclosing region:
+// bits 0-5 x, 6-13 y, 14-19 z, 20-22 face, 23-30 texture layer, 31 flip V
+inline uint32_t PackFace(int regionX, int y, int regionZ, int face, int texIndex, bool flipV) {
+    return static_cast<uint32_t>(regionX) |
+           (static_cast<uint32_t>(y) << 6) |
+           (static_cast<uint32_t>(regionZ) << 14) |
+           (static_cast<uint32_t>(face) << 20) |
+           (static_cast<uint32_t>(texIndex) << 23) |
+           (flipV ? (1u << 31) : 0u);
+}
 
 struct Vertex {
     glm::vec3 position;
@@ -21,39 +49,73 @@ struct Vertex {
     glm::vec3 blockPos;
 };
 
+// Block storage and CPU-side mesh metadata. GPU buffers live in ChunkRenderer on the
+// render thread; BuildMesh hands back the data to upload there.
 class Chunk {
 public:
     Chunk(int chunkX, int chunkZ);
+    Chunk(const Chunk&) = delete;
+    Chunk& operator=(const Chunk&) = delete;
+
+    // Mesh layout used by every chunk; chosen once the GL context is known
+    static void SetMeshFormat(MeshFormat format) { s_MeshFormat = format; }
+    static MeshFormat GetMeshFormat() { return s_MeshFormat; }
     
     void SetBlock(int x, int y, int z, BlockType type);
     BlockType GetBlock(int x, int y, int z) const;
+
+    // Bulk writes for generation. Y ranges are [y0, y1) and everything is clipped to the
+    // chunk; block count and heightmap are updated once per call rather than per block.
+    void FillColumn(int x, int z, int y0, int y1, BlockType type);
+    void FillBox(const glm::ivec3& min, const glm::ivec3& max, BlockType type);  // max exclusive
+    void FillLayers(int y0, int y1, BlockType type);  // Whole horizontal layers, one contiguous run
+
+    struct ColumnLayer {
+        BlockType type;
+        int thickness;
+    };
+
+    // Stack `layers` bottom to top starting at y0; returns the y above the last layer
+    int WriteColumn(int x, int z, int y0, const ColumnLayer* layers, int layerCount);
+
+    // `length` blocks along +x from (x, y, z); with onlyIntoAir, blocks already there are kept
+    void WriteRow(int x, int y, int z, int length, BlockType type, bool onlyIntoAir);
+
+    // One above the highest non-air block of the column, 0 if the column is empty
+    int GetColumnHeight(int x, int z) const { return m_Heightmap[z * CHUNK_SIZE + x]; }
+    int GetBlockCount() const { return m_BlockCount; }  // Non-air blocks
     
-    void BuildMesh(World* world = nullptr);
-    void RenderOpaque();
-    void RenderTransparent();
+    // Mesh the current blocks; the result is tagged with GetMeshVersion(). Blocks
+    // outside the chunk come from `worldQuery` (world coordinates), or are air without one.
+    ChunkMeshData BuildMesh(const std::function<BlockType(int, int, int)>& worldQuery = nullptr);
     
     glm::ivec2 GetPosition() const { return glm::ivec2(m_ChunkX, m_ChunkZ); }
     bool IsMeshBuilt() const { return m_MeshBuilt; }
-    bool IsEmpty() const { return m_IsEmpty; }
+    bool IsEmpty() const { return m_BlockCount == 0; }
+    bool HasTransparentGeometry() const { return m_MeshBuilt && m_TransparentFaceCount > 0; }
+    uint32_t GetMeshVersion() const { return m_MeshVersion; }
+    std::shared_ptr<const std::vector<glm::vec3>> GetTransparentFaceCenters() const { return m_TransparentFaceCenters; }
+    std::shared_ptr<const std::vector<uint32_t>> GetTransparentFaces() const { return m_TransparentFaces; }
+    glm::ivec3 GetRegionOrigin() const;
 
 private:
     int GetBlockIndex(int x, int y, int z) const;
-    void ApplyMeshData(ChunkMeshData&& meshData);
+    void UpdateColumnHeight(int x, int z, int y0, int y1, BlockType type);
+    void RecomputeColumnHeight(int x, int z, int fromY);
+
+    static MeshFormat s_MeshFormat;
     
     int m_ChunkX, m_ChunkZ;
     std::array<BlockType, CHUNK_VOLUME> m_Blocks;
+    std::array<uint16_t, CHUNK_SIZE * CHUNK_SIZE> m_Heightmap{};  // Indexed z * CHUNK_SIZE + x
+    int m_BlockCount = 0;
 
-    unsigned int m_OpaqueVAO = 0;
-    unsigned int m_OpaqueVBO = 0;
-    unsigned int m_OpaqueEBO = 0;
-    unsigned int m_TransparentVAO = 0;
-    unsigned int m_TransparentVBO = 0;
-    unsigned int m_TransparentEBO = 0;
-    unsigned int m_OpaqueIndexCount = 0;
-    unsigned int m_TransparentIndexCount = 0;
+    size_t m_TransparentFaceCount = 0;
+    uint32_t m_MeshVersion = 0;
+    std::shared_ptr<const std::vector<glm::vec3>> m_TransparentFaceCenters;
+    std::shared_ptr<const std::vector<uint32_t>> m_TransparentFaces;  // Packed path only
 
     bool m_MeshBuilt = false;
-    bool m_IsEmpty = true;
 };
 
 } // namespace Minecraft
@@ -0,0 +1,466 @@
+#include "ChunkGenerationPool.h"
+#include "TerrainFieldCache.h"
+#include "WorldGeneration.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace Minecraft {
+
+namespace {
+
+// The chunk's part of its region's field tile, filling the tile if it is not cached
+void ReadChunkSurface(const ChunkPos& pos, ChunkSurface& surface) {
+    const ChunkPos region(FloorDiv(pos.x, REGION_SIZE), FloorDiv(pos.z, REGION_SIZE));
+    const std::shared_ptr<const TerrainTile> tile = WorldGeneration::GetFieldCache().Get(region);
+    const int tileX = (pos.x - region.x * REGION_SIZE) * CHUNK_SIZE;
+    const int tileZ = (pos.z - region.z * REGION_SIZE) * CHUNK_SIZE;
+    for (int z = 0; z < CHUNK_SIZE; ++z) {
+        const int index = TerrainTile::Index(tileX, tileZ + z);
+        std::copy_n(tile->heights.begin() + index, CHUNK_SIZE, surface.heights.begin() + z * CHUNK_SIZE);
+        std::copy_n(tile->surfaces.begin() + index, CHUNK_SIZE, surface.surfaces.begin() + z * CHUNK_SIZE);
+        std::copy_n(tile->biomes.begin() + index, CHUNK_SIZE, surface.biomes.begin() + z * CHUNK_SIZE);
+    }
+}
+
+} // namespace
+
+ChunkGenerationPool::ChunkGenerationPool(int workerCount) {
+    const int count = workerCount > 0 ? workerCount : GetDefaultWorkerCount();
+    for (int i = 0; i < count; ++i) {
+        m_Workers.emplace_back(&ChunkGenerationPool::WorkerMain, this);
+    }
+}
+
+ChunkGenerationPool::~ChunkGenerationPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_ShuttingDown = true;
+    }
+    m_Cv.notify_all();
+
+    for (std::thread& worker : m_Workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+int ChunkGenerationPool::GetDefaultWorkerCount() {
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+void ChunkGenerationPool::SetFocus(const ChunkPos& center, const glm::vec2& forward, int radius) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_FocusCenter = center;
+    m_FocusForward = glm::dot(forward, forward) > 0.0f ? glm::normalize(forward) : glm::vec2(0.0f);
+    m_FocusRadius = radius;
+
+    // Cancel requests that left the radius and drop pipeline state beyond the neighbour ring
+    for (auto it = m_Pending.begin(); it != m_Pending.end();) {
+        PendingChunk& entry = it->second;
+        if (entry.target == Stage::Finalized && entry.stage != Stage::Finalized && !IsInFocus(it->first)) {
+            entry.target = Stage::Decorated;
+            m_Tracked.erase(it->first);
+            m_Stats.cancelled++;
+        }
+        if (!entry.running && !IsInFocus(it->first, 1)) {
+            it = m_Pending.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // Jobs of dropped chunks go, the rest are re-scored
+    auto queueEnd = std::remove_if(m_Queue.begin(), m_Queue.end(), [this](const Job& job) {
+        return m_Pending.find(job.pos) == m_Pending.end();
+    });
+    m_Queue.erase(queueEnd, m_Queue.end());
+    for (Job& job : m_Queue) {
+        job.priority = GetJobPriority(job.pos, m_Pending[job.pos].stage);
+    }
+    std::make_heap(m_Queue.begin(), m_Queue.end(), RunsAfter);
+
+    auto readyEnd = std::remove_if(m_Ready.begin(), m_Ready.end(), [this](const GeneratedChunkResult& result) {
+        if (IsInFocus(result.pos)) {
+            return false;
+        }
+        m_Tracked.erase(result.pos);
+        m_Stats.wasted++;
+        return true;
+    });
+    m_Ready.erase(readyEnd, m_Ready.end());
+}
+
+void ChunkGenerationPool::Queue(const std::vector<ChunkPos>& positions) {
+    size_t queued = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        for (const ChunkPos& pos : positions) {
+            if (!IsInFocus(pos) || !m_Tracked.insert(pos).second) {
+                continue;
+            }
+            queued += Request(pos);
+        }
+    }
+
+    if (queued == 1) {
+        m_Cv.notify_one();
+    } else if (queued > 1) {
+        m_Cv.notify_all();
+    }
+}
+
+void ChunkGenerationPool::CountWasted() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stats.wasted++;
+}
+
+ChunkGenerationPool::Stats ChunkGenerationPool::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Stats;
+}
+
+bool ChunkGenerationPool::RunsAfter(const Job& lhs, const Job& rhs) {
+    return lhs.priority > rhs.priority;
+}
+
+// Distance in chunks, stretched up to 2x for chunks behind the viewer
+float ChunkGenerationPool::GetPriority(const ChunkPos& pos) const {
+    const glm::vec2 offset(static_cast<float>(pos.x - m_FocusCenter.x), static_cast<float>(pos.z - m_FocusCenter.z));
+    const float distance = glm::length(offset);
+    if (distance == 0.0f) {
+        return 0.0f;
+    }
+    const float facing = glm::dot(offset / distance, m_FocusForward);
+    return distance * (1.5f - 0.5f * facing);
+}
+
+// Later stages first, so started chunks are finished before new ones begin
+float ChunkGenerationPool::GetJobPriority(const ChunkPos& pos, Stage stage) const {
+    return GetPriority(pos) - 0.5f * static_cast<float>(stage);
+}
+
+bool ChunkGenerationPool::IsInFocus(const ChunkPos& pos, int margin) const {
+    if (m_FocusRadius == INT_MAX) {
+        return true;
+    }
+    const int radius = m_FocusRadius + margin;
+    return std::abs(pos.x - m_FocusCenter.x) <= radius && std::abs(pos.z - m_FocusCenter.z) <= radius;
+}
+
+size_t ChunkGenerationPool::Request(const ChunkPos& pos) {
+    PendingChunk& entry = m_Pending[pos];
+    if (entry.stage == Stage::Finalized) {
+        // Delivered before and unloaded since; generate it again
+        entry.chunk.reset();
+        entry.staging = DecorationStaging();
+        entry.stage = Stage::None;
+    }
+    entry.target = Stage::Finalized;
+
+    size_t queued = TrySchedule(pos) ? 1 : 0;
+    for (int dz = -1; dz <= 1; ++dz) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            if (dx == 0 && dz == 0) {
+                continue;
+            }
+            // Default target: decorated, so this chunk can finalize
+            const ChunkPos neighbour(pos.x + dx, pos.z + dz);
+            m_Pending.emplace(neighbour, PendingChunk());
+            queued += TrySchedule(neighbour) ? 1 : 0;
+        }
+    }
+    return queued;
+}
+
+bool ChunkGenerationPool::IsRunnable(const ChunkPos& pos, const PendingChunk& entry) const {
+    if (entry.running || entry.stage >= entry.target) {
+        return false;
+    }
+    return entry.stage != Stage::Decorated || NeighboursDecorated(pos);
+}
+
+bool ChunkGenerationPool::NeighboursDecorated(const ChunkPos& pos) const {
+    for (int dz = -1; dz <= 1; ++dz) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            auto it = m_Pending.find(ChunkPos(pos.x + dx, pos.z + dz));
+            if (it == m_Pending.end() || it->second.stage < Stage::Decorated) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool ChunkGenerationPool::TrySchedule(const ChunkPos& pos) {
+    auto it = m_Pending.find(pos);
+    if (it == m_Pending.end() || it->second.queued || !IsRunnable(pos, it->second)) {
+        return false;
+    }
+    it->second.queued = true;
+    m_Queue.push_back({pos, GetJobPriority(pos, it->second.stage)});
+    std::push_heap(m_Queue.begin(), m_Queue.end(), RunsAfter);
+    return true;
+}
+
+void ChunkGenerationPool::TakeResults(std::vector<GeneratedChunkResult>& results, size_t maxCount) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    const size_t count = std::min(maxCount, m_Ready.size());
+    results.reserve(results.size() + count);
+    for (size_t i = 0; i < count; ++i) {
+        m_Tracked.erase(m_Ready.front().pos);
+        results.push_back(std::move(m_Ready.front()));
+        m_Ready.pop_front();
+    }
+}
+
+size_t ChunkGenerationPool::GetBacklog() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Tracked.size();
+}
+
+size_t ChunkGenerationPool::EstimateMemoryBytes() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    size_t bytes = 0;
+    for (const auto& [pos, entry] : m_Pending) {
+        (void)pos;
+        if (entry.chunk) {
+            bytes += sizeof(Chunk);
+        }
+        for (const std::vector<StagedBlock>& blocks : entry.staging.neighbours) {
+            bytes += blocks.capacity() * sizeof(StagedBlock);
+        }
+    }
+    bytes += m_Ready.size() * sizeof(Chunk);
+    return bytes + m_ReadySurfaces.size() * sizeof(ChunkSurfaceResult);
+}
+
+void ChunkGenerationPool::QueueSurfaces(const std::vector<ChunkPos>& positions) {
+    size_t queued = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_SurfaceQueue.clear();
+        for (const ChunkPos& pos : positions) {
+            if (m_SurfacesInFlight.find(pos) == m_SurfacesInFlight.end()) {
+                m_SurfaceQueue.push_back(pos);
+            }
+        }
+        queued = m_SurfaceQueue.size();
+    }
+
+    if (queued == 1) {
+        m_Cv.notify_one();
+    } else if (queued > 1) {
+        m_Cv.notify_all();
+    }
+}
+
+void ChunkGenerationPool::TakeSurfaces(std::vector<ChunkSurfaceResult>& results) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    results.reserve(results.size() + m_ReadySurfaces.size());
+    for (ChunkSurfaceResult& result : m_ReadySurfaces) {
+        m_SurfacesInFlight.erase(result.pos);
+        results.push_back(std::move(result));
+    }
+    m_ReadySurfaces.clear();
+}
+
+void ChunkGenerationPool::SetStageTimingEnabled(bool enabled) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_RecordStageTimings = enabled;
+}
+
+ChunkGenerationPool::StageTimings ChunkGenerationPool::TakeStageTimings() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    StageTimings timings = std::move(m_StageTimings);
+    m_StageTimings = StageTimings();
+    return timings;
+}
+
+uint64_t ChunkGenerationPool::HashChunk(const Chunk& chunk, const ChunkPos& pos) {
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](uint64_t value) {
+        hash ^= value;
+        hash *= 1099511628211ull;  // FNV-1a
+    };
+    mix(static_cast<uint32_t>(pos.x));
+    mix(static_cast<uint32_t>(pos.z));
+    for (int y = 0; y < CHUNK_HEIGHT; ++y) {
+        for (int z = 0; z < CHUNK_SIZE; ++z) {
+            for (int x = 0; x < CHUNK_SIZE; ++x) {
+                mix(static_cast<uint64_t>(chunk.GetBlock(x, y, z)));
+            }
+        }
+    }
+    return hash;
+}
+
+ChunkGenerationPool::BenchmarkResult ChunkGenerationPool::RunBenchmark(int workerCount, int radius) {
+    BenchmarkResult result;
+    result.chunks = (radius * 2 + 1) * (radius * 2 + 1);
+
+    // Every run samples its own noise, otherwise later runs would only measure cache hits
+    WorldGeneration::GetFieldCache().Clear();
+
+    ChunkGenerationPool pool(workerCount);
+    result.workers = pool.GetWorkerCount();
+
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    std::vector<ChunkPos> positions;
+    for (int z = -radius; z <= radius; ++z) {
+        for (int x = -radius; x <= radius; ++x) {
+            positions.emplace_back(x, z);
+        }
+    }
+    pool.Queue(positions);
+
+    std::vector<GeneratedChunkResult> generated;
+    generated.reserve(result.chunks);
+    while (static_cast<int>(generated.size()) < result.chunks) {
+        const size_t before = generated.size();
+        pool.TakeResults(generated, static_cast<size_t>(result.chunks));
+        if (generated.size() == before) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+    result.seconds = std::chrono::duration<float>(Clock::now() - start).count();
+    result.chunksPerSecond = result.seconds > 0.0f ? static_cast<float>(result.chunks) / result.seconds : 0.0f;
+
+    // Summed, so completion order does not matter; equal across worker counts if generation is deterministic
+    for (const GeneratedChunkResult& chunk : generated) {
+        result.checksum += HashChunk(*chunk.chunk, chunk.pos);
+    }
+    return result;
+}
+
+void ChunkGenerationPool::WorkerMain() {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    while (true) {
+        m_Cv.wait(lock, [this]() {
+            return m_ShuttingDown || !m_Queue.empty() || !m_SurfaceQueue.empty();
+        });
+
+        if (m_ShuttingDown) {
+            return;
+        }
+
+        // Known surfaces only when no chunk stage is waiting; most hit tiles the chunks filled
+        if (m_Queue.empty()) {
+            ChunkSurfaceResult result;
+            result.pos = m_SurfaceQueue.front();
+            m_SurfaceQueue.pop_front();
+            m_SurfacesInFlight.insert(result.pos);
+            lock.unlock();
+            ReadChunkSurface(result.pos, result.surface);
+            lock.lock();
+            m_ReadySurfaces.push_back(std::move(result));
+            continue;
+        }
+
+        std::pop_heap(m_Queue.begin(), m_Queue.end(), RunsAfter);
+        const ChunkPos pos = m_Queue.back().pos;
+        m_Queue.pop_back();
+
+        auto it = m_Pending.find(pos);
+        if (it == m_Pending.end()) {
+            continue;
+        }
+        // Entries are never erased while running and map nodes do not move, so this stays valid
+        PendingChunk& entry = it->second;
+        entry.queued = false;
+        if (!IsRunnable(pos, entry)) {
+            continue;  // A neighbour was reset after this job was queued
+        }
+        entry.running = true;
+        const Stage stage = entry.stage;
+
+        // Finalization reads what the neighbours staged for this chunk; they are done writing it
+        std::vector<std::vector<StagedBlock>> incoming;
+        if (stage == Stage::Decorated) {
+            for (int dz = -1; dz <= 1; ++dz) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    if (dx == 0 && dz == 0) {
+                        continue;
+                    }
+                    const PendingChunk& neighbour = m_Pending.at(ChunkPos(pos.x + dx, pos.z + dz));
+                    const std::vector<StagedBlock>& blocks = neighbour.staging.neighbours[DecorationStaging::Index(-dx, -dz)];
+                    if (!blocks.empty()) {
+                        incoming.push_back(blocks);
+                    }
+                }
+            }
+        }
+        const bool timed = m_RecordStageTimings;
+        lock.unlock();
+
+        const std::chrono::steady_clock::time_point stageStart = std::chrono::steady_clock::now();
+        std::unique_ptr<Chunk> terrain;
+        DecorationStaging staging;
+        switch (stage) {
+        case Stage::None:
+            terrain = std::make_unique<Chunk>(pos.x, pos.z);
+            WorldGeneration::GenerateTerrain(*terrain);
+            break;
+        case Stage::Terrain:
+            WorldGeneration::Decorate(*entry.chunk, staging);
+            break;
+        default:
+            for (const std::vector<StagedBlock>& blocks : incoming) {
+                WorldGeneration::ApplyStaged(*entry.chunk, blocks);
+            }
+            break;
+        }
+        const float stageMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - stageStart).count();
+
+        lock.lock();
+        entry.running = false;
+        if (timed && stage == Stage::None) {
+            m_StageTimings.terrainMs.push_back(stageMs);
+        } else if (timed && stage == Stage::Terrain) {
+            m_StageTimings.decorateMs.push_back(stageMs);
+        } else if (timed) {
+            m_StageTimings.finalizeMs.push_back(stageMs);
+        }
+        if (stage == Stage::None) {
+            entry.chunk = std::move(terrain);
+            entry.stage = Stage::Terrain;
+        } else if (stage == Stage::Terrain) {
+            entry.staging = std::move(staging);
+            entry.stage = Stage::Decorated;
+        } else {
+            entry.stage = Stage::Finalized;
+            if (entry.target == Stage::Finalized) {
+                m_Ready.push_back({pos, std::move(entry.chunk)});
+                m_Stats.generated++;
+            } else {
+                entry.chunk.reset();  // Cancelled while being finalized
+            }
+        }
+
+        // SetFocus skipped this entry while it ran; drop it now if it left the neighbour ring
+        if (!IsInFocus(pos, 1)) {
+            m_Pending.erase(it);
+            continue;
+        }
+
+        // This chunk's next stage, or neighbours waiting for it to be decorated
+        size_t queued = TrySchedule(pos) ? 1 : 0;
+        if (entry.stage == Stage::Decorated) {
+            for (int dz = -1; dz <= 1; ++dz) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    if (dx != 0 || dz != 0) {
+                        queued += TrySchedule(ChunkPos(pos.x + dx, pos.z + dz)) ? 1 : 0;
+                    }
+                }
+            }
+        }
+        // This worker takes one of them on its next pass
+        if (queued > 1) {
+            m_Cv.notify_all();
+        }
+    }
+}
+
+} // namespace Minecraft
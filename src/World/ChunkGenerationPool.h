@@ -0,0 +1,151 @@
+#pragma once
+
+#include "World.h"
+#include "WorldGeneration.h"
+#include <climits>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Minecraft {
+
+// Worker threads that run the generation stages (see WorldGeneration) for
+// requested chunks. Each pending chunk advances one stage per job: terrain,
+// decoration, then finalization once its eight neighbours are decorated, so the
+// neighbours of a requested chunk are taken through decoration as well. Any
+// worker may run any stage; a chunk's contents depend only on its position, so
+// the result is the same for any worker count.
+//
+// The queue is a heap ordered by distance to the focus chunk, with chunks in
+// front of the viewer and later stages first. Moving the focus re-sorts it and
+// cancels requested chunks that left the radius before they were finished;
+// chunks that leave while waiting to be taken are dropped and counted as wasted.
+class ChunkGenerationPool {
+public:
+    using Stats = ChunkGenerationStats;
+
+    struct BenchmarkResult {
+        int workers = 0;
+        int chunks = 0;
+        float seconds = 0.0f;
+        float chunksPerSecond = 0.0f;
+        uint64_t checksum = 0;  // Order-independent hash of every generated block
+    };
+
+    // 0 workers = one per hardware thread
+    explicit ChunkGenerationPool(int workerCount = 0);
+    ~ChunkGenerationPool();
+    ChunkGenerationPool(const ChunkGenerationPool&) = delete;
+    ChunkGenerationPool& operator=(const ChunkGenerationPool&) = delete;
+
+    static int GetDefaultWorkerCount();
+    int GetWorkerCount() const { return static_cast<int>(m_Workers.size()); }
+
+    // Re-prioritize around `center` and cancel work outside `radius` (square, in chunks).
+    // `forward` is the horizontal view direction; chunks ahead are generated first.
+    void SetFocus(const ChunkPos& center, const glm::vec2& forward, int radius);
+
+    // Request chunks unless they are already in the pipeline or waiting to be taken
+    void Queue(const std::vector<ChunkPos>& positions);
+
+    // A taken chunk the caller had to throw away after all
+    void CountWasted();
+
+    Stats GetStats() const;
+
+    // Move up to `maxCount` finished chunks into `results`; they can be queued again afterwards
+    void TakeResults(std::vector<GeneratedChunkResult>& results, size_t maxCount);
+
+    // Requested chunks not taken yet, finished or not
+    size_t GetBacklog() const;
+
+    // Voxels, staged decoration and surfaces held by the pipeline, including decorated-only
+    // neighbours and finished chunks not taken yet
+    size_t EstimateMemoryBytes() const;
+
+    // Request the known-tier surfaces of `positions`, nearest first. Replaces the requests no
+    // worker has started yet. Surfaces are read only while no chunk stage is waiting.
+    void QueueSurfaces(const std::vector<ChunkPos>& positions);
+
+    // Move every finished surface into `results`; they can be requested again afterwards
+    void TakeSurfaces(std::vector<ChunkSurfaceResult>& results);
+
+    // Wall time of every stage run while recording is enabled, in milliseconds
+    struct StageTimings {
+        std::vector<float> terrainMs;
+        std::vector<float> decorateMs;
+        std::vector<float> finalizeMs;
+    };
+
+    void SetStageTimingEnabled(bool enabled);
+    StageTimings TakeStageTimings();  // Hands over the samples recorded so far
+
+    // Generate the (2 * radius + 1)^2 chunks around the origin with a fresh pool
+    static BenchmarkResult RunBenchmark(int workerCount, int radius);
+
+    // FNV-1a over the position and every block; sums of it are the benchmark checksum
+    static uint64_t HashChunk(const Chunk& chunk, const ChunkPos& pos);
+
+private:
+    // Last stage a pending chunk completed
+    enum class Stage : uint8_t {
+        None,
+        Terrain,
+        Decorated,
+        Finalized
+    };
+
+    // A chunk in the pipeline. Neighbours that are only needed so a requested chunk
+    // can finalize stop at Decorated and stay around for later requests.
+    struct PendingChunk {
+        std::unique_ptr<Chunk> chunk;   // Moved to m_Ready once finalized
+        DecorationStaging staging;      // Blocks this chunk's decoration left for its neighbours
+        Stage stage = Stage::None;
+        Stage target = Stage::Decorated;  // Finalized if requested
+        bool queued = false;   // Has a job in m_Queue
+        bool running = false;  // A worker is running its next stage
+    };
+
+    struct Job {
+        ChunkPos pos;
+        float priority = 0.0f;  // Lower runs first
+    };
+
+    static bool RunsAfter(const Job& lhs, const Job& rhs);  // Heap order: lowest priority value on top
+    float GetPriority(const ChunkPos& pos) const;
+    float GetJobPriority(const ChunkPos& pos, Stage stage) const;
+    bool IsInFocus(const ChunkPos& pos, int margin = 0) const;
+
+    // Locked helpers
+    size_t Request(const ChunkPos& pos);
+    bool IsRunnable(const ChunkPos& pos, const PendingChunk& entry) const;
+    bool NeighboursDecorated(const ChunkPos& pos) const;
+    bool TrySchedule(const ChunkPos& pos);
+
+    void WorkerMain();
+
+    std::unordered_map<ChunkPos, PendingChunk> m_Pending;
+    std::vector<Job> m_Queue;  // Heap, see GetJobPriority
+    ChunkPos m_FocusCenter = {0, 0};
+    glm::vec2 m_FocusForward = glm::vec2(0.0f);
+    int m_FocusRadius = INT_MAX;
+    Stats m_Stats;
+    bool m_RecordStageTimings = false;
+    StageTimings m_StageTimings;
+    std::deque<GeneratedChunkResult> m_Ready;
+    std::unordered_set<ChunkPos> m_Tracked;  // Requested and not taken yet
+    std::deque<ChunkPos> m_SurfaceQueue;
+    std::unordered_set<ChunkPos> m_SurfacesInFlight;  // Being read, or read and not taken yet
+    std::vector<ChunkSurfaceResult> m_ReadySurfaces;
+    bool m_ShuttingDown = false;
+    mutable std::mutex m_Mutex;
+    std::condition_variable m_Cv;
+    std::vector<std::thread> m_Workers;
+};
+
+} // namespace Minecraft
@@ -36,15 +36,29 @@ bool ShouldRenderFace(BlockType block, BlockType neighbor) {
     return false;
 }
 
-void AddFace(ChunkMeshData& meshData, const glm::vec3& pos, int face, BlockType blockType) {
+void AddFace(ChunkMeshData& meshData, const glm::vec3& pos, const glm::ivec3& regionOrigin, int face, BlockType blockType) {
     const BlockData& data = Block::GetBlockData(blockType);
-    std::vector<Vertex>& vertices = IsTransparentBlock(blockType) ? meshData.transparentVertices : meshData.opaqueVertices;
-    std::vector<unsigned int>& indices = IsTransparentBlock(blockType) ? meshData.transparentIndices : meshData.opaqueIndices;
+    const bool transparent = IsTransparentBlock(blockType);
 
     uint8_t texIndex = data.sideTexture;
     if (face == 4) texIndex = data.topTexture;
     else if (face == 5) texIndex = data.bottomTexture;
 
+    if (transparent) {
+        meshData.transparentFaceCenters.push_back(pos + (FACE_VERTICES[face][0] + FACE_VERTICES[face][2]) * 0.5f);
+    }
+
+    if (meshData.format == MeshFormat::PackedFaces) {
+        const bool flipV = blockType == BlockType::Grass && face >= 0 && face <= 3;
+        const uint32_t record = PackFace(static_cast<int>(pos.x) - regionOrigin.x, static_cast<int>(pos.y),
+                                         static_cast<int>(pos.z) - regionOrigin.z, face, texIndex, flipV);
+        (transparent ? meshData.transparentFaces : meshData.opaqueFaces).push_back(record);
+        return;
+    }
+
+    std::vector<Vertex>& vertices = transparent ? meshData.transparentVertices : meshData.opaqueVertices;
+    std::vector<unsigned int>& indices = transparent ? meshData.transparentIndices : meshData.opaqueIndices;
+
     float lighting = 1.0f;
     if (face == 5) lighting = 0.5f;
     else if (face == 2 || face == 3) lighting = 0.8f;
@@ -74,17 +88,15 @@ void AddFace(ChunkMeshData& meshData, const glm::vec3& pos, int face, BlockType
 
 } // namespace
 
-ChunkMeshData ChunkMeshBuilder::Build(const Chunk& chunk, const BlockQuery& blockQuery) {
+ChunkMeshData ChunkMeshBuilder::Build(const Chunk& chunk, const BlockQuery& blockQuery, MeshFormat format) {
     ChunkMeshData meshData;
+    meshData.format = format;
     const glm::ivec2 chunkPos = chunk.GetPosition();
+    const glm::ivec3 regionOrigin = chunk.GetRegionOrigin();
 
     for (int x = 0; x < CHUNK_SIZE; ++x) {
         for (int z = 0; z < CHUNK_SIZE; ++z) {
-            int maxY = CHUNK_HEIGHT - 1;
-            while (maxY >= 0 && chunk.GetBlock(x, maxY, z) == BlockType::Air) {
-                maxY--;
-            }
-
+            const int maxY = chunk.GetColumnHeight(x, z) - 1;
             if (maxY < 0) {
                 continue;
             }
@@ -101,22 +113,22 @@ ChunkMeshData ChunkMeshBuilder::Build(const Chunk& chunk, const BlockQuery& bloc
                 const glm::vec3 pos(worldX, worldY, worldZ);
 
                 BlockType neighbor = blockQuery(worldX, worldY, worldZ + 1);
-                if (ShouldRenderFace(block, neighbor)) AddFace(meshData, pos, 0, block);
+                if (ShouldRenderFace(block, neighbor)) AddFace(meshData, pos, regionOrigin, 0, block);
 
                 neighbor = blockQuery(worldX, worldY, worldZ - 1);
-                if (ShouldRenderFace(block, neighbor)) AddFace(meshData, pos, 1, block);
+                if (ShouldRenderFace(block, neighbor)) AddFace(meshData, pos, regionOrigin, 1, block);
 
                 neighbor = blockQuery(worldX + 1, worldY, worldZ);
-                if (ShouldRenderFace(block, neighbor)) AddFace(meshData, pos, 2, block);
+                if (ShouldRenderFace(block, neighbor)) AddFace(meshData, pos, regionOrigin, 2, block);
 
                 neighbor = blockQuery(worldX - 1, worldY, worldZ);
-                if (ShouldRenderFace(block, neighbor)) AddFace(meshData, pos, 3, block);
+                if (ShouldRenderFace(block, neighbor)) AddFace(meshData, pos, regionOrigin, 3, block);
 
                 neighbor = blockQuery(worldX, worldY + 1, worldZ);
-                if (ShouldRenderFace(block, neighbor)) AddFace(meshData, pos, 4, block);
+                if (ShouldRenderFace(block, neighbor)) AddFace(meshData, pos, regionOrigin, 4, block);
 
                 neighbor = blockQuery(worldX, worldY - 1, worldZ);
-                if (ShouldRenderFace(block, neighbor)) AddFace(meshData, pos, 5, block);
+                if (ShouldRenderFace(block, neighbor)) AddFace(meshData, pos, regionOrigin, 5, block);
             }
         }
     }
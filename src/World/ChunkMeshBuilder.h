@@ -7,17 +7,22 @@
 namespace Minecraft {
 
 struct ChunkMeshData {
+    MeshFormat format = MeshFormat::Vertices;
     std::vector<Vertex> opaqueVertices;
     std::vector<unsigned int> opaqueIndices;
     std::vector<Vertex> transparentVertices;
     std::vector<unsigned int> transparentIndices;
+    std::vector<glm::vec3> transparentFaceCenters;  // One per transparent quad, used for depth sorting
+    std::vector<uint32_t> opaqueFaces;              // MeshFormat::PackedFaces only
+    std::vector<uint32_t> transparentFaces;
 };
 
 class ChunkMeshBuilder {
 public:
     using BlockQuery = std::function<BlockType(int, int, int)>;
 
-    static ChunkMeshData Build(const Chunk& chunk, const BlockQuery& blockQuery);
+    static ChunkMeshData Build(const Chunk& chunk, const BlockQuery& blockQuery,
+                               MeshFormat format = MeshFormat::Vertices);
 };
 
 } // namespace Minecraft
@@ -0,0 +1,241 @@
+#include "ChunkRenderer.h"
+#include "../Render/FramePacket.h"
+#include "../Render/RenderState.h"
+#include <GL/glew.h>
+
+namespace Minecraft {
+
+namespace {
+
+void SetupMeshBuffers(unsigned int& vao,
+                      unsigned int& vbo,
+                      unsigned int& ebo,
+                      const std::vector<Vertex>& vertices,
+                      const std::vector<unsigned int>& indices) {
+    if (vao == 0) {
+        glGenVertexArrays(1, &vao);
+        glGenBuffers(1, &vbo);
+        glGenBuffers(1, &ebo);
+    }
+
+    RenderState::BindVertexArray(vao);
+
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+
+    ChunkRenderer::SetupVertexLayout();
+
+    RenderState::BindVertexArray(0);
+}
+
+void SetupFaceBuffer(unsigned int& ssbo, const std::vector<uint32_t>& faces) {
+    if (ssbo == 0) {
+        glGenBuffers(1, &ssbo);
+    }
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, ssbo);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, faces.size() * sizeof(uint32_t), faces.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+// Core profile needs a bound VAO even when the vertex shader reads no attributes
+unsigned int GetEmptyVAO() {
+    static unsigned int emptyVAO = 0;
+    if (emptyVAO == 0) {
+        glGenVertexArrays(1, &emptyVAO);
+    }
+    return emptyVAO;
+}
+
+void DrawMesh(const ChunkGpuMesh& mesh, bool transparent) {
+    const unsigned int count = transparent ? mesh.transparentIndexCount : mesh.opaqueIndexCount;
+    if (count == 0) {
+        return;
+    }
+
+    if (mesh.format == MeshFormat::PackedFaces) {
+        const unsigned int ssbo = transparent ? mesh.transparentFaceSSBO : mesh.opaqueFaceSSBO;
+        if (ssbo != 0) {
+            ChunkRenderer::DrawPackedFaces(ssbo, count, mesh.regionOrigin);
+        }
+        return;
+    }
+
+    const unsigned int vao = transparent ? mesh.transparentVAO : mesh.opaqueVAO;
+    if (vao != 0) {
+        // The VAO stays bound; RenderState skips the rebind when the next draw uses it too
+        RenderState::BindVertexArray(vao);
+        RenderState::DrawElements(GL_TRIANGLES, count);
+    }
+}
+
+} // namespace
+
+ChunkRenderer::~ChunkRenderer() {
+    for (auto& [pos, mesh] : m_Meshes) {
+        (void)pos;
+        DeleteMesh(mesh);
+    }
+}
+
+void ChunkRenderer::SetupVertexLayout() {
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoord));
+
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texIndex));
+
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, lighting));
+
+    glEnableVertexAttribArray(4);
+    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, blockPos));
+}
+
+void ChunkRenderer::DrawPackedFaces(unsigned int ssbo, unsigned int vertexCount, const glm::ivec3& origin) {
+    RenderState::BindVertexArray(GetEmptyVAO());
+    RenderState::BindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, ssbo);
+    glUniform3i(PACKED_REGION_ORIGIN_LOCATION, origin.x, origin.y, origin.z);
+    RenderState::CountCall();
+    RenderState::DrawArrays(GL_TRIANGLES, 0, vertexCount);
+}
+
+void ChunkRenderer::Execute(RenderCommand& command) {
+    switch (command.type) {
+    case RenderCommandType::UploadMesh:
+        Upload(command.pos, command.meshVersion, command.mesh);
+        break;
+    case RenderCommandType::ReleaseMesh:
+        Release(command.pos);
+        break;
+    case RenderCommandType::UpdateTransparentOrder:
+        UpdateTransparentOrder(command);
+        break;
+    default:
+        break;
+    }
+}
+
+void ChunkRenderer::RenderOpaque(const std::vector<ChunkPos>& visibleChunks, bool regionBatching) {
+    if (regionBatching) {
+        m_VisibleChunks.clear();
+        m_VisibleChunks.insert(visibleChunks.begin(), visibleChunks.end());
+        m_RegionBatcher.Update(m_Meshes);
+        m_RegionBatcher.RenderOpaque(m_VisibleChunks);
+    } else {
+        m_RegionBatcher.Clear();
+    }
+
+    for (const ChunkPos& pos : visibleChunks) {
+        auto it = m_Meshes.find(pos);
+        if (it != m_Meshes.end() && !m_RegionBatcher.IsBatched(pos)) {
+            DrawMesh(it->second, false);
+        }
+    }
+}
+
+void ChunkRenderer::RenderTransparent(const std::vector<ChunkPos>& chunks) {
+    for (const ChunkPos& pos : chunks) {
+        auto it = m_Meshes.find(pos);
+        if (it != m_Meshes.end()) {
+            DrawMesh(it->second, true);
+        }
+    }
+}
+
+void ChunkRenderer::Upload(const ChunkPos& pos, uint32_t meshVersion, ChunkMeshData& meshData) {
+    ChunkGpuMesh& mesh = m_Meshes[pos];
+    if (mesh.format != meshData.format) {
+        DeleteMesh(mesh);
+    }
+
+    const ChunkPos region = RegionBatcher::GetRegion(pos);
+    mesh.format = meshData.format;
+    mesh.meshVersion = meshVersion;
+    mesh.regionOrigin = glm::ivec3(region.x * REGION_SIZE * CHUNK_SIZE, 0, region.z * REGION_SIZE * CHUNK_SIZE);
+    m_RegionBatcher.Invalidate(pos);
+
+    if (meshData.format == MeshFormat::PackedFaces) {
+        mesh.opaqueIndexCount = static_cast<unsigned int>(meshData.opaqueFaces.size() * 6);
+        mesh.transparentIndexCount = static_cast<unsigned int>(meshData.transparentFaces.size() * 6);
+
+        if (!meshData.opaqueFaces.empty()) {
+            SetupFaceBuffer(mesh.opaqueFaceSSBO, meshData.opaqueFaces);
+        }
+        if (!meshData.transparentFaces.empty()) {
+            SetupFaceBuffer(mesh.transparentFaceSSBO, meshData.transparentFaces);
+        }
+        return;
+    }
+
+    mesh.opaqueIndexCount = static_cast<unsigned int>(meshData.opaqueIndices.size());
+    mesh.transparentIndexCount = static_cast<unsigned int>(meshData.transparentIndices.size());
+
+    if (!meshData.opaqueVertices.empty()) {
+        SetupMeshBuffers(mesh.opaqueVAO, mesh.opaqueVBO, mesh.opaqueEBO, meshData.opaqueVertices, meshData.opaqueIndices);
+    }
+    if (!meshData.transparentVertices.empty()) {
+        SetupMeshBuffers(mesh.transparentVAO, mesh.transparentVBO, mesh.transparentEBO,
+                         meshData.transparentVertices, meshData.transparentIndices);
+    }
+}
+
+void ChunkRenderer::Release(const ChunkPos& pos) {
+    auto it = m_Meshes.find(pos);
+    if (it == m_Meshes.end()) {
+        return;
+    }
+
+    m_RegionBatcher.Invalidate(pos);
+    DeleteMesh(it->second);
+    m_Meshes.erase(it);
+}
+
+void ChunkRenderer::UpdateTransparentOrder(const RenderCommand& command) {
+    auto it = m_Meshes.find(command.pos);
+    if (it == m_Meshes.end() || it->second.meshVersion != command.meshVersion) {
+        return;
+    }
+
+    ChunkGpuMesh& mesh = it->second;
+    if (!command.packedFaces.empty()) {
+        if (mesh.transparentFaceSSBO == 0 || command.packedFaces.size() * 6 != mesh.transparentIndexCount) {
+            return;
+        }
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, mesh.transparentFaceSSBO);
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, command.packedFaces.size() * sizeof(uint32_t), command.packedFaces.data());
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        return;
+    }
+
+    if (mesh.transparentEBO == 0 || command.indices.size() != mesh.transparentIndexCount) {
+        return;
+    }
+    // Copy-write target avoids touching whichever VAO's element binding is current
+    glBindBuffer(GL_COPY_WRITE_BUFFER, mesh.transparentEBO);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, 0, command.indices.size() * sizeof(unsigned int), command.indices.data());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void ChunkRenderer::DeleteMesh(ChunkGpuMesh& mesh) {
+    RenderState::DeleteVertexArray(mesh.opaqueVAO);
+    RenderState::DeleteVertexArray(mesh.transparentVAO);
+    const unsigned int buffers[] = {mesh.opaqueVBO, mesh.opaqueEBO, mesh.transparentVBO, mesh.transparentEBO,
+                                    mesh.opaqueFaceSSBO, mesh.transparentFaceSSBO};
+    for (unsigned int buffer : buffers) {
+        RenderState::DeleteBuffer(buffer);
+    }
+
+    mesh.opaqueVAO = mesh.opaqueVBO = mesh.opaqueEBO = 0;
+    mesh.transparentVAO = mesh.transparentVBO = mesh.transparentEBO = 0;
+    mesh.opaqueFaceSSBO = mesh.transparentFaceSSBO = 0;
+    mesh.opaqueIndexCount = mesh.transparentIndexCount = 0;
+}
+
+} // namespace Minecraft
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "RegionBatcher.h"
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace Minecraft {
+
+struct RenderCommand;
+
+// GPU buffers of one chunk mesh, owned by the render thread
+struct ChunkGpuMesh {
+    MeshFormat format = MeshFormat::Vertices;
+    uint32_t meshVersion = 0;
+    glm::ivec3 regionOrigin = glm::ivec3(0);
+
+    unsigned int opaqueVAO = 0;
+    unsigned int opaqueVBO = 0;
+    unsigned int opaqueEBO = 0;
+    unsigned int transparentVAO = 0;
+    unsigned int transparentVBO = 0;
+    unsigned int transparentEBO = 0;
+    unsigned int opaqueFaceSSBO = 0;
+    unsigned int transparentFaceSSBO = 0;
+    unsigned int opaqueIndexCount = 0;       // Vertices drawn in the packed path
+    unsigned int transparentIndexCount = 0;
+};
+
+// Applies mesh uploads from frame packets and draws chunk meshes.
+// Lives on the render thread; every method needs its GL context current.
+class ChunkRenderer {
+public:
+    ChunkRenderer() = default;
+    ~ChunkRenderer();
+    ChunkRenderer(const ChunkRenderer&) = delete;
+    ChunkRenderer& operator=(const ChunkRenderer&) = delete;
+
+    // Vertex attribute layout for the bound VAO and GL_ARRAY_BUFFER
+    static void SetupVertexLayout();
+
+    // Draw face records from an SSBO whose coordinates are relative to the region origin
+    static void DrawPackedFaces(unsigned int ssbo, unsigned int vertexCount, const glm::ivec3& origin);
+
+    void Execute(RenderCommand& command);
+
+    // Draw the listed chunks; settled regions go through the region batcher when enabled
+    void RenderOpaque(const std::vector<ChunkPos>& visibleChunks, bool regionBatching);
+
+    // Draw the listed chunks in order (the caller sorts them back to front)
+    void RenderTransparent(const std::vector<ChunkPos>& chunks);
+
+    size_t GetMeshCount() const { return m_Meshes.size(); }
+    int GetRegionBatchCount() const { return m_RegionBatcher.GetBatchCount(); }
+    int GetBatchedChunkCount() const { return m_RegionBatcher.GetBatchedChunkCount(); }
+
+private:
+    void Upload(const ChunkPos& pos, uint32_t meshVersion, ChunkMeshData& meshData);
+    void Release(const ChunkPos& pos);
+    void UpdateTransparentOrder(const RenderCommand& command);
+    static void DeleteMesh(ChunkGpuMesh& mesh);
+
+    std::unordered_map<ChunkPos, ChunkGpuMesh> m_Meshes;
+    std::unordered_set<ChunkPos> m_VisibleChunks;  // Scratch set for batch visibility
+    RegionBatcher m_RegionBatcher;
+};
+
+} // namespace Minecraft
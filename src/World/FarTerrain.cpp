@@ -0,0 +1,371 @@
+#include "FarTerrain.h"
+#include "Chunk.h"
+#include "WorldGeneration.h"
+#include "../Render/FramePacket.h"
+#include "../utils/Logger.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Minecraft {
+
+namespace {
+
+constexpr int GRID_SIDE = FarTerrain::TILE_CELLS + 1;
+
+// Grid vertex indices around the tile border, in order; skirts hang below these
+std::vector<unsigned int> BuildPerimeter() {
+    constexpr int n = FarTerrain::TILE_CELLS;
+    std::vector<unsigned int> perimeter;
+    perimeter.reserve(4 * n);
+    for (int x = 0; x < n; ++x) perimeter.push_back(x);                                // z = 0
+    for (int z = 0; z < n; ++z) perimeter.push_back(z * GRID_SIDE + n);                // x = n
+    for (int x = n; x > 0; --x) perimeter.push_back(n * GRID_SIDE + x);                // z = n
+    for (int z = n; z > 0; --z) perimeter.push_back(z * GRID_SIDE);                    // x = 0
+    return perimeter;
+}
+
+glm::vec3 SurfaceColor(BlockType surface) {
+    switch (surface) {
+    case BlockType::Grass: return glm::vec3(0.36f, 0.58f, 0.25f);
+    case BlockType::Sand:  return glm::vec3(0.85f, 0.80f, 0.56f);
+    default:               return glm::vec3(0.50f, 0.50f, 0.52f);
+    }
+}
+
+uint32_t PackColor(const glm::vec3& color) {
+    const glm::vec3 c = glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f;
+    return static_cast<uint32_t>(c.r) | (static_cast<uint32_t>(c.g) << 8) |
+           (static_cast<uint32_t>(c.b) << 16) | (0xffu << 24);
+}
+
+float DistanceToRect(const glm::vec2& point, const glm::vec2& rectMin, const glm::vec2& rectMax) {
+    const glm::vec2 d = glm::max(glm::max(rectMin - point, point - rectMax), glm::vec2(0.0f));
+    return glm::length(d);
+}
+
+// Quadtree parent; tiles of different LODs overlap only when one is an ancestor of the other
+FarTileKey ParentTile(const FarTileKey& key) {
+    return {key.lod + 1, FloorDiv(key.x, 2), FloorDiv(key.z, 2)};
+}
+
+float TileDistance(const FarTileKey& key, const glm::vec2& camera) {
+    const float size = static_cast<float>(FarTerrain::GetTileSize(key.lod));
+    const glm::vec2 tileMin(key.x * size, key.z * size);
+    return DistanceToRect(camera, tileMin, tileMin + size);
+}
+
+} // namespace
+
+FarTerrain::FarTerrain() {
+    for (int i = 0; i < WORKER_COUNT; ++i) {
+        m_Workers.emplace_back(&FarTerrain::WorkerMain, this);
+    }
+}
+
+FarTerrain::~FarTerrain() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_ShuttingDown = true;
+    }
+    m_Cv.notify_all();
+
+    for (std::thread& worker : m_Workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+std::vector<unsigned int> FarTerrain::BuildTileIndices() {
+    constexpr int n = TILE_CELLS;
+    const std::vector<unsigned int> perimeter = BuildPerimeter();
+
+    std::vector<unsigned int> indices;
+    indices.reserve(n * n * 6 + perimeter.size() * 6);
+    for (int z = 0; z < n; ++z) {
+        for (int x = 0; x < n; ++x) {
+            const unsigned int a = z * GRID_SIDE + x;
+            const unsigned int b = a + 1;
+            const unsigned int c = a + GRID_SIDE;
+            const unsigned int d = c + 1;
+            indices.insert(indices.end(), {a, c, b, b, c, d});
+        }
+    }
+
+    const unsigned int skirtBase = GRID_SIDE * GRID_SIDE;
+    const unsigned int count = static_cast<unsigned int>(perimeter.size());
+    for (unsigned int k = 0; k < count; ++k) {
+        const unsigned int next = (k + 1) % count;
+        indices.insert(indices.end(), {perimeter[k], perimeter[next], skirtBase + next,
+                                       perimeter[k], skirtBase + next, skirtBase + k});
+    }
+    return indices;
+}
+
+std::vector<FarTerrainVertex> FarTerrain::BuildTileMesh(const FarTileKey& key) {
+    constexpr int n = TILE_CELLS;
+    constexpr int side = n + 3;  // One extra sample on each border for normals
+    const int cell = GetCellSize(key.lod);
+    const int originX = key.x * GetTileSize(key.lod);
+    const int originZ = key.z * GetTileSize(key.lod);
+
+    std::vector<SurfaceSample> samples(side * side);
+    WorldGeneration::SampleSurfaceGrid(originX - cell, originZ - cell, cell, side, side, samples.data());
+    std::vector<float> heights(side * side);
+    std::vector<BlockType> surfaces(side * side);
+    for (int i = 0; i < side * side; ++i) {
+        heights[i] = static_cast<float>(samples[i].height);
+        surfaces[i] = samples[i].surface;
+    }
+    auto heightAt = [&heights](int x, int z) { return heights[(z + 1) * side + (x + 1)]; };
+
+    // Same face shading spirit as the voxel mesh: tops bright, steep slopes darker
+    const glm::vec3 lightDir = glm::normalize(glm::vec3(0.3f, 1.0f, 0.2f));
+
+    std::vector<FarTerrainVertex> vertices;
+    vertices.reserve(GRID_SIDE * GRID_SIDE + 4 * n);
+    for (int z = 0; z <= n; ++z) {
+        for (int x = 0; x <= n; ++x) {
+            const glm::vec3 normal = glm::normalize(glm::vec3(heightAt(x - 1, z) - heightAt(x + 1, z),
+                                                              2.0f * static_cast<float>(cell),
+                                                              heightAt(x, z - 1) - heightAt(x, z + 1)));
+            const float shade = 0.55f + 0.45f * std::max(glm::dot(normal, lightDir), 0.0f);
+            const BlockType surface = surfaces[(z + 1) * side + (x + 1)];
+
+            FarTerrainVertex vertex;
+            vertex.position = glm::vec3(static_cast<float>(originX + x * cell), heightAt(x, z),
+                                        static_cast<float>(originZ + z * cell));
+            vertex.color = PackColor(SurfaceColor(surface) * shade);
+            vertices.push_back(vertex);
+        }
+    }
+
+    // Skirts drop below the coarser neighbour's surface so LOD seams never show sky
+    const float skirtDepth = static_cast<float>(cell * 2);
+    for (unsigned int index : BuildPerimeter()) {
+        FarTerrainVertex vertex = vertices[index];
+        vertex.position.y -= skirtDepth;
+        vertices.push_back(vertex);
+    }
+    return vertices;
+}
+
+void FarTerrain::Update(const glm::vec3& cameraPos, int renderDistance, std::vector<RenderCommand>& commands) {
+    const glm::ivec2 cameraChunk(static_cast<int>(std::floor(cameraPos.x / CHUNK_SIZE)),
+                                 static_cast<int>(std::floor(cameraPos.z / CHUNK_SIZE)));
+
+    bool changed = false;
+    if (cameraChunk != m_SelectionChunk || renderDistance != m_SelectionDistance) {
+        changed = true;
+        m_Camera = glm::vec2(cameraPos.x, cameraPos.z);
+        m_SelectionChunk = cameraChunk;
+        m_SelectionDistance = renderDistance;
+
+        const glm::vec2 voxelMin = glm::vec2(cameraChunk - renderDistance) * static_cast<float>(CHUNK_SIZE);
+        const glm::vec2 voxelMax = glm::vec2(cameraChunk + renderDistance + 1) * static_cast<float>(CHUNK_SIZE);
+        SelectTiles(glm::vec2(cameraPos.x, cameraPos.z), voxelMin, voxelMax);
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            // Jobs nobody started yet are re-queued below in the new distance order, or dropped
+            for (const FarTileKey& key : m_Jobs) {
+                m_Requested.erase(key);
+            }
+            m_Jobs.clear();
+            for (const FarTileKey& key : m_Selected) {
+                if (m_ReadyTiles.count(key) == 0 && m_Requested.insert(key).second) {
+                    m_Jobs.push_back(key);
+                }
+            }
+        }
+        m_Cv.notify_all();
+    }
+
+    std::vector<TileResult> results;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        results.swap(m_Results);
+    }
+
+    for (TileResult& result : results) {
+        m_Requested.erase(result.key);
+        if (m_SelectedSet.count(result.key) == 0 || !m_ReadyTiles.insert(result.key).second) {
+            continue;
+        }
+        changed = true;
+
+        RenderCommand command;
+        command.type = RenderCommandType::UploadFarTile;
+        command.farTile = result.key;
+        command.farVertices = std::move(result.vertices);
+        commands.push_back(std::move(command));
+    }
+
+    if (changed) {
+        UpdateStandIns(commands);
+    }
+}
+
+void FarTerrain::UpdateStandIns(std::vector<RenderCommand>& commands) {
+    // A superseded tile stands in while it overlaps a selected tile that is not ready:
+    // a parent for its unready children, or children for their unready parent
+    m_StandIns.clear();
+    for (const FarTileKey& key : m_Selected) {
+        if (m_ReadyTiles.count(key) != 0) {
+            continue;
+        }
+        for (FarTileKey parent = ParentTile(key); parent.lod < LOD_COUNT; parent = ParentTile(parent)) {
+            if (m_ReadyTiles.count(parent) != 0) {
+                m_StandIns.insert(parent);
+            }
+        }
+    }
+    for (const FarTileKey& key : m_ReadyTiles) {
+        if (m_SelectedSet.count(key) != 0) {
+            continue;
+        }
+        for (FarTileKey parent = ParentTile(key); parent.lod < LOD_COUNT; parent = ParentTile(parent)) {
+            if (m_SelectedSet.count(parent) != 0) {
+                if (m_ReadyTiles.count(parent) == 0) {
+                    m_StandIns.insert(key);
+                }
+                break;
+            }
+        }
+    }
+
+    // Stand-ins from older selections can nest; the coarsest one covers the gap alone
+    for (auto it = m_StandIns.begin(); it != m_StandIns.end();) {
+        it = HasStandInAncestor(*it) ? m_StandIns.erase(it) : std::next(it);
+    }
+
+    // Fast camera moves leave many holes at once; keep the nearest stand-ins only
+    if (m_StandIns.size() > MAX_STAND_IN_TILES) {
+        std::vector<FarTileKey> nearest(m_StandIns.begin(), m_StandIns.end());
+        std::nth_element(nearest.begin(), nearest.begin() + MAX_STAND_IN_TILES, nearest.end(),
+                         [this](const FarTileKey& lhs, const FarTileKey& rhs) {
+                             return TileDistance(lhs, m_Camera) < TileDistance(rhs, m_Camera);
+                         });
+        m_StandIns.clear();
+        m_StandIns.insert(nearest.begin(), nearest.begin() + MAX_STAND_IN_TILES);
+    }
+
+    // Everything else superseded has its replacement in and leaves the GPU
+    for (auto it = m_ReadyTiles.begin(); it != m_ReadyTiles.end();) {
+        if (m_SelectedSet.count(*it) != 0 || m_StandIns.count(*it) != 0) {
+            ++it;
+            continue;
+        }
+        RenderCommand command;
+        command.type = RenderCommandType::ReleaseFarTile;
+        command.farTile = *it;
+        commands.push_back(std::move(command));
+        it = m_ReadyTiles.erase(it);
+    }
+}
+
+bool FarTerrain::HasStandInAncestor(const FarTileKey& key) const {
+    for (FarTileKey parent = ParentTile(key); parent.lod < LOD_COUNT; parent = ParentTile(parent)) {
+        if (m_StandIns.count(parent) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void FarTerrain::GetDrawList(std::vector<FarTileKey>& tiles) const {
+    tiles.clear();
+    for (const FarTileKey& key : m_Selected) {
+        // A ready child under a stand-in parent waits until its siblings are in too
+        if (m_ReadyTiles.count(key) != 0 && !HasStandInAncestor(key)) {
+            tiles.push_back(key);
+        }
+    }
+    tiles.insert(tiles.end(), m_StandIns.begin(), m_StandIns.end());
+}
+
+void FarTerrain::SelectTiles(const glm::vec2& camera, const glm::vec2& voxelMin, const glm::vec2& voxelMax) {
+    m_Selected.clear();
+    m_HorizonDistance = static_cast<float>(HORIZON_FACTOR) * (voxelMax.x - voxelMin.x) * 0.5f;
+
+    // Cover the horizon with root tiles of the coarsest LOD and refine towards the camera
+    const int rootLod = LOD_COUNT - 1;
+    const float rootSize = static_cast<float>(GetTileSize(rootLod));
+    const int minX = static_cast<int>(std::floor((camera.x - m_HorizonDistance) / rootSize));
+    const int maxX = static_cast<int>(std::floor((camera.x + m_HorizonDistance) / rootSize));
+    const int minZ = static_cast<int>(std::floor((camera.y - m_HorizonDistance) / rootSize));
+    const int maxZ = static_cast<int>(std::floor((camera.y + m_HorizonDistance) / rootSize));
+    for (int z = minZ; z <= maxZ; ++z) {
+        for (int x = minX; x <= maxX; ++x) {
+            SelectTile({rootLod, x, z}, camera, voxelMin, voxelMax);
+        }
+    }
+
+    // Nearest first, so the workers fill in the horizon from the inside out
+    std::sort(m_Selected.begin(), m_Selected.end(), [&camera](const FarTileKey& lhs, const FarTileKey& rhs) {
+        const auto centre = [](const FarTileKey& key) {
+            const float size = static_cast<float>(GetTileSize(key.lod));
+            return glm::vec2((key.x + 0.5f) * size, (key.z + 0.5f) * size);
+        };
+        const glm::vec2 a = centre(lhs) - camera;
+        const glm::vec2 b = centre(rhs) - camera;
+        return glm::dot(a, a) < glm::dot(b, b);
+    });
+
+    m_SelectedSet.clear();
+    m_SelectedSet.insert(m_Selected.begin(), m_Selected.end());
+}
+
+void FarTerrain::SelectTile(const FarTileKey& key, const glm::vec2& camera, const glm::vec2& voxelMin, const glm::vec2& voxelMax) {
+    const float size = static_cast<float>(GetTileSize(key.lod));
+    const glm::vec2 tileMin(key.x * size, key.z * size);
+    const glm::vec2 tileMax = tileMin + size;
+
+    const float distance = DistanceToRect(camera, tileMin, tileMax);
+    if (distance > m_HorizonDistance) {
+        return;
+    }
+    // Entirely covered by voxel chunks
+    if (tileMin.x >= voxelMin.x && tileMin.y >= voxelMin.y && tileMax.x <= voxelMax.x && tileMax.y <= voxelMax.y) {
+        return;
+    }
+
+    if (key.lod > 0 && distance < size * SPLIT_FACTOR) {
+        for (int dz = 0; dz < 2; ++dz) {
+            for (int dx = 0; dx < 2; ++dx) {
+                SelectTile({key.lod - 1, key.x * 2 + dx, key.z * 2 + dz}, camera, voxelMin, voxelMax);
+            }
+        }
+        return;
+    }
+
+    m_Selected.push_back(key);
+}
+
+void FarTerrain::WorkerMain() {
+    while (true) {
+        FarTileKey key;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Cv.wait(lock, [this]() {
+                return m_ShuttingDown || !m_Jobs.empty();
+            });
+
+            if (m_ShuttingDown) {
+                return;
+            }
+
+            key = m_Jobs.front();
+            m_Jobs.pop_front();
+        }
+
+        TileResult result;
+        result.key = key;
+        result.vertices = BuildTileMesh(key);
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Results.push_back(std::move(result));
+    }
+}
+
+} // namespace Minecraft
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace Minecraft {
+
+struct RenderCommand;
+
+// One far-terrain tile: TILE_CELLS x TILE_CELLS cells of 2^(lod+1) blocks each
+struct FarTileKey {
+    int lod = 0;
+    int x = 0;  // Tile index at this LOD
+    int z = 0;
+
+    bool operator==(const FarTileKey& other) const {
+        return lod == other.lod && x == other.x && z == other.z;
+    }
+};
+
+struct FarTerrainVertex {
+    glm::vec3 position;  // World space
+    uint32_t color;      // RGBA8, slope shading baked in
+};
+
+} // namespace Minecraft
+
+namespace std {
+    template<>
+    struct hash<Minecraft::FarTileKey> {
+        size_t operator()(const Minecraft::FarTileKey& key) const {
+            return hash<int>()(key.x) ^ (hash<int>()(key.z) << 1) ^ (hash<int>()(key.lod) << 7);
+        }
+    };
+}
+
+namespace Minecraft {
+
+// Horizon beyond the voxel radius, built only from WorldGeneration's 2D height and
+// biome noise. Tiles are picked with a quadtree around the camera, so the cell
+// size doubles with distance in concentric rings, and meshed on worker threads.
+// Skirts hide cracks between neighbouring LODs. The render thread masks out
+// everything inside the voxel area, so tiles need not line up with chunks.
+class FarTerrain {
+public:
+    static constexpr int TILE_CELLS = 16;
+    static constexpr int LOD_COUNT = 6;                 // Cells of 2 to 64 blocks
+    static constexpr float SPLIT_FACTOR = 1.5f;         // Split a tile closer than this many tile sizes
+    static constexpr int HORIZON_FACTOR = 10;           // Horizon radius in multiples of the voxel radius
+    static constexpr int WORKER_COUNT = 2;
+    static constexpr size_t MAX_STAND_IN_TILES = 256;   // Superseded tiles kept on the GPU at most
+
+    FarTerrain();
+    ~FarTerrain();
+    FarTerrain(const FarTerrain&) = delete;
+    FarTerrain& operator=(const FarTerrain&) = delete;
+
+    static int GetCellSize(int lod) { return 2 << lod; }
+    static int GetTileSize(int lod) { return TILE_CELLS * GetCellSize(lod); }
+
+    // Index pattern shared by every tile: grid triangles, then skirts
+    static std::vector<unsigned int> BuildTileIndices();
+    static std::vector<FarTerrainVertex> BuildTileMesh(const FarTileKey& key);
+
+    // Reselect tiles when the camera changes chunk or the voxel radius changes, queue
+    // missing ones, and turn finished meshes into render commands
+    void Update(const glm::vec3& cameraPos, int renderDistance, std::vector<RenderCommand>& commands);
+
+    // Tiles to draw: selected ones that are uploaded, with superseded tiles standing in
+    // for the parts whose replacements are not uploaded yet
+    void GetDrawList(std::vector<FarTileKey>& tiles) const;
+
+    float GetHorizonDistance() const { return m_HorizonDistance; }
+    size_t GetTileCount() const { return m_ReadyTiles.size(); }
+    size_t GetPendingCount() const { return m_Requested.size(); }
+    size_t GetStandInCount() const { return m_StandIns.size(); }
+
+private:
+    struct TileResult {
+        FarTileKey key;
+        std::vector<FarTerrainVertex> vertices;
+    };
+
+    void SelectTiles(const glm::vec2& camera, const glm::vec2& voxelMin, const glm::vec2& voxelMax);
+    void SelectTile(const FarTileKey& key, const glm::vec2& camera, const glm::vec2& voxelMin, const glm::vec2& voxelMax);
+    void UpdateStandIns(std::vector<RenderCommand>& commands);
+    bool HasStandInAncestor(const FarTileKey& key) const;
+    void WorkerMain();
+
+    std::vector<FarTileKey> m_Selected;             // Nearest first
+    std::unordered_set<FarTileKey> m_SelectedSet;
+    std::unordered_set<FarTileKey> m_ReadyTiles;    // Uploaded to the render thread
+    std::unordered_set<FarTileKey> m_Requested;     // Queued or being built
+    std::unordered_set<FarTileKey> m_StandIns;      // Ready but unselected, covering an unready selected tile
+    glm::vec2 m_Camera = glm::vec2(0.0f);
+    glm::ivec2 m_SelectionChunk = glm::ivec2(INT32_MAX);
+    int m_SelectionDistance = -1;
+    float m_HorizonDistance = 0.0f;
+
+    std::deque<FarTileKey> m_Jobs;
+    std::vector<TileResult> m_Results;
+    bool m_ShuttingDown = false;
+    std::mutex m_Mutex;
+    std::condition_variable m_Cv;
+    std::vector<std::thread> m_Workers;
+};
+
+} // namespace Minecraft
@@ -0,0 +1,111 @@
+#include "FarTerrainRenderer.h"
+#include "../Render/FrameConstants.h"
+#include "../Render/FramePacket.h"
+#include "../Render/RenderState.h"
+#include "../Render/Shader.h"
+#include "../utils/Logger.h"
+#include <GL/glew.h>
+
+namespace Minecraft {
+
+FarTerrainRenderer::~FarTerrainRenderer() {
+    for (auto& [key, tile] : m_Tiles) {
+        (void)key;
+        RenderState::DeleteVertexArray(tile.vao);
+        RenderState::DeleteBuffer(tile.vbo);
+    }
+    RenderState::DeleteBuffer(m_IndexBuffer);
+}
+
+bool FarTerrainRenderer::Initialize() {
+    m_Shader = std::make_unique<Shader>();
+    if (!m_Shader->LoadFromFile("Resource/Shader/far_terrain.vert", "Resource/Shader/far_terrain.frag")) {
+        LOG_ERROR("Failed to load far terrain shader");
+        m_Shader.reset();
+        return false;
+    }
+
+    m_Shader->BindUniformBlock("FrameConstants", FRAME_CONSTANTS_BINDING);
+    m_VoxelMinHandle = m_Shader->GetUniformLocation("uVoxelMin");
+    m_VoxelMaxHandle = m_Shader->GetUniformLocation("uVoxelMax");
+    m_FogRangeHandle = m_Shader->GetUniformLocation("uFogRange");
+
+    const std::vector<unsigned int> indices = FarTerrain::BuildTileIndices();
+    m_IndexCount = static_cast<unsigned int>(indices.size());
+    glGenBuffers(1, &m_IndexBuffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_IndexBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    return true;
+}
+
+void FarTerrainRenderer::Execute(RenderCommand& command) {
+    switch (command.type) {
+    case RenderCommandType::UploadFarTile:
+        Upload(command.farTile, command.farVertices);
+        break;
+    case RenderCommandType::ReleaseFarTile:
+        Release(command.farTile);
+        break;
+    default:
+        break;
+    }
+}
+
+void FarTerrainRenderer::Render(const FramePacket& packet) {
+    if (!m_Shader || packet.farTiles.empty()) {
+        return;
+    }
+
+    // Skirts and steep slopes are seen from both sides
+    RenderState::SetEnabled(GL_CULL_FACE, false);
+
+    m_Shader->Bind();
+    m_Shader->SetVec2(m_VoxelMinHandle, packet.voxelMin);
+    m_Shader->SetVec2(m_VoxelMaxHandle, packet.voxelMax);
+    m_Shader->SetVec2(m_FogRangeHandle, glm::vec2(packet.horizonDistance * 0.5f, packet.horizonDistance));
+
+    for (const FarTileKey& key : packet.farTiles) {
+        auto it = m_Tiles.find(key);
+        if (it != m_Tiles.end()) {
+            RenderState::BindVertexArray(it->second.vao);
+            RenderState::DrawElements(GL_TRIANGLES, m_IndexCount);
+        }
+    }
+
+    RenderState::SetEnabled(GL_CULL_FACE, true);
+}
+
+void FarTerrainRenderer::Upload(const FarTileKey& key, const std::vector<FarTerrainVertex>& vertices) {
+    TileMesh& tile = m_Tiles[key];
+    if (tile.vao == 0) {
+        glGenVertexArrays(1, &tile.vao);
+        glGenBuffers(1, &tile.vbo);
+    }
+
+    RenderState::BindVertexArray(tile.vao);
+
+    glBindBuffer(GL_ARRAY_BUFFER, tile.vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(FarTerrainVertex), vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBuffer);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(FarTerrainVertex), (void*)offsetof(FarTerrainVertex, position));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(FarTerrainVertex), (void*)offsetof(FarTerrainVertex, color));
+
+    RenderState::BindVertexArray(0);
+}
+
+void FarTerrainRenderer::Release(const FarTileKey& key) {
+    auto it = m_Tiles.find(key);
+    if (it == m_Tiles.end()) {
+        return;
+    }
+
+    RenderState::DeleteVertexArray(it->second.vao);
+    RenderState::DeleteBuffer(it->second.vbo);
+    m_Tiles.erase(it);
+}
+
+} // namespace Minecraft
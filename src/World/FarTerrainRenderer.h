@@ -0,0 +1,54 @@
+#pragma once
+
+#include "FarTerrain.h"
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Minecraft {
+
+class Shader;
+struct FramePacket;
+struct RenderCommand;
+
+// GPU side of FarTerrain: one vertex buffer per tile and an index buffer shared
+// by all of them. Lives on the render thread; every method needs its GL context current.
+class FarTerrainRenderer {
+public:
+    FarTerrainRenderer() = default;
+    ~FarTerrainRenderer();
+    FarTerrainRenderer(const FarTerrainRenderer&) = delete;
+    FarTerrainRenderer& operator=(const FarTerrainRenderer&) = delete;
+
+    // Load the shader and the shared index buffer; false leaves the horizon undrawn
+    bool Initialize();
+
+    // UploadFarTile / ReleaseFarTile
+    void Execute(RenderCommand& command);
+
+    // Draw the packet's far tiles with the far projection from FrameConstants; depth is cleared afterwards
+    // by the caller so chunks always land on top
+    void Render(const FramePacket& packet);
+
+    size_t GetTileCount() const { return m_Tiles.size(); }
+
+private:
+    struct TileMesh {
+        unsigned int vao = 0;
+        unsigned int vbo = 0;
+    };
+
+    void Upload(const FarTileKey& key, const std::vector<FarTerrainVertex>& vertices);
+    void Release(const FarTileKey& key);
+
+    std::unique_ptr<Shader> m_Shader;
+    int m_VoxelMinHandle = -1;
+    int m_VoxelMaxHandle = -1;
+    int m_FogRangeHandle = -1;
+
+    std::unordered_map<FarTileKey, TileMesh> m_Tiles;
+    unsigned int m_IndexBuffer = 0;
+    unsigned int m_IndexCount = 0;
+};
+
+} // namespace Minecraft
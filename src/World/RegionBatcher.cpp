@@ -0,0 +1,226 @@
+#include "RegionBatcher.h"
+#include "ChunkRenderer.h"
+#include "../Render/RenderState.h"
+#include "../utils/Logger.h"
+#include <GL/glew.h>
+#include <algorithm>
+
+namespace Minecraft {
+
+RegionBatcher::~RegionBatcher() {
+    Clear();
+    RenderState::DeleteBuffer(m_QuadIndexBuffer);
+}
+
+ChunkPos RegionBatcher::GetRegion(const ChunkPos& chunkPos) {
+    return ChunkPos(FloorDiv(chunkPos.x, REGION_SIZE), FloorDiv(chunkPos.z, REGION_SIZE));
+}
+
+void RegionBatcher::Invalidate(const ChunkPos& chunkPos) {
+    auto it = m_Regions.find(GetRegion(chunkPos));
+    if (it == m_Regions.end()) {
+        return;
+    }
+
+    it->second.lastChange = Clock::now();
+    Release(it->second);
+}
+
+void RegionBatcher::Clear() {
+    for (auto& [region, batch] : m_Regions) {
+        (void)region;
+        Release(batch);
+    }
+    m_Regions.clear();
+}
+
+void RegionBatcher::Update(const std::unordered_map<ChunkPos, ChunkGpuMesh>& meshes) {
+    const Clock::time_point now = Clock::now();
+
+    std::unordered_map<ChunkPos, std::vector<std::pair<ChunkPos, const ChunkGpuMesh*>>> regionMembers;
+    for (const auto& [pos, mesh] : meshes) {
+        regionMembers[GetRegion(pos)].push_back({pos, &mesh});
+    }
+
+    for (auto it = m_Regions.begin(); it != m_Regions.end();) {
+        if (regionMembers.find(it->first) == regionMembers.end()) {
+            Release(it->second);
+            it = m_Regions.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    int merges = 0;
+    for (const auto& [region, members] : regionMembers) {
+        auto [it, inserted] = m_Regions.try_emplace(region);
+        RegionBatch& batch = it->second;
+        if (inserted) {
+            batch.lastChange = now;
+            continue;
+        }
+        if (batch.merged || merges >= MERGES_PER_UPDATE ||
+            std::chrono::duration<float>(now - batch.lastChange).count() < STATIC_SECONDS) {
+            continue;
+        }
+
+        std::vector<const ChunkGpuMesh*> memberMeshes;
+        memberMeshes.reserve(members.size());
+        batch.members.clear();
+        for (const auto& [pos, mesh] : members) {
+            batch.members.push_back(pos);
+            memberMeshes.push_back(mesh);
+        }
+        Merge(region, batch, memberMeshes);
+        merges++;
+    }
+}
+
+bool RegionBatcher::IsBatched(const ChunkPos& chunkPos) const {
+    auto it = m_Regions.find(GetRegion(chunkPos));
+    return it != m_Regions.end() && it->second.merged;
+}
+
+void RegionBatcher::RenderOpaque(const std::unordered_set<ChunkPos>& visibleChunks) {
+    for (const auto& [region, batch] : m_Regions) {
+        if (!batch.merged || batch.drawCount == 0) {
+            continue;
+        }
+
+        bool visible = false;
+        for (const ChunkPos& member : batch.members) {
+            if (visibleChunks.find(member) != visibleChunks.end()) {
+                visible = true;
+                break;
+            }
+        }
+        if (!visible) {
+            continue;
+        }
+
+        if (batch.format == MeshFormat::PackedFaces) {
+            const glm::ivec3 origin(region.x * REGION_SIZE * CHUNK_SIZE, 0, region.z * REGION_SIZE * CHUNK_SIZE);
+            ChunkRenderer::DrawPackedFaces(batch.buffer, batch.drawCount, origin);
+        } else {
+            RenderState::BindVertexArray(batch.vao);
+            RenderState::DrawElements(GL_TRIANGLES, batch.drawCount);
+        }
+    }
+}
+
+int RegionBatcher::GetBatchCount() const {
+    int count = 0;
+    for (const auto& [region, batch] : m_Regions) {
+        (void)region;
+        if (batch.merged) {
+            count++;
+        }
+    }
+    return count;
+}
+
+int RegionBatcher::GetBatchedChunkCount() const {
+    int count = 0;
+    for (const auto& [region, batch] : m_Regions) {
+        (void)region;
+        if (batch.merged) {
+            count += static_cast<int>(batch.members.size());
+        }
+    }
+    return count;
+}
+
+void RegionBatcher::Merge(const ChunkPos& region, RegionBatch& batch, const std::vector<const ChunkGpuMesh*>& meshes) {
+    const MeshFormat format = meshes.empty() ? MeshFormat::Vertices : meshes.front()->format;
+    const bool packed = format == MeshFormat::PackedFaces;
+
+    // Every quad is six indices in both paths, so the face count drives both layouts
+    unsigned int totalQuads = 0;
+    for (const ChunkGpuMesh* mesh : meshes) {
+        totalQuads += mesh->opaqueIndexCount / 6;
+    }
+
+    batch.merged = true;
+    batch.format = format;
+    batch.drawCount = totalQuads * 6;
+    if (totalQuads == 0) {
+        return;
+    }
+
+    // Face records are already relative to the region origin and vertices are in world
+    // space, so member buffers concatenate on the GPU without touching their contents
+    const size_t quadBytes = packed ? sizeof(uint32_t) : sizeof(Vertex) * 4;
+    glGenBuffers(1, &batch.buffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, batch.buffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, totalQuads * quadBytes, nullptr, GL_STATIC_DRAW);
+
+    GLintptr offset = 0;
+    for (const ChunkGpuMesh* mesh : meshes) {
+        const unsigned int quads = mesh->opaqueIndexCount / 6;
+        const unsigned int source = packed ? mesh->opaqueFaceSSBO : mesh->opaqueVBO;
+        if (quads == 0 || source == 0) {
+            continue;
+        }
+        const GLsizeiptr size = static_cast<GLsizeiptr>(quads * quadBytes);
+        glBindBuffer(GL_COPY_READ_BUFFER, source);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, offset, size);
+        offset += size;
+    }
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    if (!packed) {
+        EnsureQuadIndices(totalQuads);
+
+        glGenVertexArrays(1, &batch.vao);
+        RenderState::BindVertexArray(batch.vao);
+        glBindBuffer(GL_ARRAY_BUFFER, batch.buffer);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_QuadIndexBuffer);
+        ChunkRenderer::SetupVertexLayout();
+        RenderState::BindVertexArray(0);
+    }
+
+    LOG_DEBUG("Merged region (" + std::to_string(region.x) + ", " + std::to_string(region.z) + "): " +
+              std::to_string(meshes.size()) + " chunks, " + std::to_string(totalQuads) + " faces");
+}
+
+void RegionBatcher::Release(RegionBatch& batch) {
+    RenderState::DeleteVertexArray(batch.vao);
+    RenderState::DeleteBuffer(batch.buffer);
+    batch.vao = 0;
+    batch.buffer = 0;
+    batch.drawCount = 0;
+    batch.merged = false;
+    batch.members.clear();
+}
+
+void RegionBatcher::EnsureQuadIndices(unsigned int quadCount) {
+    if (quadCount <= m_QuadIndexCapacity) {
+        return;
+    }
+
+    // Grow geometrically; VAOs keep referencing the same buffer name across reallocation
+    const unsigned int capacity = std::max(quadCount, m_QuadIndexCapacity * 2);
+    std::vector<unsigned int> indices;
+    indices.reserve(static_cast<size_t>(capacity) * 6);
+    for (unsigned int quad = 0; quad < capacity; ++quad) {
+        const unsigned int base = quad * 4;
+        indices.push_back(base);
+        indices.push_back(base + 1);
+        indices.push_back(base + 2);
+        indices.push_back(base);
+        indices.push_back(base + 2);
+        indices.push_back(base + 3);
+    }
+
+    if (m_QuadIndexBuffer == 0) {
+        glGenBuffers(1, &m_QuadIndexBuffer);
+    }
+    // Copy-write target leaves the element binding of whatever VAO is bound alone
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_QuadIndexBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    m_QuadIndexCapacity = capacity;
+}
+
+} // namespace Minecraft
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "World.h"
+#include <chrono>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Minecraft {
+
+struct ChunkGpuMesh;
+
+// Merges the opaque meshes of chunks that stopped changing into one buffer per
+// REGION_SIZE x REGION_SIZE region, so settled terrain costs one draw per region.
+// Uploading or releasing any member splits the region back into per-chunk draws.
+// Owned by ChunkRenderer on the render thread.
+class RegionBatcher {
+public:
+    static constexpr float STATIC_SECONDS = 5.0f;  // Time without changes before a region is merged
+    static constexpr int MERGES_PER_UPDATE = 1;    // Copies are cheap but not free, spread them out
+
+    RegionBatcher() = default;
+    ~RegionBatcher();
+    RegionBatcher(const RegionBatcher&) = delete;
+    RegionBatcher& operator=(const RegionBatcher&) = delete;
+
+    static ChunkPos GetRegion(const ChunkPos& chunkPos);
+
+    // Split the batch holding this chunk and restart its region's static timer
+    void Invalidate(const ChunkPos& chunkPos);
+
+    // Release every batch
+    void Clear();
+
+    // Merge regions that stayed unchanged for STATIC_SECONDS and forget unloaded ones
+    void Update(const std::unordered_map<ChunkPos, ChunkGpuMesh>& meshes);
+
+    // True if the chunk's opaque geometry is drawn by its region batch
+    bool IsBatched(const ChunkPos& chunkPos) const;
+
+    // Draw every batch that has at least one visible member
+    void RenderOpaque(const std::unordered_set<ChunkPos>& visibleChunks);
+
+    int GetBatchCount() const;
+    int GetBatchedChunkCount() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct RegionBatch {
+        Clock::time_point lastChange;
+        std::vector<ChunkPos> members;
+        bool merged = false;
+        MeshFormat format = MeshFormat::Vertices;
+        unsigned int vao = 0;          // Vertex path only
+        unsigned int buffer = 0;       // Merged VBO, or face SSBO in the packed path
+        unsigned int drawCount = 0;    // Indices (vertex path) or vertices (packed path)
+    };
+
+    void Merge(const ChunkPos& region, RegionBatch& batch, const std::vector<const ChunkGpuMesh*>& meshes);
+    void Release(RegionBatch& batch);
+    void EnsureQuadIndices(unsigned int quadCount);
+
+    std::unordered_map<ChunkPos, RegionBatch> m_Regions;
+    unsigned int m_QuadIndexBuffer = 0;    // Shared 0,1,2,0,2,3 quad pattern for merged vertex batches
+    unsigned int m_QuadIndexCapacity = 0;  // Quads covered by m_QuadIndexBuffer
+};
+
+} // namespace Minecraft
@@ -0,0 +1,122 @@
+#include "RenderDistanceGovernor.h"
+#include "World.h"
+#include "../Core/GameConfig.h"
+#include "../utils/Logger.h"
+#include <algorithm>
+
+namespace Minecraft {
+
+RenderDistanceGovernor::RenderDistanceGovernor(const StreamingConfig& config)
+    : m_Config(config) {
+}
+
+void RenderDistanceGovernor::Update(World& world, const Sample& sample, float deltaTime) {
+    m_WindowTime += deltaTime;
+    m_WindowFrames++;
+    m_FrameMsSum += sample.frameMs;
+    m_WorkMsSum += sample.workMs;
+    m_TargetMsSum += sample.targetMs;
+    m_Last = sample;
+
+    if (m_WindowTime >= EVALUATION_SECONDS) {
+        Evaluate(world);
+        m_WindowTime = 0.0f;
+        m_WindowFrames = 0;
+        m_FrameMsSum = 0.0f;
+        m_WorkMsSum = 0.0f;
+        m_TargetMsSum = 0.0f;
+    }
+}
+
+void RenderDistanceGovernor::Evaluate(World& world) {
+    if (m_WindowFrames == 0) {
+        return;
+    }
+
+    const float frameMs = m_FrameMsSum / static_cast<float>(m_WindowFrames);
+    const float workMs = m_WorkMsSum / static_cast<float>(m_WindowFrames);
+    const float targetMs = m_TargetMsSum / static_cast<float>(m_WindowFrames);
+    const int distance = world.GetRenderDistance();
+    const int generation = world.GetChunkGenerationBudget();
+    const int meshing = world.GetChunkMeshingBudget();
+    const bool backlog = m_Last.generationBacklog > 0 || m_Last.meshBacklog > 0;
+    const std::string frameText = std::to_string(frameMs) + " ms frame, " + std::to_string(workMs) + " ms work, " +
+                                  std::to_string(targetMs) + " ms target";
+
+    // Memory is a hard limit: shrink even if frames are fine
+    const size_t memoryBudget = m_Config.chunkMemoryBudgetMB * 1024 * 1024;
+    if (m_Last.chunkMemoryBytes > memoryBudget && distance > m_Config.minRenderDistance) {
+        m_CalmEvaluations = 0;
+        SetDistance(world, distance - 1, std::to_string(m_Last.chunkMemoryBytes / (1024 * 1024)) + " MB chunks over " +
+                                         std::to_string(m_Config.chunkMemoryBudgetMB) + " MB budget");
+        return;
+    }
+
+    if (frameMs > targetMs * OVER_BUDGET || workMs > targetMs * OVER_BUDGET) {
+        m_CalmEvaluations = 0;
+        // Streaming work is the cheapest thing to give up while there is some
+        if (backlog && (generation > m_Config.minGenerationBudget || meshing > m_Config.minMeshingBudget)) {
+            SetBudgets(world, std::max(generation / 2, m_Config.minGenerationBudget),
+                       std::max(meshing - 1, m_Config.minMeshingBudget), frameText);
+        } else if (distance > m_Config.minRenderDistance) {
+            SetDistance(world, distance - 1, frameText);
+        }
+        return;
+    }
+
+    if (workMs > targetMs * UNDER_BUDGET) {
+        // Inside the band: hold
+        m_CalmEvaluations = 0;
+        return;
+    }
+
+    // Headroom: catch up on the backlog first, then grow
+    if (backlog) {
+        m_CalmEvaluations = 0;
+        if (generation < m_Config.maxGenerationBudget || meshing < m_Config.maxMeshingBudget) {
+            SetBudgets(world, std::min(generation * 2, m_Config.maxGenerationBudget),
+                       std::min(meshing + 1, m_Config.maxMeshingBudget),
+                       std::to_string(m_Last.generationBacklog) + " generation / " +
+                       std::to_string(m_Last.meshBacklog) + " meshing backlog, " + frameText);
+        }
+        return;
+    }
+
+    if (++m_CalmEvaluations < GROW_EVALUATIONS) {
+        return;
+    }
+    m_CalmEvaluations = 0;
+
+    if (distance < m_Config.maxRenderDistance && DistanceFitsMemory(world, distance + 1)) {
+        SetDistance(world, distance + 1, frameText);
+    }
+}
+
+void RenderDistanceGovernor::SetDistance(World& world, int distance, const std::string& reason) {
+    LOG_INFO("Governor: render distance " + std::to_string(world.GetRenderDistance()) + " -> " +
+             std::to_string(distance) + " (" + reason + ")");
+    world.SetRenderDistance(distance);
+}
+
+void RenderDistanceGovernor::SetBudgets(World& world, int generation, int meshing, const std::string& reason) {
+    if (generation == world.GetChunkGenerationBudget() && meshing == world.GetChunkMeshingBudget()) {
+        return;
+    }
+    LOG_INFO("Governor: generation/meshing budget " + std::to_string(world.GetChunkGenerationBudget()) + "/" +
+             std::to_string(world.GetChunkMeshingBudget()) + " -> " + std::to_string(generation) + "/" +
+             std::to_string(meshing) + " (" + reason + ")");
+    world.SetChunkGenerationBudget(generation);
+    world.SetChunkMeshingBudget(meshing);
+}
+
+bool RenderDistanceGovernor::DistanceFitsMemory(const World& world, int distance) const {
+    if (m_Last.loadedChunks == 0) {
+        return true;
+    }
+    // Chunks stay loaded out to the unload ring, so scale by the area that covers
+    const size_t bytesPerChunk = m_Last.chunkMemoryBytes / m_Last.loadedChunks;
+    const size_t side = static_cast<size_t>(2 * (distance + world.GetUnloadDistanceBuffer()) + 1);
+    return bytesPerChunk * side * side <= m_Config.chunkMemoryBudgetMB * 1024 * 1024;
+}
+
+} // namespace Minecraft
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace Minecraft {
+
+class World;
+struct StreamingConfig;
+
+// Tunes World's render distance and per-update generation/meshing budgets from
+// frame work time, streaming backlog and chunk memory. Samples are averaged over an
+// evaluation window; shrinking reacts after one bad window, growing waits for
+// several calm ones in a row, so the distance doesn't oscillate at a boundary.
+// Frame budget problems are handled by trimming streaming budgets while there is
+// a backlog, and by dropping render distance otherwise.
+class RenderDistanceGovernor {
+public:
+    static constexpr float EVALUATION_SECONDS = 2.0f;
+    static constexpr int GROW_EVALUATIONS = 3;    // Calm windows in a row before the distance grows
+    static constexpr float OVER_BUDGET = 1.1f;    // Average frame or work above target * this is too slow
+    static constexpr float UNDER_BUDGET = 0.8f;   // Work below target * this leaves headroom
+
+    struct Sample {
+        // The paced interval sits at the target under vsync or a cap whatever the load, so
+        // it only tells when frames are missed; headroom is judged from the work time
+        float frameMs = 0.0f;       // Interval between frame starts
+        float workMs = 0.0f;        // Simulation plus render thread CPU and GPU time
+        float targetMs = 0.0f;
+        size_t generationBacklog = 0;
+        size_t meshBacklog = 0;
+        size_t chunkMemoryBytes = 0;
+        size_t loadedChunks = 0;
+    };
+
+    explicit RenderDistanceGovernor(const StreamingConfig& config);
+
+    // Record one frame; at the end of each window, adjust the world
+    void Update(World& world, const Sample& sample, float deltaTime);
+
+private:
+    void Evaluate(World& world);
+    void SetDistance(World& world, int distance, const std::string& reason);
+    void SetBudgets(World& world, int generation, int meshing, const std::string& reason);
+    bool DistanceFitsMemory(const World& world, int distance) const;
+
+    const StreamingConfig& m_Config;
+    float m_WindowTime = 0.0f;
+    int m_WindowFrames = 0;
+    float m_FrameMsSum = 0.0f;
+    float m_WorkMsSum = 0.0f;
+    float m_TargetMsSum = 0.0f;
+    Sample m_Last;
+    int m_CalmEvaluations = 0;
+};
+
+} // namespace Minecraft
@@ -0,0 +1,109 @@
+#include "StructureTemplate.h"
+
+#include "Chunk.h"
+#include "WorldGeneration.h"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+namespace Minecraft {
+
+void StructureTemplate::Builder::Set(int x, int y, int z, BlockType type, bool onlyIntoAir) {
+    const auto key = std::make_tuple(y, z, x);
+    auto it = m_Cells.find(key);
+    if (it == m_Cells.end()) {
+        m_Cells.emplace(key, Cell{type, onlyIntoAir});
+    } else if (!onlyIntoAir) {
+        it->second = Cell{type, onlyIntoAir};
+    }
+}
+
+StructureTemplate StructureTemplate::Builder::Build() const {
+    constexpr int COORD_MIN = std::numeric_limits<int8_t>::min();
+    constexpr int COORD_MAX = std::numeric_limits<int8_t>::max();
+
+    StructureTemplate result;
+    if (m_Cells.empty()) {
+        return result;
+    }
+    result.m_Min = glm::ivec3(std::numeric_limits<int>::max());
+    result.m_Max = glm::ivec3(std::numeric_limits<int>::min());
+
+    for (const auto& entry : m_Cells) {
+        const int y = std::get<0>(entry.first);
+        const int z = std::get<1>(entry.first);
+        const int x = std::get<2>(entry.first);
+        if (x < COORD_MIN || x > COORD_MAX || y < COORD_MIN || y > COORD_MAX || z < COORD_MIN || z > COORD_MAX) {
+            continue;
+        }
+        result.m_Min = glm::min(result.m_Min, glm::ivec3(x, y, z));
+        result.m_Max = glm::max(result.m_Max, glm::ivec3(x, y, z));
+
+        // Cells come in (y, z, x) order, so a run continues the last one or starts anew
+        if (!result.m_Runs.empty()) {
+            StructureRun& last = result.m_Runs.back();
+            if (last.y == y && last.z == z && last.x + last.length == x && last.length < 255 &&
+                last.type == entry.second.type && last.onlyIntoAir == entry.second.onlyIntoAir) {
+                last.length++;
+                continue;
+            }
+        }
+
+        StructureRun run;
+        run.x = static_cast<int8_t>(x);
+        run.y = static_cast<int8_t>(y);
+        run.z = static_cast<int8_t>(z);
+        run.length = 1;
+        run.type = entry.second.type;
+        run.onlyIntoAir = entry.second.onlyIntoAir;
+        result.m_Runs.push_back(run);
+    }
+    return result;
+}
+
+void StructureTemplate::Stamp(Chunk& chunk, const glm::ivec3& anchor, DecorationStaging* staging) const {
+    const glm::ivec3 min = anchor + m_Min;
+    const glm::ivec3 max = anchor + m_Max;
+    const bool inside = min.x >= 0 && max.x < CHUNK_SIZE && min.z >= 0 && max.z < CHUNK_SIZE;
+
+    for (const StructureRun& run : m_Runs) {
+        const int y = anchor.y + run.y;
+        if (y < 0 || y >= CHUNK_HEIGHT) {
+            continue;
+        }
+        const int z = anchor.z + run.z;
+        const int x0 = anchor.x + run.x;
+        const int x1 = x0 + run.length;
+        if (inside) {
+            chunk.WriteRow(x0, y, z, run.length, run.type, run.onlyIntoAir);
+            continue;
+        }
+
+        // Split the run at chunk borders; at most two neighbours along x
+        const int dz = FloorDiv(z, CHUNK_SIZE);
+        for (int dx = FloorDiv(x0, CHUNK_SIZE); dx <= FloorDiv(x1 - 1, CHUNK_SIZE); ++dx) {
+            const int start = std::max(x0, dx * CHUNK_SIZE);
+            const int end = std::min(x1, (dx + 1) * CHUNK_SIZE);
+            if (dx == 0 && dz == 0) {
+                chunk.WriteRow(start, y, z, end - start, run.type, run.onlyIntoAir);
+                continue;
+            }
+            if (!staging || std::abs(dx) > 1 || std::abs(dz) > 1) {
+                continue;
+            }
+
+            std::vector<StagedBlock>& staged = staging->neighbours[DecorationStaging::Index(dx, dz)];
+            for (int x = start; x < end; ++x) {
+                StagedBlock block;
+                block.x = static_cast<uint8_t>(x - dx * CHUNK_SIZE);
+                block.y = static_cast<uint8_t>(y);
+                block.z = static_cast<uint8_t>(z - dz * CHUNK_SIZE);
+                block.type = run.type;
+                block.onlyIntoAir = run.onlyIntoAir;
+                staged.push_back(block);
+            }
+        }
+    }
+}
+
+} // namespace Minecraft
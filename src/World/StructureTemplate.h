@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Block.h"
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace Minecraft {
+
+class Chunk;
+struct DecorationStaging;
+
+// One run of identical blocks along +x, relative to the template's anchor
+struct StructureRun {
+    int8_t x = 0;
+    int8_t y = 0;
+    int8_t z = 0;
+    uint8_t length = 0;
+    BlockType type = BlockType::Air;
+    bool onlyIntoAir = false;  // Masked write: blocks already in the world are kept
+};
+
+// A prebaked structure (tree, boulder, ...) stored as x runs sorted by y, z, x, which
+// matches the chunk's block layout. Built once, then stamped any number of times.
+class StructureTemplate {
+public:
+    // Collects blocks and bakes them into runs. A later masked block never replaces an
+    // earlier one; an unmasked block always does.
+    class Builder {
+    public:
+        void Set(int x, int y, int z, BlockType type, bool onlyIntoAir);
+        StructureTemplate Build() const;
+
+    private:
+        struct Cell {
+            BlockType type;
+            bool onlyIntoAir;
+        };
+        std::map<std::tuple<int, int, int>, Cell> m_Cells;  // Keyed (y, z, x)
+    };
+
+    // Write the template with its anchor at `anchor`, in the chunk's local coordinates.
+    // Runs are clipped to the chunk; parts that land in one of the eight neighbours go to
+    // `staging` when given, anything further out is dropped.
+    void Stamp(Chunk& chunk, const glm::ivec3& anchor, DecorationStaging* staging) const;
+
+    const std::vector<StructureRun>& GetRuns() const { return m_Runs; }
+    glm::ivec3 GetMin() const { return m_Min; }  // Bounds relative to the anchor, max inclusive
+    glm::ivec3 GetMax() const { return m_Max; }
+
+private:
+    std::vector<StructureRun> m_Runs;
+    glm::ivec3 m_Min = glm::ivec3(0);
+    glm::ivec3 m_Max = glm::ivec3(0);
+};
+
+} // namespace Minecraft
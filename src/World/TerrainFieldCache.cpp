@@ -0,0 +1,79 @@
+#include "TerrainFieldCache.h"
+#include <utility>
+
+namespace Minecraft {
+
+TerrainFieldCache::TerrainFieldCache(size_t capacity, Filler filler)
+    : m_Capacity(capacity > 0 ? capacity : 1)
+    , m_Filler(std::move(filler)) {
+}
+
+std::shared_ptr<const TerrainTile> TerrainFieldCache::Get(const ChunkPos& region) {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    for (;;) {
+        auto it = m_Entries.find(region);
+        if (it == m_Entries.end()) {
+            break;
+        }
+        if (it->second.tile) {
+            m_Order.splice(m_Order.begin(), m_Order, it->second.order);
+            m_Stats.hits++;
+            return it->second.tile;
+        }
+        // Another thread is filling it; look again once it is done (it may be gone by then)
+        m_Cv.wait(lock);
+    }
+
+    // Claim the slot so other callers wait rather than sampling the same region
+    m_Order.push_front(region);
+    m_Entries[region].order = m_Order.begin();
+    m_Stats.misses++;
+    lock.unlock();
+
+    auto tile = std::make_shared<TerrainTile>();
+    tile->region = region;
+    m_Filler(*tile);
+
+    lock.lock();
+    m_Entries[region].tile = tile;
+    EvictLocked();
+    lock.unlock();
+    m_Cv.notify_all();
+    return tile;
+}
+
+void TerrainFieldCache::Clear() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (auto it = m_Entries.begin(); it != m_Entries.end();) {
+        // Tiles being filled stay; their fillers still expect the slot
+        if (it->second.tile) {
+            m_Order.erase(it->second.order);
+            it = m_Entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+TerrainFieldCache::Stats TerrainFieldCache::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    Stats stats = m_Stats;
+    stats.tiles = m_Entries.size();
+    return stats;
+}
+
+void TerrainFieldCache::EvictLocked() {
+    auto it = m_Order.end();
+    while (m_Entries.size() > m_Capacity && it != m_Order.begin()) {
+        --it;
+        auto entry = m_Entries.find(*it);
+        if (!entry->second.tile) {
+            continue;  // Still being filled
+        }
+        m_Entries.erase(entry);
+        it = m_Order.erase(it);
+        m_Stats.evictions++;
+    }
+}
+
+} // namespace Minecraft
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "World.h"
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace Minecraft {
+
+// 2D terrain fields of one REGION_SIZE x REGION_SIZE chunk region, indexed
+// z * SIDE + x from the region's minimum corner
+struct TerrainTile {
+    static constexpr int SIDE = REGION_SIZE * CHUNK_SIZE;
+
+    ChunkPos region;
+    std::array<uint16_t, SIDE * SIDE> heights{};  // Solid blocks in the column; the top is at height - 1
+    std::array<float, SIDE * SIDE> biomes{};
+    std::array<BlockType, SIDE * SIDE> surfaces{};
+    std::array<uint8_t, SIDE * SIDE> dirtDepths{};  // Dirt layers under grass
+
+    static int Index(int localX, int localZ) { return localZ * SIDE + localX; }
+};
+
+// Thread-safe LRU cache of TerrainTiles. A missing tile is filled once by the
+// first caller; concurrent callers asking for the same region wait for it
+// instead of sampling the noise again. Tiles are handed out as shared pointers,
+// so eviction never pulls data from under a reader.
+class TerrainFieldCache {
+public:
+    using Filler = std::function<void(TerrainTile&)>;
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t tiles = 0;
+    };
+
+    TerrainFieldCache(size_t capacity, Filler filler);
+    TerrainFieldCache(const TerrainFieldCache&) = delete;
+    TerrainFieldCache& operator=(const TerrainFieldCache&) = delete;
+
+    std::shared_ptr<const TerrainTile> Get(const ChunkPos& region);
+
+    void Clear();
+    Stats GetStats() const;
+
+private:
+    struct Entry {
+        std::shared_ptr<const TerrainTile> tile;  // Null while the filling thread samples it
+        std::list<ChunkPos>::iterator order;
+    };
+
+    void EvictLocked();
+
+    const size_t m_Capacity;
+    const Filler m_Filler;
+
+    std::unordered_map<ChunkPos, Entry> m_Entries;
+    std::list<ChunkPos> m_Order;  // Most recently used first
+    Stats m_Stats;
+    mutable std::mutex m_Mutex;
+    std::condition_variable m_Cv;
+};
+
+} // namespace Minecraft
@@ -0,0 +1,111 @@
+#include "TransparencySorter.h"
+#include <algorithm>
+#include <numeric>
+
+namespace Minecraft {
+
+TransparencySorter::TransparencySorter() {
+    m_Worker = std::thread(&TransparencySorter::WorkerMain, this);
+}
+
+TransparencySorter::~TransparencySorter() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_ShuttingDown = true;
+    }
+    m_Cv.notify_all();
+
+    if (m_Worker.joinable()) {
+        m_Worker.join();
+    }
+}
+
+void TransparencySorter::Submit(TransparentSortJob job) {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        const ChunkPos pos = job.pos;
+        m_PendingJobs[pos] = std::move(job);
+    }
+    m_Cv.notify_one();
+}
+
+void TransparencySorter::TakeResults(std::vector<TransparentSortResult>& results) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (auto& result : m_Results) {
+        results.push_back(std::move(result));
+    }
+    m_Results.clear();
+}
+
+std::vector<unsigned int> TransparencySorter::SortFaces(const std::vector<glm::vec3>& faceCenters, const glm::vec3& cameraPos) {
+    const size_t faceCount = faceCenters.size();
+    std::vector<float> distances(faceCount);
+    for (size_t i = 0; i < faceCount; ++i) {
+        const glm::vec3 d = faceCenters[i] - cameraPos;
+        distances[i] = glm::dot(d, d);
+    }
+
+    std::vector<unsigned int> order(faceCount);
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(), [&distances](unsigned int lhs, unsigned int rhs) {
+        return distances[lhs] > distances[rhs];
+    });
+    return order;
+}
+
+std::vector<unsigned int> TransparencySorter::BuildIndices(const std::vector<unsigned int>& order) {
+    std::vector<unsigned int> indices;
+    indices.reserve(order.size() * 6);
+    for (unsigned int face : order) {
+        const unsigned int base = face * 4;
+        indices.push_back(base);
+        indices.push_back(base + 1);
+        indices.push_back(base + 2);
+        indices.push_back(base);
+        indices.push_back(base + 2);
+        indices.push_back(base + 3);
+    }
+    return indices;
+}
+
+void TransparencySorter::WorkerMain() {
+    while (true) {
+        TransparentSortJob job;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Cv.wait(lock, [this]() {
+                return m_ShuttingDown || !m_PendingJobs.empty();
+            });
+
+            if (m_ShuttingDown) {
+                return;
+            }
+
+            auto it = m_PendingJobs.begin();
+            job = std::move(it->second);
+            m_PendingJobs.erase(it);
+        }
+
+        TransparentSortResult result;
+        result.pos = job.pos;
+        result.meshVersion = job.meshVersion;
+        if (job.faceCenters) {
+            const std::vector<unsigned int> order = SortFaces(*job.faceCenters, job.cameraPos);
+            if (job.packedFaces && job.packedFaces->size() == order.size()) {
+                result.packedFaces.reserve(order.size());
+                for (unsigned int face : order) {
+                    result.packedFaces.push_back((*job.packedFaces)[face]);
+                }
+            } else {
+                result.indices = BuildIndices(order);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Results.push_back(std::move(result));
+        }
+    }
+}
+
+} // namespace Minecraft
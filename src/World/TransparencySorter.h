@@ -0,0 +1,57 @@
+#pragma once
+
+#include "World.h"
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace Minecraft {
+
+// Back-to-front sorts transparent faces on a worker thread and hands back finished index buffers.
+struct TransparentSortJob {
+    ChunkPos pos;
+    uint32_t meshVersion = 0;
+    std::shared_ptr<const std::vector<glm::vec3>> faceCenters;
+    std::shared_ptr<const std::vector<uint32_t>> packedFaces;  // Set for MeshFormat::PackedFaces chunks
+    glm::vec3 cameraPos = glm::vec3(0.0f);
+};
+
+struct TransparentSortResult {
+    ChunkPos pos;
+    uint32_t meshVersion = 0;
+    std::vector<unsigned int> indices;      // Vertex mesh: sorted index buffer
+    std::vector<uint32_t> packedFaces;      // Packed mesh: face records in sorted order
+};
+
+class TransparencySorter {
+public:
+    TransparencySorter();
+    ~TransparencySorter();
+
+    // Queue a sort; a job still waiting for the same chunk is replaced
+    void Submit(TransparentSortJob job);
+
+    // Move all finished results into the output vector
+    void TakeResults(std::vector<TransparentSortResult>& results);
+
+    // Face order from farthest to nearest
+    static std::vector<unsigned int> SortFaces(const std::vector<glm::vec3>& faceCenters, const glm::vec3& cameraPos);
+    static std::vector<unsigned int> BuildIndices(const std::vector<unsigned int>& order);
+
+private:
+    void WorkerMain();
+
+    std::unordered_map<ChunkPos, TransparentSortJob> m_PendingJobs;
+    std::vector<TransparentSortResult> m_Results;
+    bool m_ShuttingDown = false;
+    std::mutex m_Mutex;
+    std::condition_variable m_Cv;
+    std::thread m_Worker;
+};
+
+} // namespace Minecraft
@@ -1,30 +1,69 @@
 #include "World.h"
 #include "Block.h"
+#include "ChunkGenerationPool.h"
+#include "ChunkMeshBuilder.h"
+#include "FarTerrain.h"
+#include "TransparencySorter.h"
 #include "WorldGeneration.h"
-#include "../Utils/Logger.h"
+#include "../Render/FramePacket.h"
+#include "../Render/OcclusionCuller.h"
+#include "../utils/Logger.h"
 #include <algorithm>
 #include <chrono>
 #include <cmath>
 
 namespace Minecraft {
 
-World::World() {
-    m_GenerationWorker = std::thread(&World::GenerationWorkerMain, this);
-    LOG_INFO("World created");
+namespace {
+
+uint64_t ChunkPosToKey(const ChunkPos& pos) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(pos.x)) << 32) | static_cast<uint32_t>(pos.z);
 }
 
-World::~World() {
-    {
-        std::lock_guard<std::mutex> lock(m_GenerationMutex);
-        m_ShuttingDown = true;
-    }
-    m_GenerationCv.notify_all();
+ChunkPos KeyToChunkPos(uint64_t key) {
+    return ChunkPos(static_cast<int32_t>(key >> 32), static_cast<int32_t>(key & 0xffffffffU));
+}
+
+bool IsOccluderBlock(BlockType type) {
+    return type != BlockType::Air && !Block::IsTransparent(type);
+}
+
+ChunkOccluder ComputeOccluder(const Chunk& chunk) {
+    ChunkOccluder occluder;
+    occluder.solidHeights.fill(CHUNK_HEIGHT);
+    int topHeight = 0;
+
+    for (int x = 0; x < CHUNK_SIZE; ++x) {
+        for (int z = 0; z < CHUNK_SIZE; ++z) {
+            int solid = 0;
+            while (solid < CHUNK_HEIGHT && IsOccluderBlock(chunk.GetBlock(x, solid, z))) {
+                solid++;
+            }
 
-    if (m_GenerationWorker.joinable()) {
-        m_GenerationWorker.join();
+            const int top = std::max(solid, chunk.GetColumnHeight(x, z));
+
+            const int quadrant = (x >= CHUNK_SIZE / 2 ? 1 : 0) + (z >= CHUNK_SIZE / 2 ? 2 : 0);
+            occluder.solidHeights[quadrant] = std::min(occluder.solidHeights[quadrant], solid);
+            topHeight = std::max(topHeight, top);
+        }
     }
+
+    occluder.topHeight = topHeight;
+    return occluder;
+}
+
+} // namespace
+
+World::World(int generationWorkers)
+    : m_OcclusionCuller(std::make_unique<OcclusionCuller>())
+    , m_TransparencySorter(std::make_unique<TransparencySorter>())
+    , m_FarTerrain(std::make_unique<FarTerrain>())
+    , m_GenerationPool(std::make_unique<ChunkGenerationPool>(generationWorkers)) {
+    LOG_INFO("World created with " + std::to_string(m_GenerationPool->GetWorkerCount()) + " generation workers");
 }
 
+World::~World() = default;
+
 void World::Initialize(const glm::vec3& playerPos) {
     const ChunkPos centerChunk = WorldToChunkPos(playerPos);
     m_LastPlayerChunk = centerChunk;
@@ -33,6 +72,7 @@ void World::Initialize(const glm::vec3& playerPos) {
              std::to_string(centerChunk.x) + ", " +
              std::to_string(centerChunk.z) + ")");
 
+    UpdateGenerationFocus(centerChunk);
     QueueChunksAroundPlayer(centerChunk);
 
     const int initialChunkCount = (m_RenderDistance * 2 + 1) * (m_RenderDistance * 2 + 1);
@@ -47,7 +87,7 @@ void World::Initialize(const glm::vec3& playerPos) {
     LOG_INFO("World initialized with " + std::to_string(m_LoadedChunks.size()) + " chunks");
 }
 
-void World::Update(const glm::vec3& playerPos) {
+void World::Update(const glm::vec3& playerPos, std::chrono::steady_clock::time_point deadline) {
     const ChunkPos currentChunk = WorldToChunkPos(playerPos);
 
     if (!(currentChunk == m_LastPlayerChunk)) {
@@ -57,26 +97,151 @@ void World::Update(const glm::vec3& playerPos) {
         m_LastPlayerChunk = currentChunk;
     }
 
+    UpdateGenerationFocus(currentChunk);
     QueueChunksAroundPlayer(currentChunk);
     ProcessChunkGeneration(m_ChunkGenerationBudget);
-    ProcessChunkMeshing(m_ChunkMeshingBudget);
+    ProcessChunkMeshing(m_ChunkMeshingBudget, deadline);
     UnloadDistantChunks(currentChunk);
+    UpdateKnownChunks(currentChunk);
+    m_FarTerrain->Update(playerPos, m_RenderDistance, m_RenderCommands);
 }
 
-void World::RenderOpaque() {
-    for (auto& [pos, record] : m_LoadedChunks) {
-        if (record.chunk) {
-            record.chunk->RenderOpaque();
+void World::UpdateOcclusion(const glm::mat4& viewProjection, const glm::vec3& cameraPos) {
+    if (!m_OcclusionCullingEnabled) {
+        return;
+    }
+
+    OcclusionCuller::Result result;
+    if (m_OcclusionCuller->TryTakeResult(result)) {
+        m_OccludedChunks.clear();
+        for (uint64_t key : result.occludedKeys) {
+            m_OccludedChunks.insert(KeyToChunkPos(key));
+        }
+        m_LastOcclusionTimeMs = result.cullTimeMs;
+    }
+
+    OcclusionCuller::Frame frame;
+    frame.viewProjection = viewProjection;
+    frame.cameraPosition = cameraPos;
+    frame.candidates.reserve(m_LoadedChunks.size());
+    frame.occluders.reserve(m_LoadedChunks.size() * 4);
+
+    constexpr float half = static_cast<float>(CHUNK_SIZE / 2);
+    for (const auto& [pos, record] : m_LoadedChunks) {
+        if (!record.chunk || !record.chunk->IsMeshBuilt()) {
+            continue;
+        }
+
+        const glm::vec3 origin(static_cast<float>(pos.x * CHUNK_SIZE), 0.0f, static_cast<float>(pos.z * CHUNK_SIZE));
+        const ChunkOccluder& occluder = record.occluder;
+        frame.candidates.push_back({
+            ChunkPosToKey(pos),
+            AABB(origin, origin + glm::vec3(CHUNK_SIZE, static_cast<float>(occluder.topHeight), CHUNK_SIZE))
+        });
+
+        for (int quadrant = 0; quadrant < 4; ++quadrant) {
+            const float height = static_cast<float>(occluder.solidHeights[quadrant]);
+            if (height <= 0.0f) {
+                continue;
+            }
+            const glm::vec3 quadrantMin = origin + glm::vec3((quadrant & 1) ? half : 0.0f, 0.0f, (quadrant & 2) ? half : 0.0f);
+            frame.occluders.emplace_back(quadrantMin, quadrantMin + glm::vec3(half, height, half));
         }
     }
+
+    m_OcclusionCuller->Submit(std::move(frame));
+}
+
+void World::SetOcclusionCullingEnabled(bool enabled) {
+    m_OcclusionCullingEnabled = enabled;
+    if (!enabled) {
+        m_OccludedChunks.clear();
+    }
 }
 
-void World::RenderTransparent() {
-    for (auto& [pos, record] : m_LoadedChunks) {
-        if (record.chunk) {
-            record.chunk->RenderTransparent();
+void World::UpdateTransparentSorting(const glm::vec3& cameraPos) {
+    std::vector<TransparentSortResult> results;
+    m_TransparencySorter->TakeResults(results);
+    for (auto& result : results) {
+        if (!GetChunk(result.pos)) {
+            continue;
         }
+        RenderCommand command;
+        command.type = RenderCommandType::UpdateTransparentOrder;
+        command.pos = result.pos;
+        command.meshVersion = result.meshVersion;
+        command.indices = std::move(result.indices);
+        command.packedFaces = std::move(result.packedFaces);
+        m_RenderCommands.push_back(std::move(command));
     }
+
+    m_SortCameraPos = cameraPos;
+    const glm::ivec3 cameraBlock(glm::floor(cameraPos));
+    if (cameraBlock == m_SortCameraBlock) {
+        return;
+    }
+    m_SortCameraBlock = cameraBlock;
+
+    for (const auto& [pos, record] : m_LoadedChunks) {
+        if (record.chunk && record.chunk->HasTransparentGeometry()) {
+            QueueTransparentSort(pos, *record.chunk);
+        }
+    }
+}
+
+void World::QueueTransparentSort(const ChunkPos& pos, const Chunk& chunk) {
+    TransparentSortJob job;
+    job.pos = pos;
+    job.meshVersion = chunk.GetMeshVersion();
+    job.faceCenters = chunk.GetTransparentFaceCenters();
+    job.packedFaces = chunk.GetTransparentFaces();
+    job.cameraPos = m_SortCameraPos;
+    m_TransparencySorter->Submit(std::move(job));
+}
+
+void World::BuildFramePacket(FramePacket& packet, const glm::vec3& cameraPos) {
+    packet.regionBatching = m_RegionBatchingEnabled;
+    packet.commands = std::move(m_RenderCommands);
+    m_RenderCommands.clear();
+
+    m_FarTerrain->GetDrawList(packet.farTiles);
+    packet.horizonDistance = m_FarTerrain->GetHorizonDistance();
+    packet.voxelMin = glm::vec2(m_LastPlayerChunk.x - m_RenderDistance, m_LastPlayerChunk.z - m_RenderDistance) * static_cast<float>(CHUNK_SIZE);
+    packet.voxelMax = glm::vec2(m_LastPlayerChunk.x + m_RenderDistance + 1, m_LastPlayerChunk.z + m_RenderDistance + 1) * static_cast<float>(CHUNK_SIZE);
+
+    std::vector<std::pair<float, ChunkPos>> transparentChunks;
+    packet.opaqueChunks.reserve(m_LoadedChunks.size());
+    for (const auto& [pos, record] : m_LoadedChunks) {
+        if (!record.chunk || !record.chunk->IsMeshBuilt() ||
+            m_OccludedChunks.find(pos) != m_OccludedChunks.end()) {
+            continue;
+        }
+
+        packet.opaqueChunks.push_back(pos);
+        if (record.chunk->HasTransparentGeometry()) {
+            const glm::vec2 center((pos.x + 0.5f) * CHUNK_SIZE, (pos.z + 0.5f) * CHUNK_SIZE);
+            const glm::vec2 offset = center - glm::vec2(cameraPos.x, cameraPos.z);
+            transparentChunks.push_back({glm::dot(offset, offset), pos});
+        }
+    }
+
+    std::sort(transparentChunks.begin(), transparentChunks.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first > rhs.first;
+    });
+
+    packet.transparentChunks.reserve(transparentChunks.size());
+    for (const auto& [distanceSq, pos] : transparentChunks) {
+        (void)distanceSq;
+        packet.transparentChunks.push_back(pos);
+    }
+}
+
+float World::GetHorizonDistance() const {
+    return m_FarTerrain->GetHorizonDistance();
+}
+
+size_t World::GetFarTileCount() const {
+    return m_FarTerrain->GetTileCount();
 }
 
 ChunkPos World::WorldToChunkPos(const glm::vec3& worldPos) {
@@ -114,6 +279,32 @@ BlockType World::GetBlock(int x, int y, int z) {
     return chunk->GetBlock(localX, y, localZ);
 }
 
+int World::GetSurfaceHeight(int x, int z) const {
+    const ChunkPos pos(FloorDiv(x, CHUNK_SIZE), FloorDiv(z, CHUNK_SIZE));
+    const int localX = x - pos.x * CHUNK_SIZE;
+    const int localZ = z - pos.z * CHUNK_SIZE;
+
+    auto loaded = m_LoadedChunks.find(pos);
+    if (loaded != m_LoadedChunks.end() && loaded->second.chunk) {
+        return loaded->second.chunk->GetColumnHeight(localX, localZ);
+    }
+    auto known = m_KnownChunks.find(pos);
+    if (known != m_KnownChunks.end()) {
+        return known->second.heights[localZ * CHUNK_SIZE + localX];
+    }
+    return 0;
+}
+
+BlockType World::GetCollisionBlock(int x, int y, int z) {
+    if (y < 0 || y >= CHUNK_HEIGHT) {
+        return BlockType::Air;
+    }
+    if (GetChunk(ChunkPos(FloorDiv(x, CHUNK_SIZE), FloorDiv(z, CHUNK_SIZE)))) {
+        return GetBlock(x, y, z);
+    }
+    return y < GetSurfaceHeight(x, z) ? BlockType::Stone : BlockType::Air;
+}
+
 bool World::SetBlock(int x, int y, int z, BlockType type) {
     if (y < 0 || y >= CHUNK_HEIGHT) {
         return false;
@@ -138,37 +329,81 @@ bool World::SetBlock(int x, int y, int z, BlockType type) {
     return true;
 }
 
+size_t World::GetGenerationBacklog() const {
+    return m_GenerationPool->GetBacklog();
+}
+
+int World::GetGenerationWorkerCount() const {
+    return m_GenerationPool->GetWorkerCount();
+}
+
+ChunkGenerationStats World::GetGenerationStats() const {
+    return m_GenerationPool->GetStats();
+}
+
+void World::SetViewDirection(const glm::vec3& forward) {
+    const glm::vec2 horizontal(forward.x, forward.z);
+    if (glm::dot(horizontal, horizontal) > 1e-6f) {
+        m_ViewForward = glm::normalize(horizontal);
+    }
+}
+
+void World::UpdateGenerationFocus(const ChunkPos& centerChunk) {
+    // Matches the radius ProcessChunkGeneration accepts, so nothing it would discard gets generated
+    const int radius = m_RenderDistance + m_UnloadDistanceBuffer;
+    // Turning is cheap to follow but happens every frame; only re-sort on a clear change
+    const bool turned = glm::dot(m_ViewForward, m_FocusForward) < 0.7f;
+    if (centerChunk == m_FocusChunk && radius == m_FocusRadius && !turned) {
+        return;
+    }
+
+    m_FocusChunk = centerChunk;
+    m_FocusRadius = radius;
+    m_FocusForward = m_ViewForward;
+    m_GenerationPool->SetFocus(centerChunk, m_ViewForward, radius);
+}
+
+size_t World::EstimateChunkMemoryBytes() const {
+    size_t bytes = 0;
+    for (const auto& [pos, record] : m_LoadedChunks) {
+        (void)pos;
+        if (!record.chunk) {
+            continue;
+        }
+        bytes += sizeof(Chunk);
+        if (const auto centers = record.chunk->GetTransparentFaceCenters()) {
+            bytes += centers->capacity() * sizeof(glm::vec3);
+        }
+        if (const auto faces = record.chunk->GetTransparentFaces()) {
+            bytes += faces->capacity() * sizeof(uint32_t);
+        }
+    }
+    // The generation pipeline holds voxels too, mostly decorated neighbours of the outer ring
+    bytes += m_GenerationPool->EstimateMemoryBytes();
+    return bytes + m_KnownChunks.size() * sizeof(ChunkSurface);
+}
+
 bool World::BreakBlock(int x, int y, int z) {
     return SetBlock(x, y, z, BlockType::Air);
 }
 
 void World::QueueChunksAroundPlayer(const ChunkPos& centerChunk) {
-    std::vector<std::pair<int, ChunkPos>> targets;
-    const int targetRadius = m_RenderDistance + m_PreloadDistance;
+    // Only chunks that will be meshed get voxels; the preload ring is just known.
+    // The pool orders the work by distance and view direction.
+    std::vector<ChunkPos> targets;
+    const int targetRadius = m_RenderDistance;
     targets.reserve((targetRadius * 2 + 1) * (targetRadius * 2 + 1));
 
     for (int x = -targetRadius; x <= targetRadius; ++x) {
         for (int z = -targetRadius; z <= targetRadius; ++z) {
             const ChunkPos pos(centerChunk.x + x, centerChunk.z + z);
-            targets.push_back({x * x + z * z, pos});
+            if (m_LoadedChunks.find(pos) == m_LoadedChunks.end()) {
+                targets.push_back(pos);
+            }
         }
     }
 
-    std::sort(targets.begin(), targets.end(),
-              [](const auto& lhs, const auto& rhs) {
-                  if (lhs.first != rhs.first) {
-                      return lhs.first < rhs.first;
-                  }
-                  if (lhs.second.x != rhs.second.x) {
-                      return lhs.second.x < rhs.second.x;
-                  }
-                  return lhs.second.z < rhs.second.z;
-              });
-
-    for (const auto& [distanceSq, pos] : targets) {
-        (void)distanceSq;
-        QueueChunkLoad(pos);
-    }
+    m_GenerationPool->Queue(targets);
 }
 
 void World::UnloadDistantChunks(const ChunkPos& centerChunk) {
@@ -185,6 +420,10 @@ void World::UnloadDistantChunks(const ChunkPos& centerChunk) {
     }
 
     for (const auto& pos : chunksToUnload) {
+        RenderCommand command;
+        command.type = RenderCommandType::ReleaseMesh;
+        command.pos = pos;
+        m_RenderCommands.push_back(std::move(command));
         m_LoadedChunks.erase(pos);
         m_MeshQueued.erase(pos);
     }
@@ -194,16 +433,43 @@ void World::UnloadDistantChunks(const ChunkPos& centerChunk) {
     }
 }
 
-void World::QueueChunkLoad(const ChunkPos& pos) {
-    if (m_LoadedChunks.find(pos) != m_LoadedChunks.end()) {
-        return;
+void World::UpdateKnownChunks(const ChunkPos& centerChunk) {
+    const int knownRadius = m_RenderDistance + m_PreloadDistance;
+    for (auto it = m_KnownChunks.begin(); it != m_KnownChunks.end();) {
+        if (!IsChunkWithinRadius(it->first, centerChunk, knownRadius + m_UnloadDistanceBuffer) ||
+            m_LoadedChunks.find(it->first) != m_LoadedChunks.end()) {
+            it = m_KnownChunks.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // Surfaces the generation workers read since the last update
+    std::vector<ChunkSurfaceResult> surfaces;
+    m_GenerationPool->TakeSurfaces(surfaces);
+    for (ChunkSurfaceResult& result : surfaces) {
+        if (IsChunkWithinRadius(result.pos, centerChunk, knownRadius + m_UnloadDistanceBuffer) &&
+            m_LoadedChunks.find(result.pos) == m_LoadedChunks.end()) {
+            m_KnownChunks[result.pos] = result.surface;
+        }
     }
 
-    std::lock_guard<std::mutex> lock(m_GenerationMutex);
-    if (m_GenerationQueued.insert(pos).second) {
-        m_GenerationQueue.push_back(pos);
-        m_GenerationCv.notify_one();
+    // Nearest rings first; demoted chunks drop their voxels and come back here
+    std::vector<ChunkPos> missing;
+    const int budget = m_KnownChunkBudget;
+    for (int ring = 0; ring <= knownRadius && static_cast<int>(missing.size()) < budget; ++ring) {
+        for (int x = -ring; x <= ring && static_cast<int>(missing.size()) < budget; ++x) {
+            const int step = (x == -ring || x == ring) ? 1 : 2 * ring;
+            for (int z = -ring; z <= ring && static_cast<int>(missing.size()) < budget; z += step) {
+                const ChunkPos pos(centerChunk.x + x, centerChunk.z + z);
+                if (m_LoadedChunks.find(pos) == m_LoadedChunks.end() &&
+                    m_KnownChunks.find(pos) == m_KnownChunks.end()) {
+                    missing.push_back(pos);
+                }
+            }
+        }
     }
+    m_GenerationPool->QueueSurfaces(missing);
 }
 
 void World::QueueChunkMesh(const ChunkPos& pos) {
@@ -228,31 +494,18 @@ void World::MarkChunkAndNeighborsDirty(const ChunkPos& pos) {
 
 void World::ProcessChunkGeneration(int budget) {
     std::vector<GeneratedChunkResult> readyChunks;
-    {
-        std::lock_guard<std::mutex> lock(m_ReadyChunksMutex);
-        const int readyCount = std::min(budget, static_cast<int>(m_ReadyChunks.size()));
-        readyChunks.reserve(readyCount);
-        for (int i = 0; i < readyCount; ++i) {
-            readyChunks.push_back(std::move(m_ReadyChunks.front()));
-            m_ReadyChunks.pop_front();
-        }
-    }
+    m_GenerationPool->TakeResults(readyChunks, static_cast<size_t>(std::max(budget, 0)));
 
     int integratedCount = 0;
     for (auto& result : readyChunks) {
-        {
-            std::lock_guard<std::mutex> lock(m_GenerationMutex);
-            m_GenerationQueued.erase(result.pos);
-        }
-
-        if (!IsChunkWithinRadius(result.pos, m_LastPlayerChunk, m_RenderDistance + m_PreloadDistance + m_UnloadDistanceBuffer)) {
-            continue;
-        }
-
-        if (m_LoadedChunks.find(result.pos) != m_LoadedChunks.end()) {
+        if (!IsChunkWithinRadius(result.pos, m_LastPlayerChunk, m_RenderDistance + m_UnloadDistanceBuffer) ||
+            m_LoadedChunks.find(result.pos) != m_LoadedChunks.end()) {
+            m_GenerationPool->CountWasted();
             continue;
         }
 
+        // Promoted: the voxels replace the known surface
+        m_KnownChunks.erase(result.pos);
         ChunkRecord record;
         record.chunk = std::move(result.chunk);
         m_LoadedChunks[result.pos] = std::move(record);
@@ -265,10 +518,14 @@ void World::ProcessChunkGeneration(int budget) {
     }
 }
 
-void World::ProcessChunkMeshing(int budget) {
+void World::ProcessChunkMeshing(int budget, std::chrono::steady_clock::time_point deadline) {
     int meshedCount = 0;
 
     while (!m_MeshQueue.empty() && meshedCount < budget) {
+        if (meshedCount > 0 && std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+
         const ChunkPos pos = m_MeshQueue.front();
         m_MeshQueue.pop_front();
         m_MeshQueued.erase(pos);
@@ -278,8 +535,18 @@ void World::ProcessChunkMeshing(int budget) {
             continue;
         }
 
-        it->second.chunk->BuildMesh(this);
+        RenderCommand command;
+        command.type = RenderCommandType::UploadMesh;
+        command.pos = pos;
+        command.mesh = it->second.chunk->BuildMesh([this](int x, int y, int z) { return GetBlock(x, y, z); });
+        command.meshVersion = it->second.chunk->GetMeshVersion();
+        m_RenderCommands.push_back(std::move(command));
+
+        it->second.occluder = ComputeOccluder(*it->second.chunk);
         it->second.meshDirty = false;
+        if (it->second.chunk->HasTransparentGeometry()) {
+            QueueTransparentSort(pos, *it->second.chunk);
+        }
         meshedCount++;
     }
 
@@ -288,33 +555,6 @@ void World::ProcessChunkMeshing(int budget) {
     }
 }
 
-void World::GenerationWorkerMain() {
-    while (true) {
-        ChunkPos pos;
-        {
-            std::unique_lock<std::mutex> lock(m_GenerationMutex);
-            m_GenerationCv.wait(lock, [this]() {
-                return m_ShuttingDown || !m_GenerationQueue.empty();
-            });
-
-            if (m_ShuttingDown) {
-                return;
-            }
-
-            pos = m_GenerationQueue.front();
-            m_GenerationQueue.pop_front();
-        }
-
-        auto chunk = std::make_unique<Chunk>(pos.x, pos.z);
-        WorldGeneration::PopulateChunk(*chunk);
-
-        {
-            std::lock_guard<std::mutex> lock(m_ReadyChunksMutex);
-            m_ReadyChunks.push_back({pos, std::move(chunk)});
-        }
-    }
-}
-
 bool World::IsChunkWithinRadius(const ChunkPos& pos, const ChunkPos& centerChunk, int radius) const {
     return std::abs(pos.x - centerChunk.x) <= radius &&
            std::abs(pos.z - centerChunk.z) <= radius;
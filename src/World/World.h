@@ -1,11 +1,12 @@
 #pragma once
 
 #include "Chunk.h"
+#include <array>
+#include <chrono>
 #include <climits>
-#include <condition_variable>
+#include <cstdint>
 #include <deque>
 #include <memory>
-#include <mutex>
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
@@ -27,15 +28,41 @@ struct ChunkPos {
     }
 };
 
+// Simplified occluder geometry for the CPU occlusion pass
+struct ChunkOccluder {
+    std::array<int, 4> solidHeights{};  // Height of the fully opaque floor per 8x8 quadrant
+    int topHeight = CHUNK_HEIGHT;       // One above the highest non-air block
+};
+
 struct ChunkRecord {
     std::unique_ptr<Chunk> chunk;
     bool meshDirty = false;
+    ChunkOccluder occluder;
+};
+
+// The light tier of a chunk that is known but has no voxels: its 2D terrain fields,
+// indexed z * CHUNK_SIZE + x. Under 2 KB against the 64 KB of a loaded chunk.
+struct ChunkSurface {
+    std::array<uint16_t, CHUNK_SIZE * CHUNK_SIZE> heights{};  // Solid blocks in the column
+    std::array<BlockType, CHUNK_SIZE * CHUNK_SIZE> surfaces{};
+    std::array<float, CHUNK_SIZE * CHUNK_SIZE> biomes{};
 };
 
 struct GeneratedChunkResult {
     ChunkPos pos;
     std::unique_ptr<Chunk> chunk;
 };
+
+struct ChunkSurfaceResult {
+    ChunkPos pos;
+    ChunkSurface surface;
+};
+
+struct ChunkGenerationStats {
+    uint64_t generated = 0;  // Finished while still wanted
+    uint64_t cancelled = 0;  // Left the radius before it was finished
+    uint64_t wasted = 0;     // Generated but thrown away
+};
 
 } // namespace Minecraft
 
@@ -51,24 +78,62 @@ namespace std {
 
 namespace Minecraft {
 
+class ChunkGenerationPool;
+class FarTerrain;
+class OcclusionCuller;
+class TransparencySorter;
+struct FramePacket;
+struct RenderCommand;
+
 class World {
 public:
-    World();
+    // 0 generation workers = one per hardware thread
+    explicit World(int generationWorkers = 0);
     ~World();
     
     // Initialize world around player spawn position
     void Initialize(const glm::vec3& playerPos);
     
-    // Update world based on player position
-    void Update(const glm::vec3& playerPos);
+    // Update world based on player position. Meshing stops at `deadline` once at
+    // least one chunk was meshed; the rest waits for the next update.
+    // Also keeps the far terrain selected around the player.
+    void Update(const glm::vec3& playerPos,
+                std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max());
     
-    // Render all loaded chunks
-    void RenderOpaque();
-    void RenderTransparent();
+    // Submit this frame to the occlusion worker and pick up the previous frame's result
+    void UpdateOcclusion(const glm::mat4& viewProjection, const glm::vec3& cameraPos);
+
+    // Re-sort transparent faces on the worker when the camera enters a new block,
+    // and queue the orders that finished sorting for the render thread
+    void UpdateTransparentSorting(const glm::vec3& cameraPos);
+
+    // Fill the packet's chunk lists (transparent chunks back to front) and hand over
+    // the GPU commands queued since the last packet
+    void BuildFramePacket(FramePacket& packet, const glm::vec3& cameraPos);
     
     // Get render distance
     int GetRenderDistance() const { return m_RenderDistance; }
     void SetRenderDistance(int distance) { m_RenderDistance = distance; }
+    int GetUnloadDistanceBuffer() const { return m_UnloadDistanceBuffer; }
+
+    // Chunks integrated from the generator / meshed per Update
+    int GetChunkGenerationBudget() const { return m_ChunkGenerationBudget; }
+    void SetChunkGenerationBudget(int budget) { m_ChunkGenerationBudget = budget; }
+    int GetChunkMeshingBudget() const { return m_ChunkMeshingBudget; }
+    void SetChunkMeshingBudget(int budget) { m_ChunkMeshingBudget = budget; }
+
+    // Streaming backlog: chunks waiting for or finished by the generator, and chunks waiting for a mesh
+    size_t GetGenerationBacklog() const;
+    int GetGenerationWorkerCount() const;
+    ChunkGenerationStats GetGenerationStats() const;
+
+    // Horizontal view direction; chunks in front of the player are generated first
+    void SetViewDirection(const glm::vec3& forward);
+    size_t GetMeshBacklog() const { return m_MeshQueue.size(); }
+
+    // Block storage and CPU-side mesh data of loaded chunks, the surfaces of known ones and
+    // what the generation pipeline holds
+    size_t EstimateChunkMemoryBytes() const;
     
     // Get chunk at position (returns nullptr if not loaded)
     Chunk* GetChunk(const ChunkPos& pos);
@@ -84,37 +149,75 @@ public:
     
     // Get loaded chunk count
     size_t GetLoadedChunkCount() const { return m_LoadedChunks.size(); }
+
+    // Chunks are loaded with voxels inside the render distance and unloaded past the
+    // unload buffer. Out to the preload distance beyond that, and while waiting for
+    // their voxels, chunks are only known: they keep their terrain surface.
+    size_t GetKnownChunkCount() const { return m_KnownChunks.size(); }
+
+    // Solid blocks in the column from the voxels if loaded, else from the known surface;
+    // 0 if the chunk is neither
+    int GetSurfaceHeight(int x, int z) const;
+
+    // Block for collision tests: the voxels where loaded, else solid below the known surface,
+    // so nothing falls through ground whose voxels are still being generated
+    BlockType GetCollisionBlock(int x, int y, int z);
+
+    // Occlusion culling
+    void SetOcclusionCullingEnabled(bool enabled);
+    bool IsOcclusionCullingEnabled() const { return m_OcclusionCullingEnabled; }
+    size_t GetOccludedChunkCount() const { return m_OccludedChunks.size(); }
+    float GetLastOcclusionTimeMs() const { return m_LastOcclusionTimeMs; }
+
+    // Region batching of settled opaque chunk meshes, applied by the render thread
+    void SetRegionBatchingEnabled(bool enabled) { m_RegionBatchingEnabled = enabled; }
+    bool IsRegionBatchingEnabled() const { return m_RegionBatchingEnabled; }
     
+    // Heightmap horizon beyond the render distance
+    float GetHorizonDistance() const;
+    size_t GetFarTileCount() const;
+
     // Convert world position to chunk position
     static ChunkPos WorldToChunkPos(const glm::vec3& worldPos);
 
 private:
     void QueueChunksAroundPlayer(const ChunkPos& centerChunk);
     void UnloadDistantChunks(const ChunkPos& centerChunk);
-    void QueueChunkLoad(const ChunkPos& pos);
+    void UpdateKnownChunks(const ChunkPos& centerChunk);
+    void UpdateGenerationFocus(const ChunkPos& centerChunk);
     void QueueChunkMesh(const ChunkPos& pos);
     void MarkChunkAndNeighborsDirty(const ChunkPos& pos);
+    void QueueTransparentSort(const ChunkPos& pos, const Chunk& chunk);
     void ProcessChunkGeneration(int budget);
-    void ProcessChunkMeshing(int budget);
-    void GenerationWorkerMain();
+    void ProcessChunkMeshing(int budget,
+                             std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max());
     bool IsChunkWithinRadius(const ChunkPos& pos, const ChunkPos& centerChunk, int radius) const;
 
     std::unordered_map<ChunkPos, ChunkRecord> m_LoadedChunks;
+    std::unordered_map<ChunkPos, ChunkSurface> m_KnownChunks;  // Never also in m_LoadedChunks
     std::deque<ChunkPos> m_MeshQueue;
-    std::deque<ChunkPos> m_GenerationQueue;
-    std::deque<GeneratedChunkResult> m_ReadyChunks;
-    std::unordered_set<ChunkPos> m_GenerationQueued;
     std::unordered_set<ChunkPos> m_MeshQueued;
-    std::mutex m_GenerationMutex;
-    std::mutex m_ReadyChunksMutex;
-    std::condition_variable m_GenerationCv;
-    std::thread m_GenerationWorker;
-    bool m_ShuttingDown = false;
+    std::unordered_set<ChunkPos> m_OccludedChunks;
+    std::unique_ptr<OcclusionCuller> m_OcclusionCuller;
+    bool m_OcclusionCullingEnabled = true;
+    float m_LastOcclusionTimeMs = 0.0f;
+    std::vector<RenderCommand> m_RenderCommands;  // Pending until the next BuildFramePacket
+    bool m_RegionBatchingEnabled = true;
+    std::unique_ptr<TransparencySorter> m_TransparencySorter;
+    std::unique_ptr<FarTerrain> m_FarTerrain;
+    glm::ivec3 m_SortCameraBlock = glm::ivec3(INT_MAX);
+    glm::vec3 m_SortCameraPos = glm::vec3(0.0f);
+    std::unique_ptr<ChunkGenerationPool> m_GenerationPool;
+    glm::vec2 m_ViewForward = glm::vec2(0.0f, -1.0f);
+    glm::vec2 m_FocusForward = glm::vec2(0.0f);
+    ChunkPos m_FocusChunk = {INT_MAX, INT_MAX};
+    int m_FocusRadius = -1;
     int m_RenderDistance = 4;  // Render distance in chunks
     int m_PreloadDistance = 2;
     int m_UnloadDistanceBuffer = 2;
     int m_ChunkGenerationBudget = 4;
     int m_ChunkMeshingBudget = 2;
+    int m_KnownChunkBudget = 32;  // Surfaces requested from the generation workers at a time
     ChunkPos m_LastPlayerChunk = {INT_MAX, INT_MAX};
 };
 
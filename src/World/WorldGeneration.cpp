@@ -1,7 +1,14 @@
 #include "WorldGeneration.h"
 
+#include "BatchedNoise.h"
 #include "Chunk.h"
-#include "../Utils/FastNoiseLite.h"
+#include "StructureTemplate.h"
+#include "TerrainFieldCache.h"
+#include "../utils/FastNoiseLite.h"
+#include "../utils/Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <cstdint>
 #include <vector>
@@ -12,7 +19,9 @@ namespace {
 
 struct TerrainColumn {
     int topY = 0;
+    int deepTop = 0;  // Stone below this y, subsurface from here to topY
     BlockType surface = BlockType::Air;
+    BlockType subsurface = BlockType::Air;
 };
 
 uint32_t HashU32(uint32_t x) {
@@ -24,10 +33,18 @@ uint32_t HashU32(uint32_t x) {
     return x;
 }
 
+std::atomic<int> s_WorldSeed{0};
+std::atomic<bool> s_NoiseCreated{false};
+
+// World seed 0 leaves the base seeds unchanged
+int MixSeed(int baseSeed, int worldSeed) {
+    return static_cast<int>(static_cast<uint32_t>(baseSeed) + static_cast<uint32_t>(worldSeed));
+}
+
 uint32_t SeedFromChunk(int chunkX, int chunkZ) {
     uint32_t a = HashU32(static_cast<uint32_t>(chunkX) + 0x9e3779b9U);
     uint32_t b = HashU32(static_cast<uint32_t>(chunkZ) + 0x85ebca6bU);
-    return HashU32(a ^ (b << 1));
+    return HashU32(a ^ (b << 1) ^ HashU32(static_cast<uint32_t>(s_WorldSeed.load())));
 }
 
 uint32_t NextU32(uint32_t& state) {
@@ -40,154 +57,528 @@ int NextInt(uint32_t& state, int minValue, int maxValue) {
     return minValue + static_cast<int>(r % static_cast<uint32_t>(maxValue - minValue + 1));
 }
 
-} // namespace
+constexpr int HEIGHT_SEED = 1337;
+constexpr float HEIGHT_FREQUENCY = 0.01f;
+constexpr int BIOME_SEED = 7331;
+constexpr float BIOME_FREQUENCY = 0.003f;
 
-void WorldGeneration::PopulateChunk(Chunk& chunk) {
-    const glm::ivec2 chunkPos = chunk.GetPosition();
-    const int chunkX = chunkPos.x;
-    const int chunkZ = chunkPos.y;
+struct NoiseOctave {
+    float scale;
+    float amplitude;
+};
+
+constexpr NoiseOctave HEIGHT_OCTAVES[] = {{1.0f, 30.0f}, {3.0f, 10.0f}, {8.0f, 3.0f}};
+
+// Dirt depth reads the biome noise at a shifted, finer scale
+constexpr float DIRT_SCALE = 2.1f;
+constexpr float DIRT_OFFSET_X = 13.0f;
+constexpr float DIRT_OFFSET_Z = -19.0f;
+
+constexpr int CHUNK_AREA = CHUNK_SIZE * CHUNK_SIZE;
+
+// Cave density: 3D Perlin, squashed vertically so chambers are wider than tall
+constexpr int CAVE_SEED = 4242;
+constexpr float CAVE_FREQUENCY = 0.025f;
+constexpr float CAVE_Y_STRETCH = 1.2f;
+constexpr float CAVE_THRESHOLD = 0.30f;       // Air where the density is above this
+constexpr int CAVE_FLOOR = 2;                 // Bottom layers stay solid
+constexpr int CAVE_CRUST = 6;                 // Caves thin out this close to the surface
+constexpr float CAVE_CRUST_PENALTY = 0.03f;   // Threshold added per block inside the crust
+constexpr int CAVE_LATTICE_XZ = CHUNK_SIZE / WorldGeneration::CAVE_CELL_XZ + 1;
+constexpr int CAVE_LATTICE_Y = CHUNK_HEIGHT / WorldGeneration::CAVE_CELL_Y + 1;
+
+std::atomic<bool> s_CavesEnabled{true};
+
+// Height and biome noise shared by chunk population and surface sampling
+struct TerrainNoise {
+    BatchedPerlin heightNoise;
+    BatchedPerlin biomeNoise;
+    FastNoiseLite caveNoise;
+
+    explicit TerrainNoise(int worldSeed)
+        : heightNoise(MixSeed(HEIGHT_SEED, worldSeed), HEIGHT_FREQUENCY)
+        , biomeNoise(MixSeed(BIOME_SEED, worldSeed), BIOME_FREQUENCY) {
+        caveNoise.SetNoiseType(FastNoiseLite::NoiseType_Perlin);
+        caveNoise.SetFrequency(CAVE_FREQUENCY);
+        caveNoise.SetSeed(MixSeed(CAVE_SEED, worldSeed));
+    }
 
-    FastNoiseLite heightNoise;
-    heightNoise.SetNoiseType(FastNoiseLite::NoiseType_Perlin);
-    heightNoise.SetFrequency(0.01f);
-    heightNoise.SetSeed(1337);
+    float CaveDensity(int worldX, int y, int worldZ) const {
+        return caveNoise.GetNoise(static_cast<float>(worldX), static_cast<float>(y) * CAVE_Y_STRETCH,
+                                  static_cast<float>(worldZ));
+    }
 
-    FastNoiseLite biomeNoise;
-    biomeNoise.SetNoiseType(FastNoiseLite::NoiseType_Perlin);
-    biomeNoise.SetFrequency(0.003f);
-    biomeNoise.SetSeed(7331);
+    // Summed height octaves for every sample of `grid`; scale is taken from the octaves
+    void HeightGrid(NoiseGrid grid, float* out) const {
+        std::fill(out, out + grid.width * grid.depth, 0.0f);
+        for (const NoiseOctave& octave : HEIGHT_OCTAVES) {
+            grid.scale = octave.scale;
+            heightNoise.AccumulateGrid(grid, octave.amplitude, out);
+        }
+    }
 
-    TerrainColumn columns[CHUNK_SIZE][CHUNK_SIZE];
+    void DirtGrid(NoiseGrid grid, float* out) const {
+        grid.scale = DIRT_SCALE;
+        grid.offsetX = DIRT_OFFSET_X;
+        grid.offsetZ = DIRT_OFFSET_Z;
+        biomeNoise.SampleGrid(grid, out);
+    }
+
+    static int HeightFromNoise(float h) {
+        const int terrainHeight = 64 + static_cast<int>(h);
+        return std::max(1, std::min(terrainHeight, CHUNK_HEIGHT - 1));
+    }
+
+    static int DirtDepth(float dirtNoise) {
+        const int dirtDepth = 1 + static_cast<int>(std::abs(dirtNoise) * 5.0f); // 1..6
+        return std::max(1, std::min(dirtDepth, 6));
+    }
+
+    static BlockType SurfaceForBiome(float biomeValue) {
+        if (biomeValue < -0.3f) {
+            return BlockType::Sand;
+        }
+        if (biomeValue < 0.3f) {
+            return BlockType::Grass;
+        }
+        return BlockType::Stone;
+    }
+};
+
+const TerrainNoise& GetTerrainNoise() {
+    static const TerrainNoise noise = [] {
+        s_NoiseCreated = true;
+        return TerrainNoise(s_WorldSeed);
+    }();
+    return noise;
+}
 
+// Sample every 2D field of a tile in three grid passes
+void FillTerrainTile(TerrainTile& tile) {
+    constexpr int TILE_AREA = TerrainTile::SIDE * TerrainTile::SIDE;
+    const TerrainNoise& noise = GetTerrainNoise();
+
+    NoiseGrid grid;
+    grid.originX = tile.region.x * TerrainTile::SIDE;
+    grid.originZ = tile.region.z * TerrainTile::SIDE;
+    grid.width = TerrainTile::SIDE;
+    grid.depth = TerrainTile::SIDE;
+
+    std::vector<float> heights(TILE_AREA);
+    std::vector<float> dirt(TILE_AREA);
+    noise.HeightGrid(grid, heights.data());
+    noise.biomeNoise.SampleGrid(grid, tile.biomes.data());
+    noise.DirtGrid(grid, dirt.data());
+
+    for (int i = 0; i < TILE_AREA; ++i) {
+        tile.heights[i] = static_cast<uint16_t>(TerrainNoise::HeightFromNoise(heights[i]));
+        tile.surfaces[i] = TerrainNoise::SurfaceForBiome(tile.biomes[i]);
+        tile.dirtDepths[i] = static_cast<uint8_t>(TerrainNoise::DirtDepth(dirt[i]));
+    }
+}
+
+// Columns of a chunk from its region's field tile; returns the stone base shared by all of them
+int ReadTerrainColumns(const Chunk& chunk, TerrainColumn (&columns)[CHUNK_SIZE][CHUNK_SIZE]) {
+    const glm::ivec2 chunkPos = chunk.GetPosition();
+    const glm::ivec3 regionOrigin = chunk.GetRegionOrigin();
+    const std::shared_ptr<const TerrainTile> tile = WorldGeneration::GetFieldCache().Get(
+        ChunkPos(regionOrigin.x / TerrainTile::SIDE, regionOrigin.z / TerrainTile::SIDE));
+    const int tileX = chunkPos.x * CHUNK_SIZE - regionOrigin.x;
+    const int tileZ = chunkPos.y * CHUNK_SIZE - regionOrigin.z;
+
+    int stoneBase = CHUNK_HEIGHT;
     for (int x = 0; x < CHUNK_SIZE; ++x) {
         for (int z = 0; z < CHUNK_SIZE; ++z) {
-            const int worldX = chunkX * CHUNK_SIZE + x;
-            const int worldZ = chunkZ * CHUNK_SIZE + z;
-
-            float h = 0.0f;
-            h += heightNoise.GetNoise(static_cast<float>(worldX) * 1.0f, static_cast<float>(worldZ) * 1.0f) * 30.0f;
-            h += heightNoise.GetNoise(static_cast<float>(worldX) * 3.0f, static_cast<float>(worldZ) * 3.0f) * 10.0f;
-            h += heightNoise.GetNoise(static_cast<float>(worldX) * 8.0f, static_cast<float>(worldZ) * 8.0f) * 3.0f;
-
-            int terrainHeight = 64 + static_cast<int>(h);
-            terrainHeight = std::max(1, std::min(terrainHeight, CHUNK_HEIGHT - 1));
-
-            const float biomeValue = biomeNoise.GetNoise(static_cast<float>(worldX), static_cast<float>(worldZ));
-
-            BlockType surfaceBlock;
-            BlockType subsurfaceBlock;
-            BlockType deepBlock;
-            int dirtDepth = 0;  // Only meaningful for grass biome.
-            if (biomeValue < -0.3f) {
-                surfaceBlock = BlockType::Sand;
-                subsurfaceBlock = BlockType::Sand;
-                deepBlock = BlockType::Stone;
-            } else if (biomeValue < 0.3f) {
-                surfaceBlock = BlockType::Grass;
-                subsurfaceBlock = BlockType::Dirt;
-                deepBlock = BlockType::Stone;
-                dirtDepth = 1 + static_cast<int>(std::abs(biomeNoise.GetNoise(
-                    static_cast<float>(worldX) * 2.1f + 13.0f,
-                    static_cast<float>(worldZ) * 2.1f - 19.0f)) * 5.0f); // 1..6
-                dirtDepth = std::max(1, std::min(dirtDepth, 6));
+            const int index = TerrainTile::Index(tileX + x, tileZ + z);
+            TerrainColumn& column = columns[x][z];
+            column.topY = tile->heights[index] - 1;
+            column.surface = tile->surfaces[index];
+
+            if (column.surface == BlockType::Sand) {
+                // Keep desert surface thicker than one block for natural dunes.
+                column.subsurface = BlockType::Sand;
+                column.deepTop = column.topY - 4;
+            } else if (column.surface == BlockType::Grass) {
+                // Grass biome: exactly one top grass layer, then <=6 dirt layers.
+                column.subsurface = BlockType::Dirt;
+                column.deepTop = column.topY - tile->dirtDepths[index];
             } else {
-                surfaceBlock = BlockType::Stone;
-                subsurfaceBlock = BlockType::Stone;
-                deepBlock = BlockType::Stone;
-            }
-
-            const int topY = terrainHeight - 1;
-            for (int y = 0; y < terrainHeight; ++y) {
-                BlockType blockType;
-                if (y == topY) {
-                    blockType = surfaceBlock;
-                } else if (surfaceBlock == BlockType::Grass && y >= topY - dirtDepth) {
-                    // Grass biome: exactly one top grass layer, then <=6 dirt layers.
-                    blockType = subsurfaceBlock;
-                } else if (surfaceBlock == BlockType::Sand && y >= topY - 4) {
-                    // Keep desert surface thicker than one block for natural dunes.
-                    blockType = subsurfaceBlock;
-                } else {
-                    blockType = deepBlock;
-                }
-                chunk.SetBlock(x, y, z, blockType);
+                column.subsurface = BlockType::Stone;
+                column.deepTop = column.topY;
             }
-
-            columns[x][z].topY = terrainHeight - 1;
-            columns[x][z].surface = surfaceBlock;
+            column.deepTop = std::max(column.deepTop, 0);
+            stoneBase = std::min(stoneBase, column.deepTop);
         }
     }
+    return stoneBase;
+}
 
-    auto placeLeafAt = [&chunk](int x, int y, int z) {
-        if (x < 0 || x >= CHUNK_SIZE || y < 0 || y >= CHUNK_HEIGHT || z < 0 || z >= CHUNK_SIZE) {
-            return;
+constexpr int TREE_SHAPES = 3;  // Straight, bent along x, bent along z then x
+constexpr int TREE_MIN_HEIGHT = 4;
+constexpr int TREE_MAX_HEIGHT = 6;
+constexpr int BOULDER_CHANCE = 4;  // One chunk in this many gets a boulder attempt
+constexpr int BOULDER_SIZES = 2;
+
+void AddLeafBlob(StructureTemplate::Builder& builder, const glm::ivec3& center, int radius) {
+    for (int dx = -radius; dx <= radius; ++dx) {
+        for (int dz = -radius; dz <= radius; ++dz) {
+            if (std::abs(dx) + std::abs(dz) > radius + 1) {
+                continue;
+            }
+            builder.Set(center.x + dx, center.y, center.z + dz, BlockType::Leaves, true);
         }
-        if (chunk.GetBlock(x, y, z) == BlockType::Air) {
-            chunk.SetBlock(x, y, z, BlockType::Leaves);
+    }
+}
+
+// Trunk and canopy anchored at the root block; leaves only grow into air
+StructureTemplate BakeTree(int shape, int height) {
+    StructureTemplate::Builder builder;
+    std::vector<glm::ivec3> trunk;
+    for (int i = 0; i < height; ++i) {
+        glm::ivec3 node(0, i, 0);
+        if (shape == 1 && i >= height / 2) {
+            node.x = 1;
+        } else if (shape == 2 && i >= height / 2) {
+            node.z = 1;
+            if (i >= height - 1) {
+                node.x = 1;
+            }
         }
-    };
+        builder.Set(node.x, node.y, node.z, BlockType::Wood, false);
+        trunk.push_back(node);
+    }
 
-    auto placeLeafBlob = [&placeLeafAt](int cx, int cy, int cz, int radius) {
-        for (int dx = -radius; dx <= radius; ++dx) {
-            for (int dz = -radius; dz <= radius; ++dz) {
-                if (std::abs(dx) + std::abs(dz) > radius + 1) {
-                    continue;
+    const glm::ivec3 top = trunk.back();
+    AddLeafBlob(builder, top, 2);
+    AddLeafBlob(builder, top + glm::ivec3(0, 1, 0), 2);
+    AddLeafBlob(builder, top + glm::ivec3(0, 2, 0), 1);
+    builder.Set(top.x, top.y + 3, top.z, BlockType::Leaves, true);
+    if (trunk.size() >= 2) {
+        AddLeafBlob(builder, trunk[trunk.size() - 2], 1);
+    }
+    if (shape != 0 && trunk.size() >= 4) {
+        AddLeafBlob(builder, trunk[trunk.size() / 2] + glm::ivec3(0, 1, 0), 1);
+    }
+    return builder.Build();
+}
+
+// Squashed stone ellipsoid centred on the anchor; it never replaces terrain or trees
+StructureTemplate BakeBoulder(int size) {
+    const int radius = size + 1;
+    const float rx = static_cast<float>(radius) + 0.5f;
+    const float ry = static_cast<float>(radius) * 0.75f + 0.5f;
+    StructureTemplate::Builder builder;
+    for (int y = -radius; y <= radius; ++y) {
+        for (int z = -radius; z <= radius; ++z) {
+            for (int x = -radius; x <= radius; ++x) {
+                const float d = (x * x + z * z) / (rx * rx) + (y * y) / (ry * ry);
+                if (d <= 1.0f) {
+                    builder.Set(x, y, z, BlockType::Stone, true);
                 }
-                placeLeafAt(cx + dx, cy, cz + dz);
             }
         }
-    };
+    }
+    return builder.Build();
+}
 
-    auto placeTree = [&chunk, &placeLeafAt, &placeLeafBlob](int rootX, int rootY, int rootZ, int templateId, int height) {
-        std::vector<glm::ivec3> trunkNodes;
-        trunkNodes.reserve(height);
+const StructureTemplate& GetTreeTemplate(int shape, int height) {
+    static const std::vector<StructureTemplate> templates = [] {
+        std::vector<StructureTemplate> baked;
+        for (int s = 0; s < TREE_SHAPES; ++s) {
+            for (int h = TREE_MIN_HEIGHT; h <= TREE_MAX_HEIGHT; ++h) {
+                baked.push_back(BakeTree(s, h));
+            }
+        }
+        return baked;
+    }();
+    return templates[shape * (TREE_MAX_HEIGHT - TREE_MIN_HEIGHT + 1) + height - TREE_MIN_HEIGHT];
+}
+
+const StructureTemplate& GetBoulderTemplate(int size) {
+    static const std::vector<StructureTemplate> templates = [] {
+        std::vector<StructureTemplate> baked;
+        for (int s = 0; s < BOULDER_SIZES; ++s) {
+            baked.push_back(BakeBoulder(s));
+        }
+        return baked;
+    }();
+    return templates[size];
+}
+
+// Carve air out of the terrain where the cave density is high enough; returns the blocks carved.
+// The density is sampled on a CAVE_CELL_XZ x CAVE_CELL_Y x CAVE_CELL_XZ lattice and
+// interpolated, unless `perBlock` asks for a sample at every block (benchmark reference).
+int CarveCaves(Chunk& chunk, const TerrainColumn (&columns)[CHUNK_SIZE][CHUNK_SIZE], bool perBlock) {
+    constexpr int CELL_XZ = WorldGeneration::CAVE_CELL_XZ;
+    constexpr int CELL_Y = WorldGeneration::CAVE_CELL_Y;
+    static_assert(CELL_XZ == 4, "rows are upsampled with UpsampleLattice4");
 
-        for (int i = 0; i < height; ++i) {
-            int offsetX = 0;
-            int offsetZ = 0;
+    const TerrainNoise& noise = GetTerrainNoise();
+    const glm::ivec2 chunkPos = chunk.GetPosition();
+    const int baseX = chunkPos.x * CHUNK_SIZE;
+    const int baseZ = chunkPos.y * CHUNK_SIZE;
 
-            if (templateId == 1 && i >= height / 2) {
-                offsetX = 1;
-            } else if (templateId == 2 && i >= height / 2) {
-                offsetZ = 1;
-                if (i >= height - 1) {
-                    offsetX = 1;
+    int maxTop = 0;
+    for (int x = 0; x < CHUNK_SIZE; ++x) {
+        for (int z = 0; z < CHUNK_SIZE; ++z) {
+            maxTop = std::max(maxTop, columns[x][z].topY);
+        }
+    }
+
+    // Only the lattice layers up to the highest column are sampled
+    float lattice[CAVE_LATTICE_Y][CAVE_LATTICE_XZ][CAVE_LATTICE_XZ];
+    const int latticeLayers = std::min(maxTop / CELL_Y + 2, CAVE_LATTICE_Y);
+    if (!perBlock) {
+        for (int ly = 0; ly < latticeLayers; ++ly) {
+            for (int lz = 0; lz < CAVE_LATTICE_XZ; ++lz) {
+                for (int lx = 0; lx < CAVE_LATTICE_XZ; ++lx) {
+                    lattice[ly][lz][lx] = noise.CaveDensity(baseX + lx * CELL_XZ, ly * CELL_Y, baseZ + lz * CELL_XZ);
                 }
             }
+        }
+    }
 
-            const int tx = rootX + offsetX;
-            const int ty = rootY + i;
-            const int tz = rootZ + offsetZ;
+    int carved = 0;
+    float plane[CAVE_LATTICE_XZ][CAVE_LATTICE_XZ];
+    float row[CAVE_LATTICE_XZ];
+    float density[CHUNK_SIZE];
+    for (int y = CAVE_FLOOR; y <= maxTop; ++y) {
+        const int ly = std::min(y / CELL_Y, CAVE_LATTICE_Y - 2);
+        const float ty = static_cast<float>(y - ly * CELL_Y) / CELL_Y;
+        if (!perBlock) {
+            for (int lz = 0; lz < CAVE_LATTICE_XZ; ++lz) {
+                for (int lx = 0; lx < CAVE_LATTICE_XZ; ++lx) {
+                    plane[lz][lx] = lattice[ly][lz][lx] + ty * (lattice[ly + 1][lz][lx] - lattice[ly][lz][lx]);
+                }
+            }
+        }
 
-            if (tx < 0 || tx >= CHUNK_SIZE || tz < 0 || tz >= CHUNK_SIZE || ty < 0 || ty >= CHUNK_HEIGHT) {
-                continue;
+        for (int z = 0; z < CHUNK_SIZE; ++z) {
+            if (perBlock) {
+                for (int x = 0; x < CHUNK_SIZE; ++x) {
+                    density[x] = noise.CaveDensity(baseX + x, y, baseZ + z);
+                }
+            } else {
+                const int lz = z / CELL_XZ;
+                const float tz = static_cast<float>(z - lz * CELL_XZ) / CELL_XZ;
+                for (int lx = 0; lx < CAVE_LATTICE_XZ; ++lx) {
+                    row[lx] = plane[lz][lx] + tz * (plane[lz + 1][lx] - plane[lz][lx]);
+                }
+                UpsampleLattice4(row, CHUNK_SIZE / CELL_XZ, density);
             }
 
-            chunk.SetBlock(tx, ty, tz, BlockType::Wood);
-            trunkNodes.emplace_back(tx, ty, tz);
+            for (int x = 0; x < CHUNK_SIZE; ++x) {
+                const int depth = columns[x][z].topY - y;
+                if (depth < 0) {
+                    continue;
+                }
+                const float threshold = CAVE_THRESHOLD + CAVE_CRUST_PENALTY * static_cast<float>(std::max(CAVE_CRUST - depth, 0));
+                if (density[x] > threshold) {
+                    chunk.SetBlock(x, y, z, BlockType::Air);
+                    carved++;
+                }
+            }
         }
+    }
+    return carved;
+}
 
-        if (trunkNodes.empty()) {
-            return;
+// Stone base and per-column layers from the 2D fields
+void LayTerrain(Chunk& chunk, const TerrainColumn (&columns)[CHUNK_SIZE][CHUNK_SIZE], int stoneBase) {
+    // The common stone base is one contiguous run; each column stacks the rest on top
+    chunk.FillLayers(0, stoneBase, BlockType::Stone);
+    for (int x = 0; x < CHUNK_SIZE; ++x) {
+        for (int z = 0; z < CHUNK_SIZE; ++z) {
+            const TerrainColumn& column = columns[x][z];
+            const Chunk::ColumnLayer layers[] = {
+                {BlockType::Stone, column.deepTop - stoneBase},
+                {column.subsurface, column.topY - column.deepTop},
+                {column.surface, 1}};
+            chunk.WriteColumn(x, z, stoneBase, layers, 3);
         }
+    }
+}
+
+} // namespace
+
+void WorldGeneration::SetSeed(int seed) {
+    if (s_NoiseCreated) {
+        LOG_WARNING("World seed " + std::to_string(seed) + " ignored: terrain noise already created with seed " +
+                    std::to_string(s_WorldSeed.load()));
+        return;
+    }
+    s_WorldSeed = seed;
+}
+
+int WorldGeneration::GetSeed() {
+    return s_WorldSeed;
+}
 
-        const glm::ivec3 top = trunkNodes.back();
-        placeLeafBlob(top.x, top.y, top.z, 2);
-        placeLeafBlob(top.x, top.y + 1, top.z, 2);
-        placeLeafBlob(top.x, top.y + 2, top.z, 1);
-        placeLeafAt(top.x, top.y + 3, top.z);
+void WorldGeneration::SetCavesEnabled(bool enabled) {
+    s_CavesEnabled = enabled;
+}
+
+bool WorldGeneration::AreCavesEnabled() {
+    return s_CavesEnabled;
+}
+
+TerrainFieldCache& WorldGeneration::GetFieldCache() {
+    static TerrainFieldCache cache(FIELD_CACHE_TILES, FillTerrainTile);
+    return cache;
+}
+
+SurfaceSample WorldGeneration::SampleSurface(int worldX, int worldZ) {
+    const ChunkPos region(FloorDiv(worldX, TerrainTile::SIDE), FloorDiv(worldZ, TerrainTile::SIDE));
+    const std::shared_ptr<const TerrainTile> tile = GetFieldCache().Get(region);
+    const int index = TerrainTile::Index(worldX - region.x * TerrainTile::SIDE, worldZ - region.z * TerrainTile::SIDE);
+
+    SurfaceSample sample;
+    sample.height = tile->heights[index];
+    sample.surface = tile->surfaces[index];
+    return sample;
+}
 
-        if (trunkNodes.size() >= 2) {
-            const glm::ivec3 upper = trunkNodes[trunkNodes.size() - 2];
-            placeLeafBlob(upper.x, upper.y, upper.z, 1);
+void WorldGeneration::SampleSurfaceGrid(int originX, int originZ, int step, int width, int depth, SurfaceSample* out) {
+    const TerrainNoise& noise = GetTerrainNoise();
+    NoiseGrid grid;
+    grid.originX = originX;
+    grid.originZ = originZ;
+    grid.width = width;
+    grid.depth = depth;
+    grid.step = step;
+
+    std::vector<float> heights(width * depth);
+    std::vector<float> biomes(width * depth);
+    noise.HeightGrid(grid, heights.data());
+    noise.biomeNoise.SampleGrid(grid, biomes.data());
+
+    for (int i = 0; i < width * depth; ++i) {
+        out[i].height = TerrainNoise::HeightFromNoise(heights[i]);
+        out[i].surface = TerrainNoise::SurfaceForBiome(biomes[i]);
+    }
+}
+
+WorldGeneration::NoiseBenchmarkResult WorldGeneration::RunNoiseBenchmark(int radius) {
+    using Clock = std::chrono::steady_clock;
+
+    // The per-sample path the terrain stage used before batching
+    FastNoiseLite heightReference;
+    heightReference.SetNoiseType(FastNoiseLite::NoiseType_Perlin);
+    heightReference.SetFrequency(HEIGHT_FREQUENCY);
+    heightReference.SetSeed(MixSeed(HEIGHT_SEED, s_WorldSeed));
+    FastNoiseLite biomeReference;
+    biomeReference.SetNoiseType(FastNoiseLite::NoiseType_Perlin);
+    biomeReference.SetFrequency(BIOME_FREQUENCY);
+    biomeReference.SetSeed(MixSeed(BIOME_SEED, s_WorldSeed));
+
+    const TerrainNoise& noise = GetTerrainNoise();
+    const int side = 2 * radius + 1;
+    const int chunks = side * side;
+    std::vector<float> scalar(static_cast<size_t>(chunks) * CHUNK_AREA * 3);
+    std::vector<float> batched(scalar.size());
+
+    const Clock::time_point scalarStart = Clock::now();
+    for (int c = 0; c < chunks; ++c) {
+        const int baseX = (c % side - radius) * CHUNK_SIZE;
+        const int baseZ = (c / side - radius) * CHUNK_SIZE;
+        float* fields = scalar.data() + static_cast<size_t>(c) * CHUNK_AREA * 3;
+        for (int z = 0; z < CHUNK_SIZE; ++z) {
+            for (int x = 0; x < CHUNK_SIZE; ++x) {
+                const float worldX = static_cast<float>(baseX + x);
+                const float worldZ = static_cast<float>(baseZ + z);
+                float h = 0.0f;
+                for (const NoiseOctave& octave : HEIGHT_OCTAVES) {
+                    h += heightReference.GetNoise(worldX * octave.scale, worldZ * octave.scale) * octave.amplitude;
+                }
+                fields[z * CHUNK_SIZE + x] = h;
+                fields[CHUNK_AREA + z * CHUNK_SIZE + x] = biomeReference.GetNoise(worldX, worldZ);
+                fields[2 * CHUNK_AREA + z * CHUNK_SIZE + x] = biomeReference.GetNoise(
+                    worldX * DIRT_SCALE + DIRT_OFFSET_X, worldZ * DIRT_SCALE + DIRT_OFFSET_Z);
+            }
         }
-        if (templateId != 0 && trunkNodes.size() >= 4) {
-            const glm::ivec3 bend = trunkNodes[trunkNodes.size() / 2];
-            placeLeafBlob(bend.x, bend.y + 1, bend.z, 1);
+    }
+    const Clock::time_point batchedStart = Clock::now();
+    for (int c = 0; c < chunks; ++c) {
+        NoiseGrid grid;
+        grid.originX = (c % side - radius) * CHUNK_SIZE;
+        grid.originZ = (c / side - radius) * CHUNK_SIZE;
+        grid.width = CHUNK_SIZE;
+        grid.depth = CHUNK_SIZE;
+        float* fields = batched.data() + static_cast<size_t>(c) * CHUNK_AREA * 3;
+        noise.HeightGrid(grid, fields);
+        noise.biomeNoise.SampleGrid(grid, fields + CHUNK_AREA);
+        noise.DirtGrid(grid, fields + 2 * CHUNK_AREA);
+    }
+    const Clock::time_point end = Clock::now();
+
+    NoiseBenchmarkResult result;
+    result.chunks = chunks;
+    result.scalarMs = std::chrono::duration<double, std::milli>(batchedStart - scalarStart).count() / chunks;
+    result.batchedMs = std::chrono::duration<double, std::milli>(end - batchedStart).count() / chunks;
+    result.instructionSet = BatchedPerlin::GetInstructionSet();
+    for (size_t i = 0; i < scalar.size(); ++i) {
+        result.maxError = std::max(result.maxError, std::abs(scalar[i] - batched[i]));
+    }
+    return result;
+}
+
+WorldGeneration::CaveBenchmarkResult WorldGeneration::RunCaveBenchmark(int radius) {
+    using Clock = std::chrono::steady_clock;
+    const int side = 2 * radius + 1;
+
+    CaveBenchmarkResult result;
+    result.chunks = side * side;
+    Clock::duration latticeTime{};
+    Clock::duration perBlockTime{};
+    int carvedPerBlock = 0;
+    int mismatched = 0;
+    for (int c = 0; c < result.chunks; ++c) {
+        Chunk lattice(c % side - radius, c / side - radius);
+        Chunk perBlock(lattice.GetPosition().x, lattice.GetPosition().y);
+        TerrainColumn columns[CHUNK_SIZE][CHUNK_SIZE];
+        const int stoneBase = ReadTerrainColumns(lattice, columns);
+        LayTerrain(lattice, columns, stoneBase);
+        LayTerrain(perBlock, columns, stoneBase);
+
+        const Clock::time_point latticeStart = Clock::now();
+        result.carvedBlocks += CarveCaves(lattice, columns, false);
+        const Clock::time_point perBlockStart = Clock::now();
+        carvedPerBlock += CarveCaves(perBlock, columns, true);
+        const Clock::time_point end = Clock::now();
+        latticeTime += perBlockStart - latticeStart;
+        perBlockTime += end - perBlockStart;
+
+        for (int y = 0; y < CHUNK_HEIGHT; ++y) {
+            for (int z = 0; z < CHUNK_SIZE; ++z) {
+                for (int x = 0; x < CHUNK_SIZE; ++x) {
+                    mismatched += lattice.GetBlock(x, y, z) != perBlock.GetBlock(x, y, z) ? 1 : 0;
+                }
+            }
         }
-    };
+    }
+
+    result.latticeMs = std::chrono::duration<double, std::milli>(latticeTime).count() / result.chunks;
+    result.perBlockMs = std::chrono::duration<double, std::milli>(perBlockTime).count() / result.chunks;
+    result.mismatch = carvedPerBlock > 0 ? static_cast<double>(mismatched) / carvedPerBlock : 0.0;
+    return result;
+}
 
-    uint32_t rng = SeedFromChunk(chunkX, chunkZ);
+void WorldGeneration::GenerateTerrain(Chunk& chunk) {
+    TerrainColumn columns[CHUNK_SIZE][CHUNK_SIZE];
+    const int stoneBase = ReadTerrainColumns(chunk, columns);
+    LayTerrain(chunk, columns, stoneBase);
+
+    if (s_CavesEnabled) {
+        CarveCaves(chunk, columns, false);
+    }
+}
+
+void WorldGeneration::Decorate(Chunk& chunk, DecorationStaging& staging) {
+    const glm::ivec2 chunkPos = chunk.GetPosition();
+    TerrainColumn columns[CHUNK_SIZE][CHUNK_SIZE];
+    ReadTerrainColumns(chunk, columns);
+
+    uint32_t rng = SeedFromChunk(chunkPos.x, chunkPos.y);
     const int clusterCount = NextInt(rng, 1, 3);
 
     for (int cluster = 0; cluster < clusterCount; ++cluster) {
@@ -207,14 +598,16 @@ void WorldGeneration::PopulateChunk(Chunk& chunk) {
                 continue;
             }
 
+            // Roots anywhere in the chunk; canopies past the border are staged for the neighbour
             const int tx = centerX + dx;
             const int tz = centerZ + dz;
-            if (tx < 2 || tx > CHUNK_SIZE - 3 || tz < 2 || tz > CHUNK_SIZE - 3) {
+            if (tx < 0 || tx >= CHUNK_SIZE || tz < 0 || tz >= CHUNK_SIZE) {
                 continue;
             }
 
             const TerrainColumn& c = columns[tx][tz];
-            if (c.surface != BlockType::Grass) {
+            // A cave may have opened the surface under the root
+            if (c.surface != BlockType::Grass || chunk.GetBlock(tx, c.topY, tz) != BlockType::Grass) {
                 continue;
             }
 
@@ -234,12 +627,32 @@ void WorldGeneration::PopulateChunk(Chunk& chunk) {
                 continue;
             }
 
-            const int templateId = NextInt(rng, 0, 2);
-            const int height = NextInt(rng, 4, 6);
-            placeTree(tx, rootY, tz, templateId, height);
+            const int shape = NextInt(rng, 0, TREE_SHAPES - 1);
+            const int height = NextInt(rng, TREE_MIN_HEIGHT, TREE_MAX_HEIGHT);
+            GetTreeTemplate(shape, height).Stamp(chunk, glm::ivec3(tx, rootY, tz), &staging);
             spawned++;
         }
     }
+
+    // Now and then a boulder, half sunk into the grass
+    if (NextInt(rng, 0, BOULDER_CHANCE - 1) == 0) {
+        const int bx = NextInt(rng, 0, CHUNK_SIZE - 1);
+        const int bz = NextInt(rng, 0, CHUNK_SIZE - 1);
+        const int size = NextInt(rng, 0, BOULDER_SIZES - 1);
+        const TerrainColumn& c = columns[bx][bz];
+        if (c.surface == BlockType::Grass && chunk.GetBlock(bx, c.topY, bz) == BlockType::Grass) {
+            GetBoulderTemplate(size).Stamp(chunk, glm::ivec3(bx, c.topY, bz), &staging);
+        }
+    }
+}
+
+void WorldGeneration::ApplyStaged(Chunk& chunk, const std::vector<StagedBlock>& blocks) {
+    for (const StagedBlock& block : blocks) {
+        if (block.onlyIntoAir && chunk.GetBlock(block.x, block.y, block.z) != BlockType::Air) {
+            continue;
+        }
+        chunk.SetBlock(block.x, block.y, block.z, block.type);
+    }
 }
 
 } // namespace Minecraft
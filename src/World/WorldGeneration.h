@@ -1,12 +1,101 @@
 #pragma once
 
+#include "Block.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 namespace Minecraft {
 
 class Chunk;
+class TerrainFieldCache;
+
+// Terrain surface at one column, from the 2D height and biome noise only
+struct SurfaceSample {
+    int height = 0;  // Number of solid blocks; the top block is at height - 1
+    BlockType surface = BlockType::Air;
+};
+
+// A block a decoration places in a neighbouring chunk, in that chunk's local coordinates
+struct StagedBlock {
+    uint8_t x = 0;
+    uint8_t y = 0;
+    uint8_t z = 0;
+    BlockType type = BlockType::Air;
+    bool onlyIntoAir = false;  // Leaves never replace what is already there
+};
 
+// Decoration writes that crossed the chunk border, one list per neighbour
+struct DecorationStaging {
+    std::array<std::vector<StagedBlock>, 9> neighbours;  // Index(dx, dz); the centre stays empty
+
+    static int Index(int dx, int dz) { return (dz + 1) * 3 + (dx + 1); }
+};
+
+// Chunks are generated in three stages so features can cross chunk borders:
+//   terrain      columns from the 2D fields, no neighbours involved
+//   decoration   trees; blocks that land in a neighbour go to the chunk's staging lists
+//   finalize     the neighbours' staged blocks are applied, in Index order
+// A chunk's result depends only on its position. ChunkGenerationPool tracks the
+// dependencies: a chunk is finalized once all eight neighbours are decorated.
 class WorldGeneration {
 public:
-    static void PopulateChunk(Chunk& chunk);
+    static void GenerateTerrain(Chunk& chunk);
+    static void Decorate(Chunk& chunk, DecorationStaging& staging);
+    static void ApplyStaged(Chunk& chunk, const std::vector<StagedBlock>& blocks);
+
+    // Offsets every noise seed and the decoration rng; 0 is the default world. The noise is
+    // created with the first chunk or surface sample, so this must be called before that.
+    static void SetSeed(int seed);
+    static int GetSeed();
+
+    // Caves are carved out of the terrain stage by 3D density noise sampled every
+    // CAVE_CELL_XZ blocks across and CAVE_CELL_Y blocks up, trilinearly interpolated between
+    static constexpr int CAVE_CELL_XZ = 4;
+    static constexpr int CAVE_CELL_Y = 4;
+    static void SetCavesEnabled(bool enabled);
+    static bool AreCavesEnabled();
+
+    static constexpr size_t FIELD_CACHE_TILES = 256;  // 64x64-column tiles, about 8 MB
+
+    // Height, biome and surface tiles shared by every generation consumer; filled on first use
+    static TerrainFieldCache& GetFieldCache();
+
+    // Same height and surface GenerateTerrain produces for the column, read from the field cache
+    static SurfaceSample SampleSurface(int worldX, int worldZ);
+
+    // SampleSurface for a width x depth grid of columns `step` apart, sampled directly;
+    // out[z * width + x] is column (originX + x * step, originZ + z * step). Meant for
+    // sparse grids such as the horizon LODs, where filling whole cache tiles would waste work.
+    static void SampleSurfaceGrid(int originX, int originZ, int step, int width, int depth, SurfaceSample* out);
+
+    struct NoiseBenchmarkResult {
+        int chunks = 0;
+        double scalarMs = 0.0;   // Per chunk, FastNoiseLite one sample at a time
+        double batchedMs = 0.0;  // Per chunk, BatchedPerlin grids
+        float maxError = 0.0f;   // Largest difference between the two over every field
+        const char* instructionSet = "";
+    };
+
+    // Largest maxError the batched noise may show. Height fields reach about 45 blocks; FMA
+    // contraction in the AVX2 build moves them by under 1e-4 (7.6e-5 measured), and anything
+    // past a thousandth of a block means the batched path is wrong.
+    static constexpr float NOISE_TOLERANCE = 1e-3f;
+
+    // Times the terrain noise pass of GenerateTerrain both ways over (2 * radius + 1)^2 chunks
+    static NoiseBenchmarkResult RunNoiseBenchmark(int radius);
+
+    struct CaveBenchmarkResult {
+        int chunks = 0;
+        double latticeMs = 0.0;   // Per chunk, interpolated lattice
+        double perBlockMs = 0.0;  // Per chunk, one noise sample per block
+        int carvedBlocks = 0;     // By the lattice, over every chunk
+        double mismatch = 0.0;    // Blocks that differ between the two, relative to the per-block carve
+    };
+
+    // Times the cave carving both ways over (2 * radius + 1)^2 chunks
+    static CaveBenchmarkResult RunCaveBenchmark(int radius);
 };
 
 } // namespace Minecraft
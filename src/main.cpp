@@ -1,12 +1,144 @@
 #include <QApplication>
 #include <QSurfaceFormat>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "Core/GameConfig.h"
+#include "Render/TexturePack.h"
+#include "World/ChunkGenerationPool.h"
+#include "World/WorldGeneration.h"
 #include "UI/GameWidget.h"
-#include "Utils/Logger.h"
+#include "utils/Logger.h"
+
+namespace {
+
+// --fps N caps the frame rate, --no-vsync unthrottles the swap, --uncapped does both with no cap.
+// --resolution-scale MIN MAX bounds the dynamic world resolution, --fixed-resolution turns it off.
+// --render-distance MIN MAX and --chunk-memory MB bound the render distance governor.
+// --generation-threads N sizes the chunk generation pool (0 = one per hardware thread).
+// --no-caves generates terrain without 3D caves.
+// --cook-textures writes the block texture pack and exits.
+// --benchmark-generation reports terrain noise and cave timing and chunk generation throughput per thread count, then exits;
+// the exit code is 1 if the batched noise strays from FastNoiseLite or the output depends on the thread count.
+void ParseArguments(int argc, char** argv, bool& cookTextures, bool& benchmarkGeneration) {
+    Minecraft::GameConfig& config = Minecraft::GameConfig::Instance();
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            config.SetTargetFps(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--no-vsync") == 0) {
+            config.SetVSync(false);
+        } else if (std::strcmp(argv[i], "--uncapped") == 0) {
+            config.SetVSync(false);
+            config.SetTargetFps(0);
+        } else if (std::strcmp(argv[i], "--resolution-scale") == 0 && i + 2 < argc) {
+            const float minScale = static_cast<float>(std::atof(argv[i + 1]));
+            const float maxScale = static_cast<float>(std::atof(argv[i + 2]));
+            config.SetResolutionScaleBounds(minScale, maxScale);
+            i += 2;
+        } else if (std::strcmp(argv[i], "--fixed-resolution") == 0) {
+            config.SetDynamicResolution(false);
+        } else if (std::strcmp(argv[i], "--render-distance") == 0 && i + 2 < argc) {
+            config.SetRenderDistanceBounds(std::atoi(argv[i + 1]), std::atoi(argv[i + 2]));
+            i += 2;
+        } else if (std::strcmp(argv[i], "--chunk-memory") == 0 && i + 1 < argc) {
+            config.SetChunkMemoryBudgetMB(static_cast<std::size_t>(std::atoll(argv[++i])));
+        } else if (std::strcmp(argv[i], "--generation-threads") == 0 && i + 1 < argc) {
+            config.SetGenerationWorkers(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--no-caves") == 0) {
+            config.SetCaves(false);
+        } else if (std::strcmp(argv[i], "--cook-textures") == 0) {
+            cookTextures = true;
+        } else if (std::strcmp(argv[i], "--benchmark-generation") == 0) {
+            benchmarkGeneration = true;
+        }
+    }
+}
+
+// Same chunks at every thread count; the checksum must not change with it
+int RunGenerationBenchmark() {
+    constexpr int RADIUS = 12;  // 625 chunks, enough to keep every worker busy
+
+    // Terrain noise pass alone, batched against FastNoiseLite
+    const Minecraft::WorldGeneration::NoiseBenchmarkResult noise = Minecraft::WorldGeneration::RunNoiseBenchmark(RADIUS);
+    std::printf("Terrain noise (%s): %.4f ms/chunk scalar, %.4f ms/chunk batched, %.1fx, max difference %g\n",
+                noise.instructionSet, noise.scalarMs, noise.batchedMs,
+                noise.batchedMs > 0.0 ? noise.scalarMs / noise.batchedMs : 0.0, noise.maxError);
+    LOG_INFO("Noise benchmark: " + std::to_string(noise.scalarMs) + " ms/chunk scalar, " +
+             std::to_string(noise.batchedMs) + " ms/chunk batched (" + noise.instructionSet + ")");
+    const bool noiseMatches = noise.maxError <= Minecraft::WorldGeneration::NOISE_TOLERANCE;
+    if (!noiseMatches) {
+        std::printf("BATCHED NOISE DIFFERS FROM FASTNOISELITE BEYOND %g\n", Minecraft::WorldGeneration::NOISE_TOLERANCE);
+        LOG_ERROR("Noise benchmark: batched noise differs from FastNoiseLite by " + std::to_string(noise.maxError));
+    }
+
+    // Cave carving alone, interpolated lattice against a noise sample per block
+    const Minecraft::WorldGeneration::CaveBenchmarkResult caves = Minecraft::WorldGeneration::RunCaveBenchmark(RADIUS);
+    std::printf("Caves: %.4f ms/chunk lattice, %.4f ms/chunk per block, %.1fx, %.1f%% of carved blocks differ\n",
+                caves.latticeMs, caves.perBlockMs, caves.latticeMs > 0.0 ? caves.perBlockMs / caves.latticeMs : 0.0,
+                caves.mismatch * 100.0);
+    LOG_INFO("Cave benchmark: " + std::to_string(caves.latticeMs) + " ms/chunk lattice, " +
+             std::to_string(caves.perBlockMs) + " ms/chunk per block");
+
+    const bool cavesEnabled = Minecraft::GameConfig::Instance().GetStreamingConfig().caves;
+    Minecraft::WorldGeneration::SetCavesEnabled(cavesEnabled);
+    std::printf("Chunk generation, caves %s:\n", cavesEnabled ? "on" : "off");
+    std::vector<int> workerCounts;
+    const int maxWorkers = Minecraft::ChunkGenerationPool::GetDefaultWorkerCount();
+    for (int workers = 1; workers < maxWorkers; workers *= 2) {
+        workerCounts.push_back(workers);
+    }
+    workerCounts.push_back(maxWorkers);
+
+    std::printf("%8s %8s %10s %12s %18s\n", "threads", "chunks", "seconds", "chunks/s", "checksum");
+    uint64_t referenceChecksum = 0;
+    bool deterministic = true;
+    for (int workers : workerCounts) {
+        const Minecraft::ChunkGenerationPool::BenchmarkResult result =
+            Minecraft::ChunkGenerationPool::RunBenchmark(workers, RADIUS);
+        if (workers == workerCounts.front()) {
+            referenceChecksum = result.checksum;
+        }
+        deterministic = deterministic && result.checksum == referenceChecksum;
+
+        std::printf("%8d %8d %10.3f %12.1f %18llx\n", result.workers, result.chunks, result.seconds,
+                    result.chunksPerSecond, static_cast<unsigned long long>(result.checksum));
+        LOG_INFO("Generation benchmark: " + std::to_string(result.workers) + " threads, " +
+                 std::to_string(result.chunksPerSecond) + " chunks/s");
+    }
+
+    std::printf("%s\n", deterministic ? "Output identical for every thread count" : "OUTPUT DIFFERS BETWEEN THREAD COUNTS");
+    if (!deterministic) {
+        LOG_ERROR("Generation benchmark: output differs between thread counts");
+    }
+    return deterministic && noiseMatches ? 0 : 1;
+}
+
+} // namespace
 
 int main(int argc, char** argv) {
     // Initialize logger
     Minecraft::Logger::Init("minecraft.log");
     LOG_INFO("========== Minecraft Clone Starting ==========");
+    bool cookTextures = false;
+    bool benchmarkGeneration = false;
+    ParseArguments(argc, argv, cookTextures, benchmarkGeneration);
+
+    if (benchmarkGeneration) {
+        const int result = RunGenerationBenchmark();
+        Minecraft::Logger::Shutdown();
+        return result;
+    }
+
+    // Offline step: no window, just the cooked pack next to the atlas
+    if (cookTextures) {
+        const std::string atlas = Minecraft::TexturePack::BLOCK_ATLAS_PATH;
+        const bool cooked = Minecraft::TexturePack::Cook(atlas, Minecraft::TexturePack::GetPackPath(atlas),
+                                                         Minecraft::TexturePack::BLOCK_TILE_SIZE,
+                                                         Minecraft::TexturePack::BLOCK_TILE_SIZE);
+        Minecraft::Logger::Shutdown();
+        return cooked ? 0 : 1;
+    }
     
     // Setup OpenGL format
     QSurfaceFormat fmt;
@@ -14,6 +146,7 @@ int main(int argc, char** argv) {
     fmt.setStencilBufferSize(8);
     fmt.setVersion(3, 3);
     fmt.setProfile(QSurfaceFormat::CoreProfile);
+    fmt.setSwapInterval(Minecraft::GameConfig::Instance().GetDisplayConfig().vsync ? 1 : 0);
     QSurfaceFormat::setDefaultFormat(fmt);
     
     LOG_INFO("OpenGL format configured: 3.3 Core Profile");
@@ -0,0 +1,22 @@
+#include "TestCheck.h"
+#include "World/WorldGeneration.h"
+#include <cstdio>
+
+using namespace Minecraft;
+
+namespace {
+
+// Whichever instruction set the build picked, batched noise stays on the scalar reference
+void TestBatchedNoiseWithinTolerance() {
+    const WorldGeneration::NoiseBenchmarkResult result = WorldGeneration::RunNoiseBenchmark(2);
+    std::printf("%s: max error %g\n", result.instructionSet, result.maxError);
+    CHECK(result.chunks == 25);
+    CHECK(result.maxError <= WorldGeneration::NOISE_TOLERANCE);
+}
+
+} // namespace
+
+int main() {
+    TestBatchedNoiseWithinTolerance();
+    return Test::Result();
+}
@@ -0,0 +1,24 @@
+#include "TestCheck.h"
+#include "World/WorldGeneration.h"
+
+using namespace Minecraft;
+
+namespace {
+
+// The interpolated lattice must carve nearly the same caves as sampling every block
+void TestLatticeMatchesPerBlock() {
+    const WorldGeneration::CaveBenchmarkResult result = WorldGeneration::RunCaveBenchmark(3);
+    CHECK(result.chunks == 49);
+    CHECK(result.carvedBlocks > 0);
+    // 0.034 when the lattice was last tuned
+    CHECK(result.mismatch < 0.05);
+    // Measured 6-7x; half of that leaves room for a noisy machine
+    CHECK(result.latticeMs * 3.0 < result.perBlockMs);
+}
+
+} // namespace
+
+int main() {
+    TestLatticeMatchesPerBlock();
+    return Test::Result();
+}
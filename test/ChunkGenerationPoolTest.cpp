@@ -0,0 +1,128 @@
+#include "TestCheck.h"
+#include "World/Chunk.h"
+#include "World/ChunkGenerationPool.h"
+#include "World/WorldGeneration.h"
+#include <chrono>
+#include <thread>
+
+using namespace Minecraft;
+
+namespace {
+
+// The stages run by hand on one thread, neighbours applied in the pool's order
+uint64_t GenerateSerially(const ChunkPos& pos) {
+    std::unique_ptr<Chunk> chunks[3][3];
+    DecorationStaging staging[3][3];
+    for (int dz = -1; dz <= 1; ++dz) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            auto chunk = std::make_unique<Chunk>(pos.x + dx, pos.z + dz);
+            WorldGeneration::GenerateTerrain(*chunk);
+            WorldGeneration::Decorate(*chunk, staging[dz + 1][dx + 1]);
+            chunks[dz + 1][dx + 1] = std::move(chunk);
+        }
+    }
+    Chunk& centre = *chunks[1][1];
+    for (int dz = -1; dz <= 1; ++dz) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            if (dx != 0 || dz != 0) {
+                WorldGeneration::ApplyStaged(centre, staging[dz + 1][dx + 1].neighbours[DecorationStaging::Index(-dx, -dz)]);
+            }
+        }
+    }
+    return ChunkGenerationPool::HashChunk(centre, pos);
+}
+
+bool WaitForResults(ChunkGenerationPool& pool, std::vector<GeneratedChunkResult>& results, size_t count) {
+    for (int i = 0; i < 2000 && results.size() < count; ++i) {
+        pool.TakeResults(results, count - results.size());
+        if (results.size() < count) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+    return results.size() == count;
+}
+
+// One requested chunk takes its eight neighbours through decoration only, and its
+// contents match the serial pipeline
+void TestStageOrdering() {
+    const ChunkPos pos(3, -2);
+    ChunkGenerationPool pool(2);
+    pool.SetFocus(pos, glm::vec2(0.0f, 1.0f), 4);
+    pool.SetStageTimingEnabled(true);
+    pool.Queue({pos});
+
+    std::vector<GeneratedChunkResult> results;
+    CHECK(WaitForResults(pool, results, 1));
+    CHECK(!results.empty() && results[0].pos == pos);
+    if (!results.empty()) {
+        CHECK(ChunkGenerationPool::HashChunk(*results[0].chunk, pos) == GenerateSerially(pos));
+    }
+
+    const ChunkGenerationPool::StageTimings timings = pool.TakeStageTimings();
+    CHECK(timings.terrainMs.size() == 9);
+    CHECK(timings.decorateMs.size() == 9);
+    CHECK(timings.finalizeMs.size() == 1);
+    CHECK(pool.GetBacklog() == 0);
+
+    // The decorated neighbours keep their voxels and staged blocks in the pipeline
+    const size_t held = pool.EstimateMemoryBytes();
+    CHECK(held >= 8 * sizeof(Chunk));
+    CHECK(held < 9 * sizeof(Chunk) + 64 * 1024);
+
+    // A neighbour requested later reuses its decorated state and needs only the outer ring
+    pool.Queue({ChunkPos(pos.x + 1, pos.z)});
+    results.clear();
+    CHECK(WaitForResults(pool, results, 1));
+    const ChunkGenerationPool::StageTimings more = pool.TakeStageTimings();
+    CHECK(more.terrainMs.size() == 3);
+    CHECK(more.decorateMs.size() == 3);
+    CHECK(more.finalizeMs.size() == 1);
+}
+
+// Worker count changes the schedule, never the output
+void TestWorkerCountIndependence() {
+    const ChunkGenerationPool::BenchmarkResult one = ChunkGenerationPool::RunBenchmark(1, 2);
+    const ChunkGenerationPool::BenchmarkResult three = ChunkGenerationPool::RunBenchmark(3, 2);
+    CHECK(one.chunks == 25);
+    CHECK(three.chunks == 25);
+    CHECK(one.checksum == three.checksum);
+}
+
+// Moving the focus cancels unfinished requests that left it; nothing outside is handed out
+void TestFocusCancels() {
+    ChunkGenerationPool pool(1);
+    pool.SetFocus(ChunkPos(0, 0), glm::vec2(1.0f, 0.0f), 6);
+    std::vector<ChunkPos> positions;
+    for (int z = -6; z <= 6; ++z) {
+        for (int x = -6; x <= 6; ++x) {
+            positions.emplace_back(x, z);
+        }
+    }
+    pool.Queue(positions);
+    pool.SetFocus(ChunkPos(100, 100), glm::vec2(1.0f, 0.0f), 1);
+
+    const ChunkGenerationPool::Stats stats = pool.GetStats();
+    CHECK(stats.cancelled > 0);
+    CHECK(stats.generated + stats.cancelled + stats.wasted >= positions.size());
+
+    // Whatever a running stage finishes afterwards is not handed out
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    std::vector<GeneratedChunkResult> results;
+    pool.TakeResults(results, positions.size());
+    CHECK(results.empty());
+    CHECK(pool.GetBacklog() == 0);
+
+    // The old area's pipeline state is gone, the new focus still generates
+    CHECK(pool.EstimateMemoryBytes() == 0);
+    pool.Queue({ChunkPos(100, 100)});
+    CHECK(WaitForResults(pool, results, 1));
+}
+
+} // namespace
+
+int main() {
+    TestStageOrdering();
+    TestWorkerCountIndependence();
+    TestFocusCancels();
+    return Test::Result();
+}
@@ -0,0 +1,99 @@
+#include "TestCheck.h"
+#include "World/Chunk.h"
+#include "World/ChunkGenerationPool.h"
+#include "World/World.h"
+#include "World/WorldGeneration.h"
+#include <chrono>
+#include <thread>
+
+using namespace Minecraft;
+
+namespace {
+
+int CountWrongColumns(const ChunkPos& pos, const ChunkSurface& surface) {
+    int wrong = 0;
+    for (int z = 0; z < CHUNK_SIZE; ++z) {
+        for (int x = 0; x < CHUNK_SIZE; ++x) {
+            const SurfaceSample sample = WorldGeneration::SampleSurface(pos.x * CHUNK_SIZE + x, pos.z * CHUNK_SIZE + z);
+            const int index = z * CHUNK_SIZE + x;
+            wrong += (surface.heights[index] != sample.height || surface.surfaces[index] != sample.surface) ? 1 : 0;
+        }
+    }
+    return wrong;
+}
+
+// Surfaces read on the workers match the per-column sampler, negative coordinates included
+void TestPoolSurfaces() {
+    ChunkGenerationPool pool(1);
+    const std::vector<ChunkPos> positions = {ChunkPos(2, 3), ChunkPos(-5, 7), ChunkPos(-1, -9)};
+    pool.QueueSurfaces(positions);
+
+    std::vector<ChunkSurfaceResult> results;
+    for (int i = 0; i < 2000 && results.size() < positions.size(); ++i) {
+        pool.TakeSurfaces(results);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    CHECK(results.size() == positions.size());
+    for (const ChunkSurfaceResult& result : results) {
+        CHECK(CountWrongColumns(result.pos, result.surface) == 0);
+    }
+
+    // Taken surfaces can be requested again
+    pool.QueueSurfaces({positions[0]});
+    results.clear();
+    for (int i = 0; i < 2000 && results.empty(); ++i) {
+        pool.TakeSurfaces(results);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    CHECK(results.size() == 1);
+}
+
+// Known chunks collide as solid below their surface; loaded chunks use their voxels
+void TestWorldCollision() {
+    World world(1);
+    world.SetRenderDistance(1);
+    const glm::vec3 player(8.0f, 100.0f, 8.0f);
+    const ChunkPos knownPos(3, 0);  // Past the render distance, inside the preload ring
+
+    for (int i = 0; i < 2000; ++i) {
+        world.Update(player, std::chrono::steady_clock::now() + std::chrono::milliseconds(5));
+        if (world.GetLoadedChunkCount() == 9 && world.GetSurfaceHeight(knownPos.x * CHUNK_SIZE, 0) > 0) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    CHECK(world.GetLoadedChunkCount() == 9);
+    CHECK(world.GetKnownChunkCount() > 0);
+    CHECK(world.GetChunk(knownPos) == nullptr);
+
+    int wrong = 0;
+    for (int z = 0; z < CHUNK_SIZE; ++z) {
+        for (int x = 0; x < CHUNK_SIZE; ++x) {
+            const int worldX = knownPos.x * CHUNK_SIZE + x;
+            const int height = WorldGeneration::SampleSurface(worldX, z).height;
+            wrong += world.GetSurfaceHeight(worldX, z) != height ? 1 : 0;
+            wrong += world.GetCollisionBlock(worldX, height - 1, z) != BlockType::Stone ? 1 : 0;
+            wrong += world.GetCollisionBlock(worldX, height, z) != BlockType::Air ? 1 : 0;
+        }
+    }
+    CHECK(wrong == 0);
+
+    // Loaded: the real blocks, caves and trees included
+    int differ = 0;
+    for (int y = 0; y < CHUNK_HEIGHT; ++y) {
+        differ += world.GetCollisionBlock(5, y, 9) != world.GetBlock(5, y, 9) ? 1 : 0;
+    }
+    CHECK(differ == 0);
+
+    // Neither loaded nor known: nothing to stand on
+    CHECK(world.GetCollisionBlock(40 * CHUNK_SIZE, 1, 0) == BlockType::Air);
+    CHECK(world.GetCollisionBlock(0, -1, 0) == BlockType::Air);
+}
+
+} // namespace
+
+int main() {
+    TestPoolSurfaces();
+    TestWorldCollision();
+    return Test::Result();
+}
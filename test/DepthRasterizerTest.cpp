@@ -0,0 +1,65 @@
+#include "TestCheck.h"
+#include "Render/DepthRasterizer.h"
+#include <cfloat>
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace Minecraft;
+
+namespace {
+
+// Camera at the origin looking down -z, as the game sets it up
+glm::mat4 ViewProjection() {
+    const glm::mat4 projection = glm::perspective(glm::radians(70.0f),
+        static_cast<float>(DepthRasterizer::WIDTH) / DepthRasterizer::HEIGHT, 0.1f, 500.0f);
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    return projection * view;
+}
+
+// A wall hides what is straight behind it but not what sticks out beside it
+void TestWallOccludes() {
+    DepthRasterizer rasterizer;
+    rasterizer.SetViewProjection(ViewProjection());
+    // Covers the middle third of the screen horizontally and most of it vertically
+    CHECK(rasterizer.RasterizeBox(AABB(glm::vec3(-5.0f, -5.0f, -11.0f), glm::vec3(5.0f, 5.0f, -10.0f))));
+
+    // Front face at w = 10; conservative depth never ends up closer
+    const float centre = rasterizer.GetDepth(DepthRasterizer::WIDTH / 2, DepthRasterizer::HEIGHT / 2);
+    CHECK(centre >= 10.0f - 1e-3f);
+    CHECK(centre < 12.0f);
+
+    CHECK(!rasterizer.IsBoxVisible(AABB(glm::vec3(-1.0f), glm::vec3(1.0f)).Offset(glm::vec3(0.0f, 0.0f, -40.0f))));
+    CHECK(rasterizer.IsBoxVisible(AABB(glm::vec3(-1.0f), glm::vec3(1.0f)).Offset(glm::vec3(0.0f, 0.0f, -5.0f))));
+    // Beside the wall's silhouette, or only partly behind it
+    CHECK(rasterizer.IsBoxVisible(AABB(glm::vec3(-1.0f), glm::vec3(1.0f)).Offset(glm::vec3(30.0f, 0.0f, -40.0f))));
+    CHECK(rasterizer.IsBoxVisible(AABB(glm::vec3(0.0f, -1.0f, -41.0f), glm::vec3(40.0f, 1.0f, -40.0f))));
+}
+
+void TestEdgeCases() {
+    DepthRasterizer rasterizer;
+    rasterizer.SetViewProjection(ViewProjection());
+
+    // Empty buffer hides nothing
+    CHECK(rasterizer.GetDepth(0, 0) == FLT_MAX);
+    CHECK(rasterizer.IsBoxVisible(AABB(glm::vec3(-1.0f, -1.0f, -50.0f), glm::vec3(1.0f, 1.0f, -48.0f))));
+
+    // Boxes crossing the near plane are neither rasterized nor culled
+    const AABB aroundCamera(glm::vec3(-1.0f), glm::vec3(1.0f));
+    CHECK(!rasterizer.RasterizeBox(aroundCamera));
+    CHECK(rasterizer.IsBoxVisible(aroundCamera));
+
+    // Behind the camera: rasterizing it must leave the buffer untouched
+    rasterizer.RasterizeBox(AABB(glm::vec3(-20.0f, -10.0f, 10.0f), glm::vec3(20.0f, 10.0f, 11.0f)));
+    CHECK(rasterizer.GetDepth(DepthRasterizer::WIDTH / 2, DepthRasterizer::HEIGHT / 2) == FLT_MAX);
+
+    rasterizer.RasterizeBox(AABB(glm::vec3(-20.0f, -10.0f, -11.0f), glm::vec3(20.0f, 10.0f, -10.0f)));
+    rasterizer.Clear();
+    CHECK(rasterizer.GetDepth(DepthRasterizer::WIDTH / 2, DepthRasterizer::HEIGHT / 2) == FLT_MAX);
+}
+
+} // namespace
+
+int main() {
+    TestWallOccludes();
+    TestEdgeCases();
+    return Test::Result();
+}
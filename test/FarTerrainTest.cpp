@@ -0,0 +1,96 @@
+#include "TestCheck.h"
+#include "Render/FramePacket.h"
+#include "World/FarTerrain.h"
+#include <chrono>
+#include <thread>
+
+using namespace Minecraft;
+
+namespace {
+
+// Quadtree tiles overlap only when one contains the other
+bool Overlaps(FarTileKey a, FarTileKey b) {
+    if (a.lod > b.lod) {
+        std::swap(a, b);
+    }
+    const int shift = b.lod - a.lod;
+    return (a.x >> shift) == b.x && (a.z >> shift) == b.z;
+}
+
+struct TileCounter {
+    int uploads = 0;
+    int releases = 0;
+
+    void Apply(const std::vector<RenderCommand>& commands) {
+        for (const RenderCommand& command : commands) {
+            if (command.type == RenderCommandType::UploadFarTile) {
+                uploads++;
+            } else if (command.type == RenderCommandType::ReleaseFarTile) {
+                releases++;
+            }
+        }
+    }
+};
+
+void CheckNoOverlap(const std::vector<FarTileKey>& tiles) {
+    bool overlap = false;
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        for (size_t j = i + 1; j < tiles.size(); ++j) {
+            overlap = overlap || Overlaps(tiles[i], tiles[j]);
+        }
+    }
+    CHECK(!overlap);
+}
+
+bool WaitForTiles(FarTerrain& terrain, const glm::vec3& camera, int renderDistance, TileCounter& counter) {
+    for (int i = 0; i < 2000; ++i) {
+        std::vector<RenderCommand> commands;
+        terrain.Update(camera, renderDistance, commands);
+        counter.Apply(commands);
+        if (terrain.GetPendingCount() == 0) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return false;
+}
+
+// Superseded tiles fill in for their replacements and leave once those are in
+void TestStandInsCoverReselection() {
+    constexpr int RENDER_DISTANCE = 4;
+    FarTerrain terrain;
+    TileCounter counter;
+    std::vector<FarTileKey> tiles;
+
+    const glm::vec3 start(8.0f, 80.0f, 8.0f);
+    CHECK(WaitForTiles(terrain, start, RENDER_DISTANCE, counter));
+    terrain.GetDrawList(tiles);
+    const size_t startTiles = tiles.size();
+    CHECK(startTiles > 0);
+    CHECK(terrain.GetStandInCount() == 0);
+
+    // Far enough to split and merge tiles at every LOD
+    const glm::vec3 moved(8.0f + 40.0f * CHUNK_SIZE, 80.0f, 8.0f - 24.0f * CHUNK_SIZE);
+    std::vector<RenderCommand> commands;
+    terrain.Update(moved, RENDER_DISTANCE, commands);
+    counter.Apply(commands);
+    CHECK(terrain.GetStandInCount() > 0);
+    CHECK(terrain.GetStandInCount() <= FarTerrain::MAX_STAND_IN_TILES);
+    terrain.GetDrawList(tiles);
+    CHECK(!tiles.empty());
+    CheckNoOverlap(tiles);
+
+    CHECK(WaitForTiles(terrain, moved, RENDER_DISTANCE, counter));
+    terrain.GetDrawList(tiles);
+    CheckNoOverlap(tiles);
+    CHECK(terrain.GetStandInCount() == 0);
+    CHECK(terrain.GetTileCount() == tiles.size());
+    CHECK(static_cast<size_t>(counter.uploads - counter.releases) == terrain.GetTileCount());
+}
+
+} // namespace
+
+int main() {
+    TestStandInsCoverReselection();
+    return Test::Result();
+}
@@ -0,0 +1,106 @@
+#include "TestCheck.h"
+#include "Render/FrameEncoder.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+using namespace Minecraft;
+
+namespace {
+
+// Writer that blocks until released, standing in for a slow disk
+class GatedWriter {
+public:
+    void Write(const FrameEncoder::Job& job) {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Cv.wait(lock, [this]() { return m_Open; });
+        m_Paths.push_back(job.path);
+    }
+
+    void Open() {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Open = true;
+        }
+        m_Cv.notify_all();
+    }
+
+    std::vector<std::string> GetPaths() {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Paths;
+    }
+
+private:
+    std::vector<std::string> m_Paths;
+    bool m_Open = false;
+    std::mutex m_Mutex;
+    std::condition_variable m_Cv;
+};
+
+bool Queue(FrameEncoder& encoder, const std::string& path, bool screenshot) {
+    FrameEncoder::Job job;
+    if (!encoder.AcquirePixels(screenshot, job.pixels)) {
+        return false;
+    }
+    job.pixels.resize(16);
+    job.path = path;
+    job.screenshot = screenshot;
+    encoder.Submit(std::move(job));
+    return true;
+}
+
+// A stalled writer drops recorded frames past the backlog but never screenshots,
+// and everything queued is still written on shutdown, in order
+void TestBacklogDropsRecordedFrames() {
+    GatedWriter writer;
+    int queued = 0;
+    uint64_t dropped = 0;
+    {
+        FrameEncoder encoder([&writer](const FrameEncoder::Job& job) { writer.Write(job); });
+        // One more than the backlog, since the worker may already hold the first job
+        for (size_t i = 0; i < FrameEncoder::MAX_QUEUED_FRAMES + 1; ++i) {
+            queued += Queue(encoder, "frame" + std::to_string(i), false) ? 1 : 0;
+        }
+        CHECK(!Queue(encoder, "late", false));
+        CHECK(Queue(encoder, "screenshot", true));
+        queued++;
+
+        dropped = encoder.GetDroppedCount();
+        writer.Open();
+    }
+
+    CHECK(dropped >= 1);
+    const std::vector<std::string> paths = writer.GetPaths();
+    CHECK(static_cast<int>(paths.size()) == queued);
+    CHECK(!paths.empty() && paths.front() == "frame0");
+    CHECK(!paths.empty() && paths.back() == "screenshot");
+}
+
+// Written frames give their storage back to the next capture
+void TestPixelStorageIsRecycled() {
+    std::atomic<int> writes{0};
+    FrameEncoder encoder([&writes](const FrameEncoder::Job&) { writes++; });
+
+    FrameEncoder::Job job;
+    CHECK(encoder.AcquirePixels(false, job.pixels));
+    CHECK(job.pixels.capacity() == 0);
+    job.pixels.resize(4096);
+    encoder.Submit(std::move(job));
+    while (encoder.GetWrittenCount() < 1) {
+        std::this_thread::yield();
+    }
+
+    FrameEncoder::Job next;
+    CHECK(encoder.AcquirePixels(false, next.pixels));
+    CHECK(next.pixels.capacity() >= 4096);
+    CHECK(writes == 1);
+    CHECK(encoder.GetDroppedCount() == 0);
+}
+
+} // namespace
+
+int main() {
+    TestBacklogDropsRecordedFrames();
+    TestPixelStorageIsRecycled();
+    return Test::Result();
+}
@@ -0,0 +1,58 @@
+#include "TestCheck.h"
+#include "Core/FramePacer.h"
+#include <chrono>
+#include <thread>
+
+using namespace Minecraft;
+
+namespace {
+
+// Drive the pacer the way GameWidget does: a millisecond timer, then the sub-ms wait.
+// Returns how many frames started before their scheduled time.
+int RunFrames(FramePacer& pacer, int frames, float& meanMs) {
+    pacer.BeginFrame();
+    int early = 0;
+    float sum = 0.0f;
+    for (int i = 0; i < frames; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(pacer.GetMillisecondsUntilNextFrame()));
+        pacer.WaitForFrameStart();
+        if (FramePacer::Clock::now() < pacer.GetNextFrameStart()) {
+            early++;
+        }
+        pacer.BeginFrame();
+        sum += pacer.GetLastFrameMs();
+    }
+    meanMs = sum / static_cast<float>(frames);
+    return early;
+}
+
+// 144 Hz is 6.94 ms, which whole milliseconds can only approximate
+void TestFractionalInterval() {
+    FramePacer pacer;
+    pacer.Configure(false, 0.0f, 144);
+    const float targetMs = 1000.0f / 144.0f;
+
+    float meanMs = 0.0f;
+    // Never early. How late depends on the scheduler, so that is not checked here.
+    CHECK(RunFrames(pacer, 60, meanMs) == 0);
+    CHECK(meanMs >= targetMs - 0.05f);
+}
+
+void TestUncappedDoesNotWait() {
+    FramePacer pacer;
+    pacer.Configure(false, 0.0f, 0);
+    pacer.BeginFrame();
+    CHECK(pacer.GetMillisecondsUntilNextFrame() == 0);
+
+    const auto start = FramePacer::Clock::now();
+    pacer.WaitForFrameStart();
+    CHECK(FramePacer::Clock::now() - start < std::chrono::milliseconds(1));
+}
+
+} // namespace
+
+int main() {
+    TestFractionalInterval();
+    TestUncappedDoesNotWait();
+    return Test::Result();
+}
@@ -0,0 +1,97 @@
+#include "TestCheck.h"
+#include "Render/FramePacketMailbox.h"
+#include <thread>
+
+using namespace Minecraft;
+
+namespace {
+
+FramePacket MakePacket(float time, std::initializer_list<int> chunks) {
+    FramePacket packet;
+    packet.time = time;
+    for (int x : chunks) {
+        RenderCommand command;
+        command.type = RenderCommandType::UploadMesh;
+        command.pos = ChunkPos(x, 0);
+        packet.commands.push_back(std::move(command));
+    }
+    return packet;
+}
+
+// A packet the render thread skipped hands its commands to the next one, in order
+void TestSkippedPacketKeepsCommands() {
+    FramePacketMailbox mailbox;
+    mailbox.Submit(MakePacket(1.0f, {1, 2}));
+    mailbox.Submit(MakePacket(2.0f, {3}));
+    mailbox.Submit(MakePacket(3.0f, {}));
+
+    FramePacket packet;
+    CHECK(mailbox.Wait(packet));
+    CHECK(packet.time == 3.0f);
+    CHECK(packet.commands.size() == 3);
+    for (size_t i = 0; i < packet.commands.size(); ++i) {
+        CHECK(packet.commands[i].pos.x == static_cast<int>(i) + 1);
+    }
+
+    // Taken packets are gone; the next one starts empty
+    mailbox.Submit(MakePacket(4.0f, {4}));
+    CHECK(mailbox.Wait(packet));
+    CHECK(packet.time == 4.0f);
+    CHECK(packet.commands.size() == 1);
+}
+
+// Every submitted command arrives exactly once, whichever packets the consumer skips
+void TestConcurrentHandoff() {
+    constexpr int PACKETS = 2000;
+    FramePacketMailbox mailbox;
+    std::vector<int> received;
+
+    std::thread consumer([&mailbox, &received]() {
+        FramePacket packet;
+        while (mailbox.Wait(packet)) {
+            for (const RenderCommand& command : packet.commands) {
+                received.push_back(command.pos.x);
+            }
+            if (packet.time == static_cast<float>(PACKETS)) {
+                return;
+            }
+        }
+    });
+    for (int i = 1; i <= PACKETS; ++i) {
+        mailbox.Submit(MakePacket(static_cast<float>(i), {i}));
+    }
+    consumer.join();
+
+    CHECK(received.size() == PACKETS);
+    bool ordered = true;
+    for (size_t i = 0; i < received.size(); ++i) {
+        ordered = ordered && received[i] == static_cast<int>(i) + 1;
+    }
+    CHECK(ordered);
+}
+
+void TestCloseWakesWaiter() {
+    FramePacketMailbox mailbox;
+    bool result = true;
+    std::thread waiter([&mailbox, &result]() {
+        FramePacket packet;
+        result = mailbox.Wait(packet);
+    });
+    mailbox.Close();
+    waiter.join();
+    CHECK(!result);
+
+    // Closed for good, even with a packet submitted afterwards
+    mailbox.Submit(MakePacket(1.0f, {1}));
+    FramePacket packet;
+    CHECK(!mailbox.Wait(packet));
+}
+
+} // namespace
+
+int main() {
+    TestSkippedPacketKeepsCommands();
+    TestConcurrentHandoff();
+    TestCloseWakesWaiter();
+    return Test::Result();
+}
@@ -0,0 +1,91 @@
+#include "TestCheck.h"
+#include "Core/GameConfig.h"
+#include "World/RenderDistanceGovernor.h"
+#include "World/World.h"
+
+using namespace Minecraft;
+
+namespace {
+
+constexpr float TARGET_MS = 16.0f;
+constexpr float FRAME_SECONDS = 0.25f;  // Exact in binary, so a window is exactly EVALUATION_SECONDS
+
+// One evaluation window of identical frames
+void RunWindow(RenderDistanceGovernor& governor, World& world, float frameMs, float workMs) {
+    RenderDistanceGovernor::Sample sample;
+    sample.frameMs = frameMs;
+    sample.workMs = workMs;
+    sample.targetMs = TARGET_MS;
+    const int frames = static_cast<int>(RenderDistanceGovernor::EVALUATION_SECONDS / FRAME_SECONDS);
+    for (int i = 0; i < frames; ++i) {
+        governor.Update(world, sample, FRAME_SECONDS);
+    }
+}
+
+// Under vsync the interval stays at the target however heavy the frame is
+void TestWorkTimeDrivesDistance() {
+    StreamingConfig config;
+    World world(1);
+    world.SetRenderDistance(8);
+    RenderDistanceGovernor governor(config);
+
+    RunWindow(governor, world, TARGET_MS, TARGET_MS * 1.5f);
+    CHECK(world.GetRenderDistance() == 7);
+    RunWindow(governor, world, TARGET_MS, TARGET_MS * 1.5f);
+    CHECK(world.GetRenderDistance() == 6);
+
+    // Inside the band: hold
+    for (int i = 0; i < 2 * RenderDistanceGovernor::GROW_EVALUATIONS; ++i) {
+        RunWindow(governor, world, TARGET_MS, TARGET_MS * 0.9f);
+    }
+    CHECK(world.GetRenderDistance() == 6);
+
+    // Load drops while the interval stays pinned: grows again after the calm windows
+    for (int i = 0; i < RenderDistanceGovernor::GROW_EVALUATIONS - 1; ++i) {
+        RunWindow(governor, world, TARGET_MS, TARGET_MS * 0.3f);
+    }
+    CHECK(world.GetRenderDistance() == 6);
+    RunWindow(governor, world, TARGET_MS, TARGET_MS * 0.3f);
+    CHECK(world.GetRenderDistance() == 7);
+    for (int i = 0; i < RenderDistanceGovernor::GROW_EVALUATIONS; ++i) {
+        RunWindow(governor, world, TARGET_MS, TARGET_MS * 0.3f);
+    }
+    CHECK(world.GetRenderDistance() == 8);
+}
+
+// Missed frames shrink the distance even when the measured work looks light
+void TestMissedFramesShrink() {
+    StreamingConfig config;
+    World world(1);
+    world.SetRenderDistance(4);
+    RenderDistanceGovernor governor(config);
+
+    RunWindow(governor, world, TARGET_MS * 2.0f, TARGET_MS * 0.3f);
+    CHECK(world.GetRenderDistance() == 3);
+}
+
+// Bounds from the config hold in both directions
+void TestDistanceBounds() {
+    StreamingConfig config;
+    config.minRenderDistance = 3;
+    config.maxRenderDistance = 4;
+    World world(1);
+    world.SetRenderDistance(3);
+    RenderDistanceGovernor governor(config);
+
+    RunWindow(governor, world, TARGET_MS, TARGET_MS * 2.0f);
+    CHECK(world.GetRenderDistance() == 3);
+    for (int i = 0; i < 4 * RenderDistanceGovernor::GROW_EVALUATIONS; ++i) {
+        RunWindow(governor, world, TARGET_MS, TARGET_MS * 0.1f);
+    }
+    CHECK(world.GetRenderDistance() == 4);
+}
+
+} // namespace
+
+int main() {
+    TestWorkTimeDrivesDistance();
+    TestMissedFramesShrink();
+    TestDistanceBounds();
+    return Test::Result();
+}
@@ -0,0 +1,164 @@
+#include "TestCheck.h"
+#include "World/Chunk.h"
+#include "World/StructureTemplate.h"
+#include "World/WorldGeneration.h"
+#include <memory>
+
+using namespace Minecraft;
+
+namespace {
+
+// The centre chunk and its eight neighbours, addressed in the centre's local coordinates
+struct Neighbourhood {
+    std::unique_ptr<Chunk> chunks[3][3];
+
+    Neighbourhood() {
+        for (int dz = -1; dz <= 1; ++dz) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                chunks[dz + 1][dx + 1] = std::make_unique<Chunk>(dx, dz);
+            }
+        }
+    }
+
+    Chunk& At(int dx, int dz) { return *chunks[dz + 1][dx + 1]; }
+
+    BlockType Get(int x, int y, int z) {
+        const int dx = FloorDiv(x, CHUNK_SIZE);
+        const int dz = FloorDiv(z, CHUNK_SIZE);
+        return At(dx, dz).GetBlock(x - dx * CHUNK_SIZE, y, z - dz * CHUNK_SIZE);
+    }
+
+    void Set(int x, int y, int z, BlockType type) {
+        const int dx = FloorDiv(x, CHUNK_SIZE);
+        const int dz = FloorDiv(z, CHUNK_SIZE);
+        At(dx, dz).SetBlock(x - dx * CHUNK_SIZE, y, z - dz * CHUNK_SIZE, type);
+    }
+
+    // Stamp into the centre and apply what landed next door, as finalization would
+    void Stamp(const StructureTemplate& structure, const glm::ivec3& anchor) {
+        DecorationStaging staging;
+        structure.Stamp(At(0, 0), anchor, &staging);
+        for (int dz = -1; dz <= 1; ++dz) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                if (dx != 0 || dz != 0) {
+                    WorldGeneration::ApplyStaged(At(dx, dz), staging.neighbours[DecorationStaging::Index(dx, dz)]);
+                }
+            }
+        }
+    }
+};
+
+// A small tree: trunk, then a 5x5 masked leaf layer with the trunk top forced through it
+StructureTemplate BuildTree(StructureTemplate::Builder& builder) {
+    for (int y = 0; y < 4; ++y) {
+        builder.Set(0, y, 0, BlockType::Wood, false);
+    }
+    for (int z = -2; z <= 2; ++z) {
+        for (int x = -2; x <= 2; ++x) {
+            builder.Set(x, 3, z, BlockType::Leaves, true);
+        }
+    }
+    return builder.Build();
+}
+
+void TestBuild() {
+    StructureTemplate::Builder builder;
+    const StructureTemplate tree = BuildTree(builder);
+    CHECK(tree.GetMin() == glm::ivec3(-2, 0, -2));
+    CHECK(tree.GetMax() == glm::ivec3(2, 3, 2));
+
+    // Trunk cells are single runs; the leaf layer is one run per row, split by the trunk
+    int blocks = 0;
+    bool trunkKept = false;
+    for (const StructureRun& run : tree.GetRuns()) {
+        blocks += run.length;
+        if (run.y == 3 && run.z == 0 && run.x <= 0 && run.x + run.length > 0) {
+            trunkKept = run.type == BlockType::Wood && run.length == 1;
+        }
+    }
+    CHECK(blocks == 3 + 25);
+    CHECK(trunkKept);
+    CHECK(tree.GetRuns().size() == 3 + 4 + 3);
+
+    // A later unmasked block replaces, a later masked one does not
+    StructureTemplate::Builder overwrite;
+    overwrite.Set(0, 0, 0, BlockType::Leaves, true);
+    overwrite.Set(0, 0, 0, BlockType::Wood, false);
+    overwrite.Set(1, 0, 0, BlockType::Wood, false);
+    overwrite.Set(1, 0, 0, BlockType::Leaves, true);
+    const StructureTemplate merged = overwrite.Build();
+    CHECK(merged.GetRuns().size() == 1);
+    CHECK(merged.GetRuns()[0].length == 2);
+    CHECK(merged.GetRuns()[0].type == BlockType::Wood);
+}
+
+// Stamped at a corner, every block lands where it would in one big world
+void TestStampAcrossBorders() {
+    StructureTemplate::Builder builder;
+    const StructureTemplate tree = BuildTree(builder);
+
+    for (const glm::ivec3& anchor : {glm::ivec3(15, 60, 0), glm::ivec3(0, 60, 15), glm::ivec3(8, 60, 8)}) {
+        Neighbourhood world;
+        // Something already in the way of one leaf: masked writes keep it
+        world.Set(anchor.x + 1, anchor.y + 3, anchor.z + 1, BlockType::Stone);
+        world.Stamp(tree, anchor);
+
+        int wrong = 0;
+        for (int z = -2; z <= 2; ++z) {
+            for (int x = -2; x <= 2; ++x) {
+                for (int y = 0; y < 4; ++y) {
+                    BlockType expected = BlockType::Air;
+                    if (x == 0 && z == 0) {
+                        expected = BlockType::Wood;
+                    } else if (y == 3) {
+                        expected = (x == 1 && z == 1) ? BlockType::Stone : BlockType::Leaves;
+                    }
+                    wrong += world.Get(anchor.x + x, anchor.y + y, anchor.z + z) != expected ? 1 : 0;
+                }
+            }
+        }
+        CHECK(wrong == 0);
+        CHECK(world.Get(anchor.x + 3, anchor.y + 3, anchor.z) == BlockType::Air);
+    }
+}
+
+// Without staging, or beyond the eight neighbours, blocks outside the chunk are dropped
+void TestStampClipping() {
+    StructureTemplate::Builder builder;
+    builder.Set(-1, 0, 0, BlockType::Stone, false);
+    builder.Set(0, 0, 0, BlockType::Stone, false);
+    builder.Set(2 * CHUNK_SIZE, 0, 0, BlockType::Stone, false);
+    const StructureTemplate structure = builder.Build();
+
+    Chunk chunk(0, 0);
+    structure.Stamp(chunk, glm::ivec3(0, 10, 0), nullptr);
+    CHECK(chunk.GetBlock(0, 10, 0) == BlockType::Stone);
+    CHECK(chunk.GetBlockCount() == 1);
+
+    // The run over x = -1..0 is split at the border
+    DecorationStaging staging;
+    structure.Stamp(chunk, glm::ivec3(0, 10, 0), &staging);
+    const std::vector<StagedBlock>& west = staging.neighbours[DecorationStaging::Index(-1, 0)];
+    CHECK(west.size() == 1);
+    CHECK(!west.empty() && west[0].x == CHUNK_SIZE - 1 && west[0].y == 10 && west[0].z == 0);
+    int staged = 0;
+    for (const std::vector<StagedBlock>& blocks : staging.neighbours) {
+        staged += static_cast<int>(blocks.size());
+    }
+    CHECK(staged == 1);  // x = 2 * CHUNK_SIZE is two chunks away
+
+    // Runs above or below the chunk are clipped
+    Chunk empty(0, 0);
+    structure.Stamp(empty, glm::ivec3(4, CHUNK_HEIGHT, 4), nullptr);
+    structure.Stamp(empty, glm::ivec3(4, -1, 4), nullptr);
+    CHECK(empty.GetBlockCount() == 0);
+}
+
+} // namespace
+
+int main() {
+    TestBuild();
+    TestStampAcrossBorders();
+    TestStampClipping();
+    return Test::Result();
+}
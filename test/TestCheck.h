@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdio>
+
+namespace Minecraft {
+namespace Test {
+
+inline int& Failures() {
+    static int failures = 0;
+    return failures;
+}
+
+// Exit code for main: ctest treats anything but 0 as a failed test
+inline int Result() {
+    if (Failures() > 0) {
+        std::fprintf(stderr, "%d check(s) failed\n", Failures());
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace Test
+} // namespace Minecraft
+
+// Report a failed condition and keep going, so one run lists every failure
+#define CHECK(condition)                                                                  \
+    do {                                                                                  \
+        if (!(condition)) {                                                               \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            Minecraft::Test::Failures()++;                                                \
+        }                                                                                 \
+    } while (false)
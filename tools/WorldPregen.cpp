@@ -0,0 +1,404 @@
+// Headless world pre-generation: runs the chunk generation pipeline, and optionally
+// meshing, over a square area without Qt or GL, then reports throughput, per-stage
+// latency percentiles and peak memory.
+//
+// WorldPregen [--seed N] [--center X Z] [--radius R] [--threads N] [--mesh] [--no-caves]
+//   --radius R      chunks around the center, (2R + 1)^2 in total (default 16)
+//   --threads N     generation and meshing threads, 0 = one per hardware thread
+//   --mesh          also mesh every chunk against its neighbours in the area
+//
+// There is no on-disk world format yet, so chunks are dropped once they are done with.
+
+#include "World/Chunk.h"
+#include "World/ChunkGenerationPool.h"
+#include "World/ChunkMeshBuilder.h"
+#include "World/WorldGeneration.h"
+#include "utils/Logger.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+using Minecraft::Chunk;
+using Minecraft::ChunkPos;
+
+struct Options {
+    int seed = 0;
+    ChunkPos center = {0, 0};
+    int radius = 16;
+    int threads = 0;
+    bool mesh = false;
+    bool caves = true;
+};
+
+// Chunk coordinates are multiplied by CHUNK_SIZE for world positions, so keep them well inside int
+constexpr int MAX_CENTER = 1 << 24;
+constexpr int MAX_RADIUS = 1024;
+constexpr int MAX_THREADS = 256;
+
+// Parse a whole decimal integer in [minValue, maxValue]; trailing text or overflow is an error
+bool ParseInt(const char* option, const char* text, int minValue, int maxValue, int& value) {
+    errno = 0;
+    char* end = nullptr;
+    const long parsed = std::strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE || parsed < minValue || parsed > maxValue) {
+        std::fprintf(stderr, "Invalid value '%s' for %s, expected an integer in [%d, %d]\n", text, option, minValue,
+                     maxValue);
+        return false;
+    }
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+bool ParseArguments(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            if (!ParseInt("--seed", argv[++i], std::numeric_limits<int>::min(), std::numeric_limits<int>::max(),
+                          options.seed)) {
+                return false;
+            }
+        } else if (std::strcmp(argv[i], "--center") == 0 && i + 2 < argc) {
+            if (!ParseInt("--center", argv[i + 1], -MAX_CENTER, MAX_CENTER, options.center.x) ||
+                !ParseInt("--center", argv[i + 2], -MAX_CENTER, MAX_CENTER, options.center.z)) {
+                return false;
+            }
+            i += 2;
+        } else if (std::strcmp(argv[i], "--radius") == 0 && i + 1 < argc) {
+            if (!ParseInt("--radius", argv[++i], 0, MAX_RADIUS, options.radius)) {
+                return false;
+            }
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            // 0 picks the pool's default worker count
+            if (!ParseInt("--threads", argv[++i], 0, MAX_THREADS, options.threads)) {
+                return false;
+            }
+        } else if (std::strcmp(argv[i], "--mesh") == 0) {
+            options.mesh = true;
+        } else if (std::strcmp(argv[i], "--no-caves") == 0) {
+            options.caves = false;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t GetPeakMemoryBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return static_cast<size_t>(usage.ru_maxrss);  // Bytes
+#else
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;  // Kilobytes
+#endif
+#endif
+}
+
+void PrintLatency(const char* stage, std::vector<float> samples) {
+    if (samples.empty()) {
+        return;
+    }
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&samples](float p) {
+        const size_t index = static_cast<size_t>(p * static_cast<float>(samples.size()));
+        return samples[std::min(index, samples.size() - 1)];
+    };
+    std::printf("%-10s %8zu %10.3f %10.3f %10.3f %10.3f\n", stage, samples.size(), percentile(0.5f),
+                percentile(0.9f), percentile(0.99f), samples.back());
+}
+
+// Meshes chunks on its own threads once the neighbours they read from are generated.
+// A chunk is freed as soon as neither it nor a neighbour in the area still needs meshing,
+// so only the generation front stays in memory.
+class AreaMesher {
+public:
+    AreaMesher(const ChunkPos& center, int radius, int workerCount)
+        : m_Center(center)
+        , m_Radius(radius) {
+        for (int i = 0; i < workerCount; ++i) {
+            m_Workers.emplace_back(&AreaMesher::WorkerMain, this);
+        }
+    }
+
+    ~AreaMesher() {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_ShuttingDown = true;
+        }
+        m_Cv.notify_all();
+        for (std::thread& worker : m_Workers) {
+            worker.join();
+        }
+    }
+
+    AreaMesher(const AreaMesher&) = delete;
+    AreaMesher& operator=(const AreaMesher&) = delete;
+
+    void Add(const ChunkPos& pos, std::unique_ptr<Chunk> chunk) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        Entry& entry = m_Chunks[pos];
+        entry.chunk = std::move(chunk);
+        entry.pendingMeshes = 1;
+        for (const ChunkPos& neighbour : Neighbours(pos)) {
+            entry.pendingMeshes += InArea(neighbour) ? 1 : 0;
+        }
+        m_PeakChunks = std::max(m_PeakChunks, m_Chunks.size());
+
+        QueueLocked(pos);
+        for (const ChunkPos& neighbour : Neighbours(pos)) {
+            QueueLocked(neighbour);
+        }
+        m_Cv.notify_all();
+    }
+
+    // Block until every chunk of the area is meshed
+    void Finish(size_t chunkCount) {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_DoneCv.wait(lock, [this, chunkCount]() { return m_Meshed == chunkCount; });
+    }
+
+    std::vector<float> TakeMeshTimings() {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return std::move(m_MeshMs);
+    }
+
+    size_t GetPeakChunks() const { return m_PeakChunks; }
+    uint64_t GetFaceCount() const { return m_Faces; }
+
+private:
+    struct Entry {
+        std::unique_ptr<Chunk> chunk;
+        int pendingMeshes = 0;  // Meshes that still read this chunk, its own included
+        bool queued = false;
+    };
+
+    struct Job {
+        ChunkPos pos;
+        Chunk* chunk = nullptr;
+        std::array<const Chunk*, 4> neighbours{};  // +x, -x, +z, -z; null outside the area
+    };
+
+    static std::array<ChunkPos, 4> Neighbours(const ChunkPos& pos) {
+        return {ChunkPos(pos.x + 1, pos.z), ChunkPos(pos.x - 1, pos.z),
+                ChunkPos(pos.x, pos.z + 1), ChunkPos(pos.x, pos.z - 1)};
+    }
+
+    bool InArea(const ChunkPos& pos) const {
+        return std::abs(pos.x - m_Center.x) <= m_Radius && std::abs(pos.z - m_Center.z) <= m_Radius;
+    }
+
+    // Queue `pos` once it and every neighbour in the area are generated
+    void QueueLocked(const ChunkPos& pos) {
+        auto it = m_Chunks.find(pos);
+        if (it == m_Chunks.end() || it->second.queued) {
+            return;
+        }
+
+        Job job;
+        job.pos = pos;
+        job.chunk = it->second.chunk.get();
+        const std::array<ChunkPos, 4> neighbours = Neighbours(pos);
+        for (size_t i = 0; i < neighbours.size(); ++i) {
+            if (!InArea(neighbours[i])) {
+                continue;
+            }
+            auto neighbour = m_Chunks.find(neighbours[i]);
+            if (neighbour == m_Chunks.end()) {
+                return;
+            }
+            job.neighbours[i] = neighbour->second.chunk.get();
+        }
+
+        it->second.queued = true;
+        m_Jobs.push_back(job);
+    }
+
+    void ReleaseLocked(const ChunkPos& pos) {
+        auto it = m_Chunks.find(pos);
+        if (it != m_Chunks.end() && --it->second.pendingMeshes == 0) {
+            m_Chunks.erase(it);
+        }
+    }
+
+    void WorkerMain() {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        while (true) {
+            m_Cv.wait(lock, [this]() { return m_ShuttingDown || !m_Jobs.empty(); });
+            if (m_ShuttingDown) {
+                return;
+            }
+            const Job job = m_Jobs.front();
+            m_Jobs.pop_front();
+            lock.unlock();
+
+            // Chunks are not written any more; the neighbours stay alive until this job releases them
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            const glm::ivec2 origin = job.chunk->GetPosition() * Minecraft::CHUNK_SIZE;
+            const Minecraft::ChunkMeshData mesh = job.chunk->BuildMesh([&job, origin](int x, int y, int z) {
+                const int dx = Minecraft::FloorDiv(x - origin.x, Minecraft::CHUNK_SIZE);
+                const int dz = Minecraft::FloorDiv(z - origin.y, Minecraft::CHUNK_SIZE);
+                const Chunk* chunk = dx > 0 ? job.neighbours[0] : dx < 0 ? job.neighbours[1]
+                                   : dz > 0 ? job.neighbours[2] : dz < 0 ? job.neighbours[3] : job.chunk;
+                if (!chunk) {
+                    return Minecraft::BlockType::Air;
+                }
+                return chunk->GetBlock(x - (origin.x + dx * Minecraft::CHUNK_SIZE), y,
+                                       z - (origin.y + dz * Minecraft::CHUNK_SIZE));
+            });
+            const float meshMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+            const uint64_t faces = (mesh.opaqueIndices.size() + mesh.transparentIndices.size()) / 6 +
+                                   mesh.opaqueFaces.size() + mesh.transparentFaces.size();
+
+            lock.lock();
+            m_MeshMs.push_back(meshMs);
+            m_Faces += faces;
+            m_Meshed++;
+            ReleaseLocked(job.pos);
+            for (const ChunkPos& neighbour : Neighbours(job.pos)) {
+                if (InArea(neighbour)) {
+                    ReleaseLocked(neighbour);
+                }
+            }
+            m_DoneCv.notify_all();
+        }
+    }
+
+    const ChunkPos m_Center;
+    const int m_Radius;
+    std::unordered_map<ChunkPos, Entry> m_Chunks;
+    std::deque<Job> m_Jobs;
+    std::vector<float> m_MeshMs;
+    size_t m_Meshed = 0;
+    size_t m_PeakChunks = 0;
+    uint64_t m_Faces = 0;
+    bool m_ShuttingDown = false;
+    std::mutex m_Mutex;
+    std::condition_variable m_Cv;
+    std::condition_variable m_DoneCv;
+    std::vector<std::thread> m_Workers;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseArguments(argc, argv, options)) {
+        std::fprintf(stderr, "Usage: %s [--seed N] [--center X Z] [--radius R] [--threads N] [--mesh] [--no-caves]\n", argv[0]);
+        return 2;
+    }
+
+    Minecraft::Logger::Init("pregen.log", false);
+    Minecraft::Block::InitializeBlockRegistry();
+    Minecraft::WorldGeneration::SetSeed(options.seed);
+    Minecraft::WorldGeneration::SetCavesEnabled(options.caves);
+
+    const int side = 2 * options.radius + 1;
+    const size_t chunkCount = static_cast<size_t>(side) * side;
+    const int threads = options.threads > 0 ? options.threads : Minecraft::ChunkGenerationPool::GetDefaultWorkerCount();
+    std::printf("Generating %zu chunks around (%d, %d), seed %d, %d threads%s%s\n", chunkCount, options.center.x,
+                options.center.z, options.seed, threads, options.mesh ? ", meshing" : "", options.caves ? "" : ", no caves");
+    LOG_INFO("Pregen: " + std::to_string(chunkCount) + " chunks, seed " + std::to_string(options.seed) + ", " +
+             std::to_string(threads) + " threads");
+
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    uint64_t checksum = 0;
+    size_t peakChunks = 0;
+    {
+        Minecraft::ChunkGenerationPool pool(threads);
+        pool.SetStageTimingEnabled(true);
+        std::unique_ptr<AreaMesher> mesher;
+        if (options.mesh) {
+            mesher = std::make_unique<AreaMesher>(options.center, options.radius, threads);
+        }
+
+        // Whole area in focus, nearest chunks first
+        pool.SetFocus(options.center, glm::vec2(0.0f), options.radius);
+        std::vector<ChunkPos> positions;
+        positions.reserve(chunkCount);
+        for (int z = -options.radius; z <= options.radius; ++z) {
+            for (int x = -options.radius; x <= options.radius; ++x) {
+                positions.emplace_back(options.center.x + x, options.center.z + z);
+            }
+        }
+        pool.Queue(positions);
+
+        size_t taken = 0;
+        std::vector<Minecraft::GeneratedChunkResult> results;
+        while (taken < chunkCount) {
+            results.clear();
+            pool.TakeResults(results, chunkCount - taken);
+            if (results.empty()) {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                continue;
+            }
+            for (Minecraft::GeneratedChunkResult& result : results) {
+                checksum += Minecraft::ChunkGenerationPool::HashChunk(*result.chunk, result.pos);
+                if (mesher) {
+                    mesher->Add(result.pos, std::move(result.chunk));
+                }
+            }
+            taken += results.size();
+        }
+
+        const float generatedSeconds = std::chrono::duration<float>(Clock::now() - start).count();
+        std::printf("Generated in %.3f s, %.1f chunks/s\n", generatedSeconds,
+                    generatedSeconds > 0.0f ? static_cast<float>(chunkCount) / generatedSeconds : 0.0f);
+
+        const Minecraft::ChunkGenerationPool::StageTimings timings = pool.TakeStageTimings();
+        std::printf("\n%-10s %8s %10s %10s %10s %10s\n", "stage (ms)", "runs", "p50", "p90", "p99", "max");
+        PrintLatency("terrain", timings.terrainMs);
+        PrintLatency("decorate", timings.decorateMs);
+        PrintLatency("finalize", timings.finalizeMs);
+
+        if (mesher) {
+            mesher->Finish(chunkCount);
+            PrintLatency("mesh", mesher->TakeMeshTimings());
+            peakChunks = mesher->GetPeakChunks();
+            std::printf("%llu faces meshed\n", static_cast<unsigned long long>(mesher->GetFaceCount()));
+        }
+    }
+
+    const float seconds = std::chrono::duration<float>(Clock::now() - start).count();
+    const float chunksPerSecond = seconds > 0.0f ? static_cast<float>(chunkCount) / seconds : 0.0f;
+    const size_t peakBytes = GetPeakMemoryBytes();
+    std::printf("\nTotal %.3f s, %.1f chunks/s, peak memory %.1f MB", seconds, chunksPerSecond,
+                static_cast<double>(peakBytes) / (1024.0 * 1024.0));
+    if (options.mesh) {
+        std::printf(", at most %zu chunks held for meshing", peakChunks);
+    }
+    std::printf("\nChecksum %016llx\n", static_cast<unsigned long long>(checksum));
+    LOG_INFO("Pregen: " + std::to_string(chunksPerSecond) + " chunks/s, peak " +
+             std::to_string(peakBytes / (1024 * 1024)) + " MB");
+
+    Minecraft::Logger::Shutdown();
+    return 0;
+}